@@ -16,6 +16,8 @@ if (WITH_TLS)
         set(TLS_SOURCES
             src/base/net/stratum/Tls.cpp
             src/base/net/stratum/Tls.h
+            src/base/net/stratum/TlsSessions.cpp
+            src/base/net/stratum/TlsSessions.h
             src/base/net/tls/ServerTls.cpp
             src/base/net/tls/ServerTls.h
             src/base/net/tls/TlsConfig.cpp
@@ -3,6 +3,14 @@ if (WITH_ARGON2)
 
     list(APPEND HEADERS_CRYPTO
         src/crypto/argon2/Hash.h
+    )
+else()
+    remove_definitions(/DXMRIG_ALGO_ARGON2)
+endif()
+
+# RandomX uses the optimized Argon2 kernels for cache initialization.
+if (WITH_ARGON2 OR WITH_RANDOMX)
+    list(APPEND HEADERS_CRYPTO
         src/crypto/argon2/Impl.h
     )
 
@@ -13,6 +21,5 @@ if (WITH_ARGON2)
     add_subdirectory(src/3rdparty/argon2)
     set(ARGON2_LIBRARY argon2)
 else()
-    remove_definitions(/DXMRIG_ALGO_ARGON2)
     set(ARGON2_LIBRARY "")
 endif()
@@ -2,14 +2,19 @@ if (WITH_RANDOMX)
     add_definitions(/DXMRIG_ALGO_RANDOMX)
 
     list(APPEND HEADERS_CRYPTO
+        src/crypto/rx/BbpBlake256_impl.h
+        src/crypto/rx/BbpBlake256.h
         src/crypto/rx/Rx.h
         src/crypto/rx/RxAlgo.h
         src/crypto/rx/RxBasicStorage.h
         src/crypto/rx/RxCache.h
         src/crypto/rx/RxConfig.h
         src/crypto/rx/RxDataset.h
+        src/crypto/rx/RxDatasetCache.h
+        src/crypto/rx/RxProfiler.h
         src/crypto/rx/RxQueue.h
         src/crypto/rx/RxSeed.h
+        src/crypto/rx/RxTimings.h
         src/crypto/rx/RxVm.h
     )
 
@@ -33,16 +38,25 @@ if (WITH_RANDOMX)
         src/crypto/randomx/vm_compiled.cpp
         src/crypto/randomx/vm_interpreted_light.cpp
         src/crypto/randomx/vm_interpreted.cpp
+        src/crypto/rx/BbpBlake256.cpp
         src/crypto/rx/Rx.cpp
         src/crypto/rx/RxAlgo.cpp
         src/crypto/rx/RxBasicStorage.cpp
         src/crypto/rx/RxCache.cpp
         src/crypto/rx/RxConfig.cpp
         src/crypto/rx/RxDataset.cpp
+        src/crypto/rx/RxDatasetCache.cpp
         src/crypto/rx/RxQueue.cpp
+        src/crypto/rx/RxTimings.cpp
         src/crypto/rx/RxVm.cpp
     )
 
+    if (WITH_PROFILING)
+        add_definitions(/DXMRIG_FEATURE_PROFILING)
+
+        list(APPEND SOURCES_CRYPTO src/crypto/rx/RxProfiler.cpp)
+    endif()
+
     if (CMAKE_C_COMPILER_ID MATCHES MSVC)
         enable_language(ASM_MASM)
         list(APPEND SOURCES_CRYPTO
@@ -0,0 +1,267 @@
+#!/usr/bin/env node
+
+// Stand-in XMR + BBP (nomp) pool for testing the local stratum proxy without real pools.
+//
+//   node scripts/proxy_test_pool.js [--xmr-port=3333] [--bbp-port=3008] [--diff=1000] [--fixed-byte=0] [--interval=30]
+//
+// Point the upstream miner at the BBP port ("pools": [{"url": "127.0.0.1:3008", "user": <34 character BBP address>}])
+// with "proxy": {"enabled": true}, then point one or more rigs at the proxy, also with a BBP address as user. The BBP
+// side sends mining.set_altruism with the XMR port, so the upstream miner opens its XMR connection here as well and
+// the proxy rewrites it for the rigs to point back at itself.
+//
+// Every share is tallied by its fixed nonce byte (blob byte 42): the local miner must use 0 and each rig its own
+// slot from 1..255. A duplicate nonce means two miners share the same nonce space and is reported as an error.
+// With --fixed-byte the pool sets byte 42 itself like a nicehash pool, the proxy must then leave the job unsplit
+// and every share must carry that byte.
+
+'use strict';
+
+const net = require('net');
+
+
+const options = {
+    'xmr-port':   3333,
+    'bbp-port':   3008,
+    'diff':       1000,
+    'fixed-byte': 0,
+    'interval':   30
+};
+
+for (const arg of process.argv.slice(2)) {
+    const m = arg.match(/^--([a-z-]+)=(\d+)$/);
+    if (!m || !(m[1] in options)) {
+        console.error(`unknown option: ${arg}`);
+        process.exit(1);
+    }
+
+    options[m[1]] = parseInt(m[2], 10);
+}
+
+
+const SEED_HASH = 'bb09b1a4b5c3d2e1f0112233445566778899aabbccddeeff0123456789abcdef';
+const PREV_HASH = '0000000000000a1b2c3d4e5f60718293a4b5c6d7e8f90a1b2c3d4e5f60718293';
+
+const xmrMiners = new Set();
+const bbpMiners = new Set();
+const shares    = new Map();
+const nonces    = new Set();
+
+let jobSeq  = 0;
+let job     = null;
+let errors  = 0;
+
+
+function log(...args)
+{
+    console.log(new Date().toISOString(), ...args);
+}
+
+
+function target(diff)
+{
+    const buf = Buffer.alloc(4);
+    buf.writeUInt32LE(Math.floor(0xFFFFFFFF / diff) >>> 0);
+
+    return buf.toString('hex');
+}
+
+
+function createJob()
+{
+    // 76 byte RandomX blob, the nonce is bytes 39..42.
+    const blob = Buffer.alloc(76);
+    for (let i = 0; i < blob.length; i++) {
+        blob[i] = (i * 167 + jobSeq) & 0xff;
+    }
+
+    blob.fill(0, 39, 43);
+    blob[42] = options['fixed-byte'];
+
+    return {
+        blob:      blob.toString('hex'),
+        job_id:    (++jobSeq).toString(16).padStart(8, '0'),
+        target:    target(options.diff),
+        algo:      'rx/0',
+        height:    2000000 + jobSeq,
+        seed_hash: SEED_HASH
+    };
+}
+
+
+function send(socket, data)
+{
+    if (!socket.destroyed) {
+        socket.write(JSON.stringify(data) + '\n');
+    }
+}
+
+
+function listen(port, name, miners, onMessage)
+{
+    const server = net.createServer(socket => {
+        socket.name = `${name} ${socket.remoteAddress}:${socket.remotePort}`;
+        miners.add(socket);
+        log(`${socket.name} connected`);
+
+        let buffer = '';
+
+        socket.setEncoding('utf8');
+        socket.on('data', data => {
+            buffer += data;
+
+            let pos;
+            while ((pos = buffer.indexOf('\n')) >= 0) {
+                const line = buffer.slice(0, pos).trim();
+                buffer     = buffer.slice(pos + 1);
+
+                if (!line) {
+                    continue;
+                }
+
+                let message;
+                try {
+                    message = JSON.parse(line);
+                }
+                catch (err) {
+                    log(`${socket.name} invalid JSON: ${line}`);
+                    continue;
+                }
+
+                onMessage(socket, message);
+            }
+        });
+
+        socket.on('close', () => {
+            miners.delete(socket);
+            log(`${socket.name} disconnected`);
+        });
+
+        socket.on('error', () => {});
+    });
+
+    server.listen(port, () => log(`${name} pool listening on port ${port}`));
+}
+
+
+function onXmrMessage(socket, message)
+{
+    const params = message.params || {};
+
+    switch (message.method) {
+    case 'login':
+        log(`${socket.name} login ${params.login}, agent ${params.agent}`);
+
+        return send(socket, { id: message.id, jsonrpc: '2.0', error: null, result: { id: socket.name, job, extensions: ['algo', 'keepalive'], status: 'OK' } });
+
+    case 'submit':
+        return onXmrSubmit(socket, message, params);
+
+    case 'keepalived':
+        return send(socket, { id: message.id, jsonrpc: '2.0', error: null, result: { status: 'KEEPALIVED' } });
+
+    default:
+        log(`${socket.name} unsupported method ${message.method}`);
+
+        return send(socket, { id: message.id, jsonrpc: '2.0', error: { code: -1, message: 'Unsupported method' } });
+    }
+}
+
+
+function onXmrSubmit(socket, message, params)
+{
+    const nonce = Buffer.from(params.nonce || '', 'hex');
+    if (nonce.length !== 4) {
+        errors++;
+        log(`${socket.name} ERROR malformed nonce "${params.nonce}"`);
+
+        return send(socket, { id: message.id, jsonrpc: '2.0', error: { code: -1, message: 'Malformed nonce' } });
+    }
+
+    const key   = `${params.job_id}:${params.nonce}`;
+    const fixed = nonce[3];
+
+    if (nonces.has(key)) {
+        errors++;
+        log(`${socket.name} ERROR duplicate nonce ${params.nonce} job ${params.job_id}, two miners share the same nonce space`);
+
+        return send(socket, { id: message.id, jsonrpc: '2.0', error: { code: -1, message: 'Duplicate share' } });
+    }
+
+    nonces.add(key);
+    shares.set(fixed, (shares.get(fixed) || 0) + 1);
+
+    if (options['fixed-byte'] !== 0 && fixed !== options['fixed-byte']) {
+        errors++;
+        log(`${socket.name} ERROR share with fixed byte ${fixed}, the pool set ${options['fixed-byte']}`);
+    }
+
+    log(`${socket.name} share job ${params.job_id} nonce ${params.nonce} fixed byte ${fixed}`);
+
+    return send(socket, { id: message.id, jsonrpc: '2.0', error: null, result: { status: 'OK' } });
+}
+
+
+function notify(socket)
+{
+    // This tree reads the nomp job from params.params[]: job id, prev hash, coinbase (prev hash at offset 8), nbits, ntime and prev block time.
+    const ntime    = Math.floor(Date.now() / 1000).toString(16);
+    const coinbase = '01000000' + PREV_HASH + '00'.repeat(32);
+
+    send(socket, { id: null, method: 'mining.set_difficulty', params: ['1'] });
+    send(socket, { id: null, method: 'mining.notify', params: { params: [job.job_id, PREV_HASH, coinbase, '', [], '20000000', '1d00ffff', ntime, true, ntime] } });
+}
+
+
+function onBbpMessage(socket, message)
+{
+    const params = message.params || [];
+
+    switch (message.method) {
+    case 'mining.subscribe':
+        return send(socket, { id: message.id, result: [], error: null });
+
+    case 'mining.altruism':
+        return send(socket, { id: message.id, result: true, error: null });
+
+    case 'mining.authorize':
+        log(`${socket.name} authorize ${params[0]}`);
+
+        send(socket, { id: message.id, result: true, error: null });
+        send(socket, { id: null, method: 'mining.set_altruism', params: ['127.0.0.1', String(options['xmr-port']), params[1] || 'x', 'Stand-in'] });
+
+        return notify(socket);
+
+    case 'mining.submit':
+        log(`${socket.name} BBP share job ${params[1]}`);
+
+        // Replies to BBP submits always come with id 100, the miner matches them in order.
+        return send(socket, { id: 100, result: true, error: null });
+
+    default:
+        log(`${socket.name} unsupported method ${message.method}`);
+
+        return send(socket, { id: message.id, result: null, error: [20, 'Unsupported method', null] });
+    }
+}
+
+
+job = createJob();
+
+listen(options['xmr-port'], 'XMR', xmrMiners, onXmrMessage);
+listen(options['bbp-port'], 'BBP', bbpMiners, onBbpMessage);
+
+setInterval(() => {
+    job = createJob();
+
+    for (const socket of xmrMiners) {
+        send(socket, { jsonrpc: '2.0', method: 'job', params: job });
+    }
+
+    for (const socket of bbpMiners) {
+        notify(socket);
+    }
+
+    const tally = [...shares.entries()].sort((a, b) => a[0] - b[0]).map(([fixed, count]) => `${fixed}:${count}`).join(' ');
+
+    log(`new job ${job.job_id}, shares by fixed byte ${tally || '-'}, errors ${errors}`);
+}, options.interval * 1000);
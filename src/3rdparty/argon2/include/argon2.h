@@ -439,9 +439,42 @@ ARGON2_PUBLIC size_t argon2_encodedlen(uint32_t t_cost, uint32_t m_cost,
  * string
  */
 ARGON2_PUBLIC void argon2_select_impl();
+
+/**
+ * Selects the most capable implementation supported by the CPU, without the
+ * benchmark; for callers that can not afford the startup delay.
+ */
+ARGON2_PUBLIC void argon2_select_impl_fast();
 ARGON2_PUBLIC const char *argon2_get_impl_name();
 ARGON2_PUBLIC int argon2_select_impl_by_name(const char *name);
 
+/**
+ * Fills one segment of caller managed memory with the selected implementation,
+ * lets external code (RandomX cache initialization) reuse the optimized kernels.
+ * @param memory        First block of the memory, the first two blocks of every
+ * lane must be already initialized
+ * @param memory_blocks Total number of blocks
+ * @param passes        Total number of passes
+ * @param lanes         Number of lanes
+ * @param type          The Argon2 type
+ * @param pass          Position of the segment: pass, lane and slice
+ */
+ARGON2_PUBLIC void argon2_fill_segment(void *memory, uint32_t memory_blocks,
+                                       uint32_t passes, uint32_t lanes,
+                                       argon2_type type, uint32_t pass,
+                                       uint32_t lane, uint32_t slice);
+
+/**
+ * Compresses one BLAKE2b block, shared by the Argon2 BLAKE2b code and RandomX.
+ * @param h      Chaining value, updated in place
+ * @param block  Message block of BLAKE2B_BLOCKBYTES (128) bytes
+ * @param t0, t1 Byte counter including this block
+ * @param f0, f1 Last block and last node flags (all ones or zero)
+ */
+ARGON2_PUBLIC void argon2_blake2b_compress(uint64_t h[8], const void *block,
+                                           uint64_t t0, uint64_t t1,
+                                           uint64_t f0, uint64_t f1);
+
 /* signals support for passing preallocated memory: */
 #define ARGON2_PREALLOCATED_MEMORY
 
@@ -4,6 +4,7 @@
 #include "blake2/blake2-impl.h"
 
 #include "core.h"
+#include "3rdparty/argon2.h"
 
 static const uint64_t blake2b_IV[8] = {
     UINT64_C(0x6a09e667f3bcc908), UINT64_C(0xbb67ae8584caa73b),
@@ -53,7 +54,8 @@ static const unsigned int blake2b_sigma[12][16] = {
         G(m, r, 7, v[3], v[4], v[ 9], v[14]); \
     } while ((void)0, 0)
 
-void blake2b_compress(blake2b_state *S, const void *block, uint64_t f0)
+void argon2_blake2b_compress(uint64_t h[8], const void *block, uint64_t t0,
+                             uint64_t t1, uint64_t f0, uint64_t f1)
 {
     uint64_t m[16];
     uint64_t v[16];
@@ -75,22 +77,22 @@ void blake2b_compress(blake2b_state *S, const void *block, uint64_t f0)
     m[14] = load64((const uint64_t *)block + 14);
     m[15] = load64((const uint64_t *)block + 15);
 
-    v[ 0] = S->h[0];
-    v[ 1] = S->h[1];
-    v[ 2] = S->h[2];
-    v[ 3] = S->h[3];
-    v[ 4] = S->h[4];
-    v[ 5] = S->h[5];
-    v[ 6] = S->h[6];
-    v[ 7] = S->h[7];
+    v[ 0] = h[0];
+    v[ 1] = h[1];
+    v[ 2] = h[2];
+    v[ 3] = h[3];
+    v[ 4] = h[4];
+    v[ 5] = h[5];
+    v[ 6] = h[6];
+    v[ 7] = h[7];
     v[ 8] = blake2b_IV[0];
     v[ 9] = blake2b_IV[1];
     v[10] = blake2b_IV[2];
     v[11] = blake2b_IV[3];
-    v[12] = blake2b_IV[4] ^ S->t[0];
-    v[13] = blake2b_IV[5] ^ S->t[1];
+    v[12] = blake2b_IV[4] ^ t0;
+    v[13] = blake2b_IV[5] ^ t1;
     v[14] = blake2b_IV[6] ^ f0;
-    v[15] = blake2b_IV[7];
+    v[15] = blake2b_IV[7] ^ f1;
 
     ROUND(m, v, 0);
     ROUND(m, v, 1);
@@ -105,14 +107,19 @@ void blake2b_compress(blake2b_state *S, const void *block, uint64_t f0)
     ROUND(m, v, 10);
     ROUND(m, v, 11);
 
-    S->h[0] ^= v[0] ^ v[ 8];
-    S->h[1] ^= v[1] ^ v[ 9];
-    S->h[2] ^= v[2] ^ v[10];
-    S->h[3] ^= v[3] ^ v[11];
-    S->h[4] ^= v[4] ^ v[12];
-    S->h[5] ^= v[5] ^ v[13];
-    S->h[6] ^= v[6] ^ v[14];
-    S->h[7] ^= v[7] ^ v[15];
+    h[0] ^= v[0] ^ v[ 8];
+    h[1] ^= v[1] ^ v[ 9];
+    h[2] ^= v[2] ^ v[10];
+    h[3] ^= v[3] ^ v[11];
+    h[4] ^= v[4] ^ v[12];
+    h[5] ^= v[5] ^ v[13];
+    h[6] ^= v[6] ^ v[14];
+    h[7] ^= v[7] ^ v[15];
+}
+
+static void blake2b_compress(blake2b_state *S, const void *block, uint64_t f0)
+{
+    argon2_blake2b_compress(S->h, block, S->t[0], S->t[1], f0, 0);
 }
 
 static void blake2b_increment_counter(blake2b_state *S, uint64_t inc)
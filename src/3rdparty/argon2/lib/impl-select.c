@@ -83,11 +83,57 @@ void argon2_select_impl()
     }
 }
 
+void argon2_select_impl_fast()
+{
+    argon2_impl_list impls;
+    unsigned int i;
+
+    argon2_get_impl_list(&impls);
+
+    /* the list is ordered from the baseline to the most capable instruction set: */
+    for (i = (unsigned int)impls.count; i > 0; i--) {
+        const argon2_impl *impl = &impls.entries[i - 1];
+
+        if (impl->check == NULL || impl->check()) {
+            selected_argon_impl = *impl;
+
+            return;
+        }
+    }
+}
+
 void fill_segment(const argon2_instance_t *instance, argon2_position_t position)
 {
     selected_argon_impl.fill_segment(instance, position);
 }
 
+void argon2_fill_segment(void *memory, uint32_t memory_blocks,
+                         uint32_t passes, uint32_t lanes, argon2_type type,
+                         uint32_t pass, uint32_t lane, uint32_t slice)
+{
+    argon2_instance_t instance;
+    argon2_position_t position;
+
+    memset(&instance, 0, sizeof(instance));
+
+    instance.version = ARGON2_VERSION_NUMBER;
+    instance.memory = (block *)memory;
+    instance.passes = passes;
+    instance.memory_blocks = memory_blocks;
+    instance.segment_length = memory_blocks / (lanes * ARGON2_SYNC_POINTS);
+    instance.lane_length = instance.segment_length * ARGON2_SYNC_POINTS;
+    instance.lanes = lanes;
+    instance.threads = lanes;
+    instance.type = type;
+
+    position.pass = pass;
+    position.lane = lane;
+    position.slice = (uint8_t)slice;
+    position.index = 0;
+
+    selected_argon_impl.fill_segment(&instance, position);
+}
+
 const char *argon2_get_impl_name()
 {
     return selected_argon_impl.name;
@@ -29,6 +29,7 @@
 
 
 #include "App.h"
+#include "backend/common/benchmark/Benchmark.h"
 #include "backend/cpu/Cpu.h"
 #include "base/io/Console.h"
 #include "base/io/log/Log.h"
@@ -52,6 +53,7 @@ xmrig::App::~App()
 {
     Cpu::release();
 
+    delete m_benchmark;
     delete m_signals;
     delete m_console;
     delete m_controller;
@@ -92,10 +94,15 @@ int xmrig::App::exec()
 
     m_controller->start();
 
+    if (m_controller->config()->isBenchmark()) {
+        m_benchmark = new Benchmark(m_controller, this);
+        m_benchmark->start();
+    }
+
     rc = uv_run(uv_default_loop(), UV_RUN_DEFAULT);
     uv_loop_close(uv_default_loop());
 
-    return rc;
+    return rc != 0 ? rc : m_rc;
 }
 
 
@@ -135,6 +142,14 @@ void xmrig::App::onSignal(int signum)
 }
 
 
+void xmrig::App::onBenchDone(bool ok)
+{
+    m_rc = ok ? 0 : 1;
+
+    close();
+}
+
+
 void xmrig::App::close()
 {
     m_signals->stop();
@@ -145,5 +160,9 @@ void xmrig::App::close()
 
     m_controller->stop();
 
+    // The benchmark timer is a libuv handle, it must be closed while the loop is still running.
+    delete m_benchmark;
+    m_benchmark = nullptr;
+
     Log::destroy();
 }
@@ -27,6 +27,7 @@
 #define XMRIG_APP_H
 
 
+#include "backend/common/interfaces/IBenchListener.h"
 #include "base/kernel/interfaces/IConsoleListener.h"
 #include "base/kernel/interfaces/ISignalListener.h"
 #include "base/tools/Object.h"
@@ -35,6 +36,7 @@
 namespace xmrig {
 
 
+class Benchmark;
 class Console;
 class Controller;
 class Network;
@@ -42,7 +44,7 @@ class Process;
 class Signals;
 
 
-class App : public IConsoleListener, public ISignalListener
+class App : public IConsoleListener, public ISignalListener, public IBenchListener
 {
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(App)
@@ -55,14 +57,17 @@ public:
 protected:
     void onConsoleCommand(char command) override;
     void onSignal(int signum) override;
+    void onBenchDone(bool ok) override;
 
 private:
     bool background(int &rc);
     void close();
 
+    Benchmark *m_benchmark      = nullptr;
     Console *m_console          = nullptr;
     Controller *m_controller    = nullptr;
     Signals *m_signals          = nullptr;
+    int m_rc                    = 0;
 };
 
 
@@ -162,10 +162,18 @@ static void print_commands(Config *)
     if (Log::isColors()) {
         Log::print(GREEN_BOLD(" * ") WHITE_BOLD("COMMANDS     ") MAGENTA_BG(WHITE_BOLD_S "h") WHITE_BOLD("ashrate, ")
                                                                      MAGENTA_BG(WHITE_BOLD_S "p") WHITE_BOLD("ause, ")
-                                                                     MAGENTA_BG(WHITE_BOLD_S "r") WHITE_BOLD("esume"));
+                                                                     MAGENTA_BG(WHITE_BOLD_S "r") WHITE_BOLD("esume")
+#       ifdef XMRIG_FEATURE_PROFILING
+                                                                     WHITE_BOLD(", pro") MAGENTA_BG(WHITE_BOLD_S "f") WHITE_BOLD("ile")
+#       endif
+                                                                     );
     }
     else {
+#       ifdef XMRIG_FEATURE_PROFILING
+        Log::print(" * COMMANDS     'h' hashrate, 'p' pause, 'r' resume, 'f' profile");
+#       else
         Log::print(" * COMMANDS     'h' hashrate, 'p' pause, 'r' resume");
+#       endif
     }
 }
 
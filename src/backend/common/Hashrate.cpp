@@ -53,6 +53,8 @@ xmrig::Hashrate::Hashrate(size_t threads) :
     m_counts     = new uint64_t*[threads];
     m_timestamps = new uint64_t*[threads];
     m_top        = new uint32_t[threads];
+    m_nodes      = new uint32_t[threads]();
+    m_perf       = new PerfCounters::Values[threads];
 
     for (size_t i = 0; i < threads; i++) {
         m_counts[i]     = new uint64_t[kBucketSize]();
@@ -72,6 +74,8 @@ xmrig::Hashrate::~Hashrate()
     delete [] m_counts;
     delete [] m_timestamps;
     delete [] m_top;
+    delete [] m_nodes;
+    delete [] m_perf;
 }
 
 bool fDualHashingEnabled = true;
@@ -91,6 +95,28 @@ double xmrig::Hashrate::calc(size_t ms) const
 
 
 double xmrig::Hashrate::calc(size_t threadId, size_t ms) const
+{
+    // Every dual hash is reported as two hashes, the RandomX hash and the BBP check of it.
+    return rate(threadId, ms) * (isDual() ? 2 : 1);
+}
+
+
+double xmrig::Hashrate::rate(size_t ms) const
+{
+    double result = 0.0;
+    double data;
+
+    for (size_t i = 0; i < m_threads; ++i) {
+        data = rate(i, ms);
+        if (std::isnormal(data)) {
+            result += data;
+        }
+    }
+    return result;
+}
+
+
+double xmrig::Hashrate::rate(size_t threadId, size_t ms) const
 {
     assert(threadId < m_threads);
     if (threadId >= m_threads) {
@@ -134,9 +160,8 @@ double xmrig::Hashrate::calc(size_t threadId, size_t ms) const
 
     const auto hashes = static_cast<double>(lastestHashCnt - earliestHashCount);
     const auto time   = static_cast<double>(lastestStamp - earliestStamp) / 1000.0;
-    double dMultiplier = fDualHashingEnabled ? 2 : 1;
 
-    return hashes / time * dMultiplier;
+    return hashes / time;
 }
 
 
@@ -150,6 +175,18 @@ void xmrig::Hashrate::add(size_t threadId, uint64_t count, uint64_t timestamp)
 }
 
 
+void xmrig::Hashrate::addCounters(size_t threadId, const PerfCounters::Values &values)
+{
+    m_perf[threadId] = values;
+}
+
+
+bool xmrig::Hashrate::isDual()
+{
+    return fDualHashingEnabled;
+}
+
+
 const char *xmrig::Hashrate::format(double h, char *buf, size_t size)
 {
     return ::format(h, buf, size);
@@ -30,6 +30,7 @@
 #include <cstdint>
 
 
+#include "backend/common/PerfCounters.h"
 #include "base/tools/Object.h"
 #include "rapidjson/fwd.h"
 
@@ -52,9 +53,17 @@ public:
     ~Hashrate();
     double calc(size_t ms) const;
     double calc(size_t threadId, size_t ms) const;
+    double rate(size_t ms) const;
+    double rate(size_t threadId, size_t ms) const;
     void add(size_t threadId, uint64_t count, uint64_t timestamp);
+    void addCounters(size_t threadId, const PerfCounters::Values &values);
 
-    inline size_t threads() const { return m_threads; }
+    inline const PerfCounters::Values &counters(size_t threadId) const  { return m_perf[threadId]; }
+    inline size_t threads() const                                       { return m_threads; }
+    inline uint32_t node(size_t threadId) const                         { return m_nodes[threadId]; }
+    inline void setNode(size_t threadId, uint32_t node)                 { m_nodes[threadId] = node; }
+
+    static bool isDual();
 
     static const char *format(double h, char *buf, size_t size);
     static rapidjson::Value normalize(double d);
@@ -69,9 +78,11 @@ private:
     constexpr static size_t kBucketMask = kBucketSize - 1;
 
     size_t m_threads;
+    uint32_t* m_nodes;
     uint32_t* m_top;
     uint64_t** m_counts;
     uint64_t** m_timestamps;
+    PerfCounters::Values* m_perf;
 };
 
 
@@ -0,0 +1,225 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "backend/common/PerfCounters.h"
+#include "backend/common/Tags.h"
+#include "base/io/log/Log.h"
+
+
+#ifdef XMRIG_FEATURE_API
+#   include "rapidjson/document.h"
+#endif
+
+
+#ifdef XMRIG_OS_LINUX
+#   include <atomic>
+#   include <cerrno>
+#   include <cstring>
+#   include <fstream>
+#   include <linux/perf_event.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#endif
+
+
+#include <cstdio>
+
+
+namespace xmrig {
+
+
+static const char *names[PerfCounters::COUNTER_MAX] = { "cycles", "instructions", "llc_misses", "dtlb_misses", "stalled_cycles" };
+
+
+#ifdef XMRIG_OS_LINUX
+static std::atomic<bool> warned(false);
+
+
+static int paranoid()
+{
+    std::ifstream file("/proc/sys/kernel/perf_event_paranoid");
+    int value = -1;
+    file >> value;
+
+    return value;
+}
+
+
+static int openCounter(uint32_t type, uint64_t config)
+{
+    perf_event_attr attr{};
+    attr.size           = sizeof(attr);
+    attr.type           = type;
+    attr.config         = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+}
+
+
+static constexpr uint64_t cacheMiss(uint64_t cache)
+{
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+#endif
+
+
+} // namespace xmrig
+
+
+xmrig::PerfCounters::PerfCounters()
+{
+    for (int &fd : m_fd) {
+        fd = -1;
+    }
+
+#   ifdef XMRIG_OS_LINUX
+    m_fd[CYCLES]         = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    if (m_fd[CYCLES] < 0) {
+        if (!warned.exchange(true)) {
+            LOG_WARN("%s " YELLOW("hardware counters unavailable: \"%s\" (perf_event_paranoid %d)"), cpu_tag(), strerror(errno), paranoid());
+        }
+
+        return;
+    }
+
+    m_fd[INSTRUCTIONS]   = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    m_fd[LLC_MISSES]     = openCounter(PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_LL));
+    m_fd[DTLB_MISSES]    = openCounter(PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_DTLB));
+    m_fd[STALLED_CYCLES] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_BACKEND);
+
+    for (uint32_t i = 0; i < COUNTER_MAX; ++i) {
+        if (m_fd[i] >= 0) {
+            m_mask |= 1U << i;
+        }
+    }
+#   endif
+}
+
+
+xmrig::PerfCounters::~PerfCounters()
+{
+#   ifdef XMRIG_OS_LINUX
+    for (int fd : m_fd) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+#   endif
+}
+
+
+bool xmrig::PerfCounters::read(Values &values) const
+{
+    values.mask = 0;
+
+#   ifdef XMRIG_OS_LINUX
+    for (uint32_t i = 0; i < COUNTER_MAX; ++i) {
+        uint64_t data[3] = { 0 };
+
+        if (m_fd[i] < 0 || ::read(m_fd[i], data, sizeof(data)) != sizeof(data)) {
+            continue;
+        }
+
+        // Scale up if the kernel had to multiplex the counter with other events.
+        values.counters[i] = (data[2] > 0 && data[2] < data[1]) ? static_cast<uint64_t>(static_cast<double>(data[0]) * data[1] / data[2]) : data[0];
+        values.mask       |= 1U << i;
+    }
+#   endif
+
+    return values.isValid();
+}
+
+
+const char *xmrig::PerfCounters::format(double value, int precision, char *buf, size_t size)
+{
+    if (value >= 0.0) {
+        snprintf(buf, size, "%.*f", precision, value);
+
+        return buf;
+    }
+
+    return "n/a";
+}
+
+
+const char *xmrig::PerfCounters::name(Counter counter)
+{
+    return counter < COUNTER_MAX ? names[counter] : "unknown";
+}
+
+
+double xmrig::PerfCounters::Values::ipc() const
+{
+    if (!has(CYCLES) || !has(INSTRUCTIONS) || !counters[CYCLES]) {
+        return -1.0;
+    }
+
+    return static_cast<double>(counters[INSTRUCTIONS]) / counters[CYCLES];
+}
+
+
+double xmrig::PerfCounters::Values::perHash(Counter counter) const
+{
+    if (!has(counter) || !hashes) {
+        return -1.0;
+    }
+
+    return static_cast<double>(counters[counter]) / hashes;
+}
+
+
+double xmrig::PerfCounters::Values::stalled() const
+{
+    if (!has(CYCLES) || !has(STALLED_CYCLES) || !counters[CYCLES]) {
+        return -1.0;
+    }
+
+    return static_cast<double>(counters[STALLED_CYCLES]) * 100.0 / counters[CYCLES];
+}
+
+
+#ifdef XMRIG_FEATURE_API
+rapidjson::Value xmrig::PerfCounters::Values::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    if (!isValid()) {
+        return Value(kNullType);
+    }
+
+    Value out(kObjectType);
+    out.AddMember("hashes", hashes, allocator);
+
+    for (uint32_t i = 0; i < COUNTER_MAX; ++i) {
+        out.AddMember(StringRef(names[i]), has(static_cast<Counter>(i)) ? Value(counters[i]) : Value(kNullType), allocator);
+    }
+
+    return out;
+}
+#endif
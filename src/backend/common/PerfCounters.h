@@ -0,0 +1,94 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_PERFCOUNTERS_H
+#define XMRIG_PERFCOUNTERS_H
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+#include "base/tools/Object.h"
+#include "rapidjson/fwd.h"
+
+
+namespace xmrig {
+
+
+class PerfCounters
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(PerfCounters)
+
+    enum Counter : uint32_t {
+        CYCLES,
+        INSTRUCTIONS,
+        LLC_MISSES,
+        DTLB_MISSES,
+        STALLED_CYCLES,
+        COUNTER_MAX
+    };
+
+    class Values
+    {
+    public:
+        inline bool isValid() const                     { return mask != 0; }
+        inline bool has(Counter counter) const          { return (mask & (1U << counter)) != 0; }
+
+        // Derived metrics return a negative value if the required counters are not available.
+        double ipc() const;
+        double perHash(Counter counter) const;
+        double stalled() const;
+
+#       ifdef XMRIG_FEATURE_API
+        rapidjson::Value toJSON(rapidjson::Document &doc) const;
+#       endif
+
+        uint32_t mask                   = 0;
+        uint64_t hashes                 = 0;
+        uint64_t counters[COUNTER_MAX]  = {};
+    };
+
+    // Opens the counters for the calling thread, unavailable counters are silently skipped.
+    PerfCounters();
+    ~PerfCounters();
+
+    inline bool isEnabled() const                       { return m_mask != 0; }
+
+    bool read(Values &values) const;
+
+    static const char *format(double value, int precision, char *buf, size_t size);
+    static const char *name(Counter counter);
+
+private:
+    int m_fd[COUNTER_MAX];
+    uint32_t m_mask = 0;
+};
+
+
+} // namespace xmrig
+
+
+#endif /* XMRIG_PERFCOUNTERS_H */
@@ -36,6 +36,7 @@
 namespace xmrig {
 
 
+class Barrier;
 class IBackend;
 
 
@@ -45,9 +46,10 @@ class Thread
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(Thread)
 
-    inline Thread(IBackend *backend, size_t id, const T &config) : m_id(id), m_config(config), m_backend(backend) {}
+    inline Thread(IBackend *backend, size_t id, const T &config, Barrier *barrier) : m_id(id), m_config(config), m_barrier(barrier), m_backend(backend) {}
     inline ~Thread() { m_thread.join(); delete m_worker; }
 
+    inline Barrier *barrier() const                 { return m_barrier; }
     inline const T &config() const                  { return m_config; }
     inline IBackend *backend() const                { return m_backend; }
     inline IWorker *worker() const                  { return m_worker; }
@@ -58,6 +60,7 @@ public:
 private:
     const size_t m_id    = 0;
     const T m_config;
+    Barrier *m_barrier;
     IBackend *m_backend;
     IWorker *m_worker       = nullptr;
     std::thread m_thread;
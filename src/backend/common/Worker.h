@@ -32,6 +32,7 @@
 
 
 #include "backend/common/interfaces/IWorker.h"
+#include "backend/common/PerfCounters.h"
 
 
 namespace xmrig {
@@ -42,8 +43,10 @@ class Worker : public IWorker
 public:
     Worker(size_t id, int64_t affinity, int priority);
 
+    inline const PerfCounters *perf() const override    { return &m_perf; }
     inline const VirtualMemory *memory() const override { return nullptr; }
     inline size_t id() const override                   { return m_id; }
+    inline uint32_t node() const override               { return m_node; }
     inline uint64_t hashCount() const override          { return m_hashCount.load(std::memory_order_relaxed); }
     inline uint64_t timestamp() const override          { return m_timestamp.load(std::memory_order_relaxed); }
 
@@ -54,6 +57,7 @@ protected:
     const size_t m_id;
     std::atomic<uint64_t> m_hashCount;
     std::atomic<uint64_t> m_timestamp;
+    PerfCounters m_perf;
     uint32_t m_node     = 0;
     uint64_t m_count    = 0;
 };
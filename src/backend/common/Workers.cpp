@@ -29,6 +29,7 @@
 #include "backend/common/Workers.h"
 #include "backend/cpu/CpuWorker.h"
 #include "base/io/log/Log.h"
+#include "base/tools/Barrier.h"
 #include "base/tools/Object.h"
 
 
@@ -56,10 +57,12 @@ public:
 
     inline ~WorkersPrivate()
     {
+        delete barrier;
         delete hashrate;
     }
 
 
+    Barrier *barrier   = nullptr;
     Hashrate *hashrate = nullptr;
     IBackend *backend  = nullptr;
 };
@@ -100,20 +103,19 @@ void xmrig::Workers<T>::setBackend(IBackend *backend)
 template<class T>
 void xmrig::Workers<T>::start(const std::vector<T> &data)
 {
+    d_ptr->barrier = new Barrier(data.size());
+
     for (const T &item : data) {
-        m_workers.push_back(new Thread<T>(d_ptr->backend, m_workers.size(), item));
+        m_workers.push_back(new Thread<T>(d_ptr->backend, m_workers.size(), item, d_ptr->barrier));
     }
 
     d_ptr->hashrate = new Hashrate(m_workers.size());
     Nonce::touch(T::backend());
 
+    // Scratchpad placement no longer depends on start order (the CPU backend assigns fixed arena slices),
+    // so all threads are started at once.
     for (Thread<T> *worker : m_workers) {
         worker->start(Workers<T>::onReady);
-
-        // This sleep is important for optimal caching!
-        // Threads must allocate scratchpads in order so that adjacent cores will use adjacent scratchpads
-        // Sub-optimal caching can result in up to 0.5% hashrate penalty
-        std::this_thread::sleep_for(std::chrono::milliseconds(20));
     }
 }
 
@@ -130,6 +132,9 @@ void xmrig::Workers<T>::stop()
     m_workers.clear();
     Nonce::touch(T::backend());
 
+    delete d_ptr->barrier;
+    d_ptr->barrier = nullptr;
+
     delete d_ptr->hashrate;
     d_ptr->hashrate = nullptr;
 }
@@ -147,7 +152,17 @@ void xmrig::Workers<T>::tick(uint64_t)
             continue;
         }
 
-        d_ptr->hashrate->add(handle->id(), handle->worker()->hashCount(), handle->worker()->timestamp());
+        const uint64_t hashCount = handle->worker()->hashCount();
+        d_ptr->hashrate->add(handle->id(), hashCount, handle->worker()->timestamp());
+        d_ptr->hashrate->setNode(handle->id(), handle->worker()->node());
+
+        const PerfCounters *perf = handle->worker()->perf();
+        PerfCounters::Values values;
+
+        if (perf && perf->isEnabled() && perf->read(values)) {
+            values.hashes = hashCount;
+            d_ptr->hashrate->addCounters(handle->id(), values);
+        }
     }
 }
 
@@ -167,6 +182,9 @@ void xmrig::Workers<T>::onReady(void *arg)
     IWorker *worker = create(handle);
     assert(worker != nullptr);
 
+    // Every thread has its memory before any of them starts hashing.
+    handle->barrier()->wait();
+
     if (!worker || !worker->selfTest()) {
         LOG_ERR("%s " RED("thread ") RED_BOLD("#%zu") RED(" self-test failed"), T::tag(), worker ? worker->id() : 0);
 
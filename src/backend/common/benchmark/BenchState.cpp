@@ -0,0 +1,231 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "backend/common/benchmark/BenchState.h"
+
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <vector>
+
+
+namespace xmrig {
+
+
+static BenchHistogram *merged       = nullptr;
+static std::mutex mutex;
+static std::vector<BenchState::Thread> results;
+static uint32_t benchSize           = 0;
+static size_t doneCount             = 0;
+
+
+static inline uint32_t msb(uint64_t value)
+{
+    uint32_t r = 0;
+
+    for (uint32_t shift = 32; shift > 0; shift >>= 1) {
+        if (value >> shift) {
+            value >>= shift;
+            r      += shift;
+        }
+    }
+
+    return r;
+}
+
+
+} // namespace xmrig
+
+
+uint64_t xmrig::BenchHistogram::percentile(double percent) const
+{
+    if (m_count == 0) {
+        return 0;
+    }
+
+    const uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(m_count * percent / 100.0)));
+    uint64_t sum          = 0;
+
+    for (size_t i = 0; i < kSize; ++i) {
+        sum += m_data[i];
+
+        if (sum >= target) {
+            return value(i);
+        }
+    }
+
+    return value(kSize - 1);
+}
+
+
+void xmrig::BenchHistogram::merge(const BenchHistogram &other)
+{
+    for (size_t i = 0; i < kSize; ++i) {
+        m_data[i] += other.m_data[i];
+    }
+
+    m_count += other.m_count;
+}
+
+
+size_t xmrig::BenchHistogram::index(uint64_t value)
+{
+    if (value < kSubBuckets) {
+        return static_cast<size_t>(value);
+    }
+
+    const uint32_t shift = msb(value) - kSubBits;
+
+    return ((shift + 1) << kSubBits) + static_cast<size_t>((value >> shift) & (kSubBuckets - 1));
+}
+
+
+uint64_t xmrig::BenchHistogram::value(size_t index)
+{
+    if (index < kSubBuckets) {
+        return index;
+    }
+
+    const size_t shift      = (index >> kSubBits) - 1;
+    const uint64_t mantissa = (index & (kSubBuckets - 1)) | kSubBuckets;
+
+    return (mantissa << shift) + ((1ULL << shift) >> 1);
+}
+
+
+bool xmrig::BenchState::isDone(size_t threads)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return benchSize > 0 && threads > 0 && doneCount >= threads;
+}
+
+
+const xmrig::BenchHistogram &xmrig::BenchState::histogram()
+{
+    return *merged;
+}
+
+
+const xmrig::BenchState::Thread &xmrig::BenchState::thread(size_t id)
+{
+    return results[id];
+}
+
+
+size_t xmrig::BenchState::threads()
+{
+    return results.size();
+}
+
+
+uint32_t xmrig::BenchState::size()
+{
+    return benchSize;
+}
+
+
+uint64_t xmrig::BenchState::data()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    uint64_t data = 0;
+    for (const auto &thread : results) {
+        data ^= thread.data;
+    }
+
+    return data;
+}
+
+
+uint64_t xmrig::BenchState::elapsed()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    uint64_t start = 0;
+    uint64_t end   = 0;
+
+    for (const auto &thread : results) {
+        if (thread.hashes == 0) {
+            continue;
+        }
+
+        start = start ? std::min(start, thread.start) : thread.start;
+        end   = std::max(end, thread.end);
+    }
+
+    return end - start;
+}
+
+
+uint64_t xmrig::BenchState::hashes()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    uint64_t hashes = 0;
+    for (const auto &thread : results) {
+        hashes += thread.hashes;
+    }
+
+    return hashes;
+}
+
+
+void xmrig::BenchState::destroy()
+{
+    delete merged;
+    merged = nullptr;
+
+    results.clear();
+}
+
+
+void xmrig::BenchState::done(size_t id, const Thread &result, const BenchHistogram &histogram)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (results.size() <= id) {
+        results.resize(id + 1);
+    }
+
+    results[id] = result;
+    merged->merge(histogram);
+    doneCount++;
+}
+
+
+void xmrig::BenchState::init(uint32_t size)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    delete merged;
+
+    benchSize           = size;
+    doneCount           = 0;
+    merged              = new BenchHistogram();
+
+    results.clear();
+}
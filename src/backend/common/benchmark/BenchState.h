@@ -0,0 +1,87 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_BENCHSTATE_H
+#define XMRIG_BENCHSTATE_H
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+class BenchHistogram
+{
+public:
+    // 32 linear sub-buckets per power of two, every bucket is within ~3% of the measured value.
+    constexpr static size_t kSubBits    = 5;
+    constexpr static size_t kSubBuckets = 1 << kSubBits;
+    constexpr static size_t kSize       = (64 - kSubBits + 1) * kSubBuckets;
+
+    inline uint64_t count() const   { return m_count; }
+    inline void add(uint64_t value) { m_data[index(value)]++; m_count++; }
+
+    uint64_t percentile(double percent) const;
+    void merge(const BenchHistogram &other);
+
+private:
+    static size_t index(uint64_t value);
+    static uint64_t value(size_t index);
+
+    uint64_t m_count = 0;
+    uint64_t m_data[kSize]{};
+};
+
+
+class BenchState
+{
+public:
+    struct Thread
+    {
+        uint64_t data   = 0;
+        uint64_t end    = 0;
+        uint64_t hashes = 0;
+        uint64_t start  = 0;
+    };
+
+    static bool isDone(size_t threads);
+    static const BenchHistogram &histogram();
+    static const Thread &thread(size_t id);
+    static size_t threads();
+    static uint32_t size();
+    static uint64_t data();
+    static uint64_t elapsed();
+    static uint64_t hashes();
+    static void destroy();
+    static void done(size_t id, const Thread &result, const BenchHistogram &histogram);
+    static void init(uint32_t size);
+};
+
+
+} // namespace xmrig
+
+
+#endif /* XMRIG_BENCHSTATE_H */
@@ -0,0 +1,387 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "backend/common/benchmark/Benchmark.h"
+#include "backend/common/benchmark/BenchState.h"
+#include "backend/common/Hashrate.h"
+#include "backend/common/interfaces/IBackend.h"
+#include "backend/common/interfaces/IBenchListener.h"
+#include "base/io/log/Log.h"
+#include "base/kernel/interfaces/ILineListener.h"
+#include "base/net/stratum/BbpExchange.h"
+#include "base/net/stratum/Job.h"
+#include "base/net/tools/LineReader.h"
+#include "base/net/tools/NetBuffer.h"
+#include "base/tools/Buffer.h"
+#include "base/tools/Chrono.h"
+#include "base/tools/Timer.h"
+#include "core/config/Config.h"
+#include "core/Controller.h"
+#include "core/Miner.h"
+#include "rapidjson/document.h"
+
+
+#ifdef XMRIG_ALGO_RANDOMX
+#   include "backend/cpu/Cpu.h"
+#   include "crypto/argon2/Impl.h"
+#   include "crypto/randomx/randomx.h"
+#   include "crypto/rx/RxAlgo.h"
+#endif
+
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+
+namespace xmrig {
+
+
+static const char *tag = GREEN_BG_BOLD(WHITE_BOLD_S " bench ");
+
+
+// Synthetic RandomX job (nonce bytes zeroed), seed and BBP previous block hash, fixed so every run hashes exactly the same data.
+static const char *kBlob        = "0305a0dbd6bf05cf16e503f3a66f78007cbf34144332ecbfc22ed95c8700383b309ace1923a0960000000008ba939a62724c0d7581fce5761e9d8a0e6a1c3f924fdd8493d1115649c05eb601";
+static const char *kSeed        = "bb09b1a4b5c3d2e1f0112233445566778899aabbccddeeff0123456789abcdef";
+static const char *kPrevHash    = "0000000000000a1b2c3d4e5f60718293a4b5c6d7e8f90a1b2c3d4e5f60718293";
+static constexpr uint32_t kMaxSize = 1000000000;
+static constexpr uint32_t kJitPrograms = 20000;
+static constexpr uint32_t kCacheRounds = 3;
+static constexpr uint32_t kInterpreterPrograms = 4000;
+static constexpr uint32_t kStratumLines = 20000;
+static constexpr size_t kStratumRead = 1460;
+
+
+struct BenchReference
+{
+    uint32_t size;
+    uint64_t data;
+};
+
+
+// XOR of the first 8 bytes of every RandomX and BBP hash for nonces [0, size).
+static const BenchReference kReference[] = {
+    { 1000,   0x3f5d47f3dc669f76ULL },
+    { 10000,  0x9a81a3730ef08d8dULL },
+    { 100000, 0x2aeac7197f27b203ULL },
+};
+
+
+class StratumBenchListener : public ILineListener
+{
+public:
+    uint64_t lines = 0;
+
+protected:
+    void onLine(char *line, size_t) override
+    {
+        rapidjson::Document doc;
+        if (!doc.ParseInsitu(line).HasParseError() && doc.IsObject()) {
+            lines++;
+        }
+    }
+};
+
+
+} // namespace xmrig
+
+
+xmrig::Benchmark::Benchmark(Controller *controller, IBenchListener *listener) :
+    m_controller(controller),
+    m_listener(listener),
+    m_size(controller->config()->benchSize())
+{
+    m_timer = new Timer(this);
+}
+
+
+xmrig::Benchmark::~Benchmark()
+{
+    delete m_timer;
+
+    BenchState::destroy();
+}
+
+
+uint32_t xmrig::Benchmark::parseSize(const char *size)
+{
+    if (size == nullptr) {
+        return 0;
+    }
+
+    char *end      = nullptr;
+    uint64_t value = strtoull(size, &end, 10);
+
+    if (end && (*end == 'K' || *end == 'k')) {
+        value *= 1000;
+    }
+    else if (end && (*end == 'M' || *end == 'm')) {
+        value *= 1000000;
+    }
+
+    return value <= kMaxSize ? static_cast<uint32_t>(value) : 0;
+}
+
+
+void xmrig::Benchmark::start()
+{
+    BenchState::init(m_size);
+
+    uint8_t prevHash[32];
+    Buffer::fromHex(kPrevHash, 64, prevHash);
+
+    BbpExchange::setPrevHash(prevHash);
+    BbpExchange::setDifficulty(0);
+
+    Job job(false, Algorithm::RX_0, "benchmark");
+    job.setId("00000000");
+    job.setBlob(kBlob);
+    job.setSeedHash(kSeed);
+
+    // Maximum difficulty: target is 1, so the benchmark never produces shares.
+    job.setDiff(0xFFFFFFFFFFFFFFFFULL);
+
+    for (IBackend *backend : m_controller->miner()->backends()) {
+        if (backend->isEnabled() && backend != this->backend()) {
+            LOG_WARN("%s " YELLOW("only CPU backend is measured, disable \"%s\" backend for reproducible results"), tag, backend->type().data());
+        }
+    }
+
+    if (m_controller->config()->isBenchMicro()) {
+#       ifdef XMRIG_ALGO_RANDOMX
+        jit(job.algorithm());
+        cache();
+        interpreter();
+#       endif
+
+        stratum();
+    }
+
+    LOG_INFO("%s " WHITE_BOLD("start ") CYAN_BOLD("%u") WHITE_BOLD(" hashes, algo ") CYAN_BOLD("%s"), tag, m_size, job.algorithm().shortName());
+
+    m_ts = Chrono::steadyMSecs();
+    m_controller->miner()->setJob(job, false);
+    m_timer->start(500, 500);
+}
+
+
+#ifdef XMRIG_ALGO_RANDOMX
+void xmrig::Benchmark::cache() const
+{
+    // Same choice CpuBackend makes for the first RandomX job, so the SIMD figure is the kernel the miner will use.
+    argon2::Impl::select(m_controller->config()->cpu().argon2Impl(), false);
+
+    const double reference = randomx_cache_init_benchmark(kCacheRounds, 1);
+    const double simd      = randomx_cache_init_benchmark(kCacheRounds, 0);
+    if (reference <= 0.0 || simd <= 0.0) {
+        return;
+    }
+
+    LOG_INFO("%s " WHITE_BOLD("cache init ") "reference " CYAN_BOLD("%.0f ms") ", " WHITE_BOLD("%s ") CYAN_BOLD("%.0f ms") " " WHITE_BOLD("(x%.2f)") BLACK_BOLD(" (%u rounds)"),
+             tag,
+             reference,
+             argon2::Impl::name().data(),
+             simd,
+             reference / simd,
+             kCacheRounds
+             );
+}
+
+
+void xmrig::Benchmark::interpreter() const
+{
+    const double threaded = randomx_interpreter_benchmark(kInterpreterPrograms, 1);
+    const double basic    = randomx_interpreter_benchmark(kInterpreterPrograms, 0);
+    if (threaded <= 0.0 || basic <= 0.0) {
+        return;
+    }
+
+    char num[16 * 2] = { 0 };
+
+    LOG_INFO("%s " WHITE_BOLD("interpreter ") CYAN_BOLD("%s") " programs/s threaded, " CYAN_BOLD("%s") " switch " WHITE_BOLD("(x%.2f)") BLACK_BOLD(" (%u programs)"),
+             tag,
+             Hashrate::format(threaded, num, sizeof num / 2),
+             Hashrate::format(basic, num + 16, sizeof num / 2),
+             threaded / basic,
+             kInterpreterPrograms
+             );
+}
+
+
+void xmrig::Benchmark::jit(const Algorithm &algorithm) const
+{
+    RxAlgo::apply(algorithm.id());
+
+    Assembly assembly = m_controller->config()->cpu().assembly();
+    if (assembly == Assembly::AUTO) {
+        assembly = Cpu::info()->assembly();
+    }
+
+    const int flags    = (assembly == Assembly::RYZEN || assembly == Assembly::BULLDOZER) ? RANDOMX_FLAG_AMD : RANDOMX_FLAG_DEFAULT;
+    const double speed = randomx_jit_benchmark(static_cast<randomx_flags>(flags), kJitPrograms);
+    if (speed <= 0.0) {
+        return;
+    }
+
+    char num[16 * 2] = { 0 };
+
+    LOG_INFO("%s " WHITE_BOLD("jit ") CYAN_BOLD("%s") " programs/s, " CYAN_BOLD("%s us") " per hash" BLACK_BOLD(" (%u programs)"),
+             tag,
+             Hashrate::format(speed, num, sizeof num / 2),
+             Hashrate::format(RxAlgo::programCount(algorithm.id()) * 1e6 / speed, num + 16, sizeof num / 2),
+             kJitPrograms
+             );
+}
+#endif
+
+
+void xmrig::Benchmark::stratum() const
+{
+    char line[512] = { 0 };
+    std::string stream;
+
+    for (uint32_t i = 0; i < kStratumLines; ++i) {
+        snprintf(line, sizeof(line), "{\"jsonrpc\":\"2.0\",\"method\":\"job\",\"params\":{\"blob\":\"%s\",\"job_id\":\"%08x\",\"target\":\"f3220000\",\"algo\":\"rx/0\",\"height\":%u,\"seed_hash\":\"%s\"}}\n",
+                 kBlob, i, 2000000 + i, kSeed);
+
+        stream += line;
+    }
+
+    StratumBenchListener listener;
+    LineReader reader(&listener);
+
+    const uint64_t allocations = NetBuffer::allocations();
+    const uint64_t ts          = Chrono::steadyNSecs();
+
+    // Same path as a pool connection: every TCP segment sized read lands in a fresh network buffer, so lines straddle reads.
+    for (size_t pos = 0; pos < stream.size(); pos += kStratumRead) {
+        const size_t size = std::min(kStratumRead, stream.size() - pos);
+        char *buf         = NetBuffer::allocate();
+
+        memcpy(buf, stream.data() + pos, size);
+        reader.parse(buf, size);
+
+        NetBuffer::release(buf);
+    }
+
+    const uint64_t elapsed = Chrono::steadyNSecs() - ts;
+    if (!listener.lines || !elapsed) {
+        return;
+    }
+
+    char num[16] = { 0 };
+
+    LOG_INFO("%s " WHITE_BOLD("stratum ") CYAN_BOLD("%s") " lines/s, " CYAN_BOLD("%.2f") " buffer allocations per line" BLACK_BOLD(" (%" PRIu64 " lines)"),
+             tag,
+             Hashrate::format(listener.lines * 1e9 / elapsed, num, sizeof num),
+             static_cast<double>(NetBuffer::allocations() - allocations) / listener.lines,
+             listener.lines
+             );
+}
+
+
+void xmrig::Benchmark::onTimer(const Timer *)
+{
+    const IBackend *cpu = backend();
+    if (!cpu || !cpu->hashrate() || !BenchState::isDone(cpu->hashrate()->threads())) {
+        return;
+    }
+
+    m_timer->stop();
+    m_listener->onBenchDone(finish());
+}
+
+
+bool xmrig::Benchmark::finish()
+{
+    char num[8 * 3] = { 0 };
+
+    Log::print(WHITE_BOLD_S "| THREAD |     HASHES |     H/s |");
+
+    for (size_t i = 0; i < BenchState::threads(); ++i) {
+        const auto &thread = BenchState::thread(i);
+        const double speed = thread.end > thread.start ? thread.hashes * 1e9 / (thread.end - thread.start) : 0.0;
+
+        Log::print("| %6zu | %10" PRIu64 " | %7s |", i, thread.hashes, Hashrate::format(speed, num, sizeof num / 3));
+    }
+
+    const uint64_t hashes    = BenchState::hashes();
+    const uint64_t elapsed   = BenchState::elapsed();
+    const double speed       = elapsed ? hashes * 1e9 / elapsed : 0.0;
+    const auto &histogram    = BenchState::histogram();
+
+    LOG_INFO("%s " WHITE_BOLD("%" PRIu64) " hashes in " WHITE_BOLD("%.3f s") " speed " CYAN_BOLD("%s H/s") " per hash p50 " CYAN_BOLD("%s us") " p99 " CYAN_BOLD("%s us") BLACK_BOLD(" (%" PRIu64 " ms total)"),
+             tag,
+             hashes,
+             elapsed / 1e9,
+             Hashrate::format(speed, num, sizeof num / 3),
+             Hashrate::format(histogram.percentile(50.0) / 1e3, num + 8, sizeof num / 3),
+             Hashrate::format(histogram.percentile(99.0) / 1e3, num + 8 * 2, sizeof num / 3),
+             Chrono::steadyMSecs() - m_ts
+             );
+
+    if (hashes != m_size) {
+        LOG_ERR("%s " RED("incomplete run, ") RED_BOLD("%" PRIu64) RED(" of ") RED_BOLD("%u") RED(" hashes measured"), tag, hashes, m_size);
+
+        return false;
+    }
+
+    const uint64_t data = BenchState::data();
+
+    for (const auto &reference : kReference) {
+        if (reference.size != m_size) {
+            continue;
+        }
+
+        if (reference.data == data) {
+            LOG_INFO("%s data " GREEN_BOLD("0x%016" PRIx64 " OK"), tag, data);
+
+            return true;
+        }
+
+        LOG_ERR("%s data " RED_BOLD("0x%016" PRIx64) RED(" FAILED, expected ") WHITE_BOLD("0x%016" PRIx64), tag, data, reference.data);
+
+        return false;
+    }
+
+    LOG_WARN("%s data " WHITE_BOLD("0x%016" PRIx64) YELLOW(" (no reference value for this size)"), tag, data);
+
+    return true;
+}
+
+
+xmrig::IBackend *xmrig::Benchmark::backend() const
+{
+    for (IBackend *backend : m_controller->miner()->backends()) {
+        if (backend->type() == "cpu") {
+            return backend;
+        }
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,83 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_BENCHMARK_H
+#define XMRIG_BENCHMARK_H
+
+
+#include "base/kernel/interfaces/ITimerListener.h"
+#include "base/tools/Object.h"
+
+
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+class Algorithm;
+class Controller;
+class IBackend;
+class IBenchListener;
+class Timer;
+
+
+class Benchmark : public ITimerListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(Benchmark)
+
+    Benchmark(Controller *controller, IBenchListener *listener);
+    ~Benchmark() override;
+
+    static uint32_t parseSize(const char *size);
+
+    void start();
+
+protected:
+    void onTimer(const Timer *timer) override;
+
+private:
+    bool finish();
+    IBackend *backend() const;
+    void stratum() const;
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    void cache() const;
+    void interpreter() const;
+    void jit(const Algorithm &algorithm) const;
+#   endif
+
+    Controller *m_controller;
+    IBenchListener *m_listener;
+    Timer *m_timer      = nullptr;
+    uint32_t m_size     = 0;
+    uint64_t m_ts       = 0;
+};
+
+
+} // namespace xmrig
+
+
+#endif /* XMRIG_BENCHMARK_H */
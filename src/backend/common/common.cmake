@@ -1,12 +1,16 @@
 set(HEADERS_BACKEND_COMMON
+    src/backend/common/benchmark/Benchmark.h
+    src/backend/common/benchmark/BenchState.h
     src/backend/common/Hashrate.h
     src/backend/common/Tags.h
     src/backend/common/interfaces/IBackend.h
+    src/backend/common/interfaces/IBenchListener.h
     src/backend/common/interfaces/IRxListener.h
     src/backend/common/interfaces/IRxStorage.h
     src/backend/common/interfaces/IThread.h
     src/backend/common/interfaces/IWorker.h
     src/backend/common/misc/PciTopology.h
+    src/backend/common/PerfCounters.h
     src/backend/common/Thread.h
     src/backend/common/Threads.h
     src/backend/common/Worker.h
@@ -15,7 +19,10 @@ set(HEADERS_BACKEND_COMMON
    )
 
 set(SOURCES_BACKEND_COMMON
+    src/backend/common/benchmark/Benchmark.cpp
+    src/backend/common/benchmark/BenchState.cpp
     src/backend/common/Hashrate.cpp
+    src/backend/common/PerfCounters.cpp
     src/backend/common/Threads.cpp
     src/backend/common/Worker.cpp
     src/backend/common/Workers.cpp
@@ -42,6 +42,7 @@ public:
 
     virtual bool isHugePages(uint32_t node) const       = 0;
     virtual uint8_t *get(size_t size, uint32_t node)    = 0;
+    virtual uint8_t *getAt(size_t offset, size_t size, uint32_t node) = 0;
     virtual void release(uint32_t node)                 = 0;
 };
 
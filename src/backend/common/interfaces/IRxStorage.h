@@ -26,8 +26,10 @@
 
 #include "crypto/rx/RxConfig.h"
 #include "crypto/common/HugePagesInfo.h"
+#include "crypto/rx/RxTimings.h"
 
 
+#include <atomic>
 #include <cstdint>
 #include <utility>
 
@@ -45,10 +47,14 @@ class IRxStorage
 public:
     virtual ~IRxStorage() = default;
 
-    virtual bool isAllocated() const                                                                                            = 0;
-    virtual HugePagesInfo hugePages() const                                                                                     = 0;
-    virtual RxDataset *dataset(const Job &job, uint32_t nodeId) const                                                           = 0;
-    virtual void init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority) = 0;
+    virtual bool isAllocated() const                                                                                                                    = 0;
+    virtual HugePagesInfo hugePages() const                                                                                                             = 0;
+    virtual RxDataset *dataset(const Job &job, uint32_t nodeId) const                                                                                   = 0;
+    virtual RxTimings timings() const                                                                                                                   = 0;
+    virtual bool prefetch(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority, const String &cacheDir, const std::atomic<bool> &abort) = 0;
+    virtual bool save(const String &cacheDir, const std::atomic<bool> &abort)                                                                           = 0;
+    virtual bool swap(const RxSeed &seed)                                                                                                               = 0;
+    virtual void init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority, const String &cacheDir) = 0;
 };
 
 
@@ -33,6 +33,7 @@
 namespace xmrig {
 
 
+class PerfCounters;
 class VirtualMemory;
 
 
@@ -42,9 +43,11 @@ public:
     virtual ~IWorker() = default;
 
     virtual bool selfTest()                         = 0;
+    virtual const PerfCounters *perf() const        = 0;
     virtual const VirtualMemory *memory() const     = 0;
     virtual size_t id() const                       = 0;
     virtual size_t intensity() const                = 0;
+    virtual uint32_t node() const                   = 0;
     virtual uint64_t hashCount() const              = 0;
     virtual uint64_t timestamp() const              = 0;
     virtual void start()                            = 0;
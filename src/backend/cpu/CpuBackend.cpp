@@ -23,10 +23,12 @@
  */
 
 
+#include <map>
 #include <mutex>
 
 
 #include "backend/common/Hashrate.h"
+#include "backend/common/interfaces/IMemoryPool.h"
 #include "backend/common/interfaces/IWorker.h"
 #include "backend/common/Tags.h"
 #include "backend/common/Workers.h"
@@ -38,6 +40,7 @@
 #include "base/tools/String.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
+#include "crypto/common/Nonce.h"
 #include "crypto/common/VirtualMemory.h"
 #include "crypto/rx/Rx.h"
 #include "crypto/rx/RxDataset.h"
@@ -46,10 +49,11 @@
 
 #ifdef XMRIG_FEATURE_API
 #   include "base/api/interfaces/IApiRequest.h"
+#   include "base/api/Metrics.h"
 #endif
 
 
-#ifdef XMRIG_ALGO_ARGON2
+#if defined(XMRIG_ALGO_ARGON2) || defined(XMRIG_ALGO_RANDOMX)
 #   include "crypto/argon2/Impl.h"
 #endif
 
@@ -150,10 +154,47 @@ public:
                  );
 
         status.start(threads, algo.l3());
+        createArena();
         workers.start(threads);
     }
 
 
+    // Lays out every scratchpad up front, threads of the same node get adjacent slices in thread order.
+    // With the persistent memory pool enabled the slices are taken from the pool instead.
+    inline void createArena()
+    {
+        std::map<uint32_t, size_t> nodes;
+
+        for (CpuLaunchData &data : threads) {
+            data.arenaNode   = VirtualMemory::numaNode(data.affinity);
+            data.arenaOffset = nodes[data.arenaNode];
+
+            nodes[data.arenaNode] += VirtualMemory::align(data.algorithm.l3() * data.intensity);
+        }
+
+        if (controller->config()->cpu().memPoolSize() > 0) {
+            return;
+        }
+
+        for (auto &kv : nodes) {
+            kv.second /= VirtualMemory::align(1);
+        }
+
+        arena = VirtualMemory::createArena(nodes, controller->config()->cpu().isHugePages());
+
+        for (CpuLaunchData &data : threads) {
+            data.arena = arena;
+        }
+    }
+
+
+    inline void releaseArena()
+    {
+        delete arena;
+        arena = nullptr;
+    }
+
+
     size_t ways()
     {
         std::lock_guard<std::mutex> lock(mutex);
@@ -162,7 +203,7 @@ public:
     }
 
 
-    rapidjson::Value hugePages(int version, rapidjson::Document &doc)
+    HugePagesInfo hugePagesInfo()
     {
         HugePagesInfo pages;
 
@@ -178,6 +219,13 @@ public:
 
         mutex.unlock();
 
+        return pages;
+    }
+
+
+    rapidjson::Value hugePages(int version, rapidjson::Document &doc)
+    {
+        const HugePagesInfo pages = hugePagesInfo();
         rapidjson::Value hugepages;
 
         if (version > 1) {
@@ -196,6 +244,7 @@ public:
     Algorithm algo;
     Controller *controller;
     CpuLaunchStatus status;
+    IMemoryPool *arena = nullptr;
     std::vector<CpuLaunchData> threads;
     String profileName;
     Workers<CpuLaunchData> workers;
@@ -274,8 +323,17 @@ const xmrig::String &xmrig::CpuBackend::type() const
 
 void xmrig::CpuBackend::prepare(const Job &nextJob)
 {
+#   if defined(XMRIG_ALGO_ARGON2) || defined(XMRIG_ALGO_RANDOMX)
+    const auto family = nextJob.algorithm().family();
+
 #   ifdef XMRIG_ALGO_ARGON2
-    if (nextJob.algorithm().family() == Algorithm::ARGON2 && argon2::Impl::select(d_ptr->controller->config()->cpu().argon2Impl())) {
+    const String &hint = d_ptr->controller->config()->cpu().argon2Impl();
+#   else
+    const String hint;
+#   endif
+
+    // RandomX cache initialization uses the same kernels, selected by CPU features: the benchmark would cost more than it saves.
+    if ((family == Algorithm::ARGON2 || family == Algorithm::RANDOM_X) && argon2::Impl::select(hint, family == Algorithm::ARGON2)) {
         LOG_INFO("%s use " WHITE_BOLD("argon2") " implementation " CSI "1;%dm" "%s",
                  tag,
                  argon2::Impl::name() == "default" ? 33 : 32,
@@ -293,18 +351,46 @@ void xmrig::CpuBackend::printHashrate(bool details)
     }
 
     char num[8 * 3] = { 0 };
+    char perf[8 * 4] = { 0 };
+
+    bool counters = false;
+    for (size_t i = 0; i < hashrate()->threads(); ++i) {
+        counters |= hashrate()->counters(i).isValid();
+    }
 
-    Log::print(WHITE_BOLD_S "|    CPU # | AFFINITY | 10s H/s | 60s H/s | 15m H/s |");
+    if (counters) {
+        Log::print(WHITE_BOLD_S "|    CPU # | AFFINITY | 10s H/s | 60s H/s | 15m H/s |  IPC  |   LLC/H |  DTLB/H | STALL% |");
+    }
+    else {
+        Log::print(WHITE_BOLD_S "|    CPU # | AFFINITY | 10s H/s | 60s H/s | 15m H/s |");
+    }
 
     size_t i = 0;
     for (const CpuLaunchData &data : d_ptr->threads) {
-         Log::print("| %8zu | %8" PRId64 " | %7s | %7s | %7s |",
-                    i,
-                    data.affinity,
-                    Hashrate::format(hashrate()->calc(i, Hashrate::ShortInterval),  num,         sizeof num / 3),
-                    Hashrate::format(hashrate()->calc(i, Hashrate::MediumInterval), num + 8,     sizeof num / 3),
-                    Hashrate::format(hashrate()->calc(i, Hashrate::LargeInterval),  num + 8 * 2, sizeof num / 3)
-                    );
+         if (counters) {
+             const PerfCounters::Values &values = hashrate()->counters(i);
+
+             Log::print("| %8zu | %8" PRId64 " | %7s | %7s | %7s | %5s | %7s | %7s | %6s |",
+                        i,
+                        data.affinity,
+                        Hashrate::format(hashrate()->calc(i, Hashrate::ShortInterval),  num,         sizeof num / 3),
+                        Hashrate::format(hashrate()->calc(i, Hashrate::MediumInterval), num + 8,     sizeof num / 3),
+                        Hashrate::format(hashrate()->calc(i, Hashrate::LargeInterval),  num + 8 * 2, sizeof num / 3),
+                        PerfCounters::format(values.ipc(),                              2, perf,         sizeof perf / 4),
+                        PerfCounters::format(values.perHash(PerfCounters::LLC_MISSES),  0, perf + 8,     sizeof perf / 4),
+                        PerfCounters::format(values.perHash(PerfCounters::DTLB_MISSES), 0, perf + 8 * 2, sizeof perf / 4),
+                        PerfCounters::format(values.stalled(),                          0, perf + 8 * 3, sizeof perf / 4)
+                        );
+         }
+         else {
+             Log::print("| %8zu | %8" PRId64 " | %7s | %7s | %7s |",
+                        i,
+                        data.affinity,
+                        Hashrate::format(hashrate()->calc(i, Hashrate::ShortInterval),  num,         sizeof num / 3),
+                        Hashrate::format(hashrate()->calc(i, Hashrate::MediumInterval), num + 8,     sizeof num / 3),
+                        Hashrate::format(hashrate()->calc(i, Hashrate::LargeInterval),  num + 8 * 2, sizeof num / 3)
+                        );
+         }
 
          i++;
     }
@@ -379,6 +465,7 @@ void xmrig::CpuBackend::stop()
 
     d_ptr->workers.stop();
     d_ptr->threads.clear();
+    d_ptr->releaseArena();
 
     LOG_INFO("%s" YELLOW(" stopped") BLACK_BOLD(" (%" PRIu64 " ms)"), tag, Chrono::steadyMSecs() - ts);
 }
@@ -412,7 +499,7 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
     out.AddMember("asm", false, allocator);
 #   endif
 
-#   ifdef XMRIG_ALGO_ARGON2
+#   if defined(XMRIG_ALGO_ARGON2) || defined(XMRIG_ALGO_RANDOMX)
     out.AddMember("argon2-impl", argon2::Impl::name().toJSON(), allocator);
 #   endif
 
@@ -421,7 +508,15 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
 #   endif
 
     out.AddMember("hugepages", d_ptr->hugePages(2, doc), allocator);
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    if (d_ptr->algo.family() == Algorithm::RANDOM_X) {
+        out.AddMember("dataset", Rx::timings().toJSON(doc), allocator);
+    }
+#   endif
+
     out.AddMember("memory",    static_cast<uint64_t>(d_ptr->algo.isValid() ? (d_ptr->ways() * d_ptr->algo.l3()) : 0), allocator);
+    out.AddMember("resume-latency", Nonce::resumeLatency(Nonce::CPU), allocator);
 
     if (d_ptr->threads.empty() || !hashrate()) {
         return out;
@@ -454,5 +549,29 @@ void xmrig::CpuBackend::handleRequest(IApiRequest &request)
     if (request.type() == IApiRequest::REQ_SUMMARY) {
         request.reply().AddMember("hugepages", d_ptr->hugePages(request.version(), request.doc()), request.doc().GetAllocator());
     }
+    else if (request.type() == IApiRequest::REQ_METRICS && isEnabled()) {
+        Metrics &metrics          = *request.metrics();
+        const HugePagesInfo pages = d_ptr->hugePagesInfo();
+
+        metrics.family("xmrig_hugepages", Metrics::GAUGE, "Huge pages used by the CPU backend and the RandomX dataset");
+        metrics.add("xmrig_hugepages", "backend=\"cpu\",state=\"allocated\"", static_cast<uint64_t>(pages.allocated));
+        metrics.add("xmrig_hugepages", "backend=\"cpu\",state=\"total\"", static_cast<uint64_t>(pages.total));
+
+        metrics.family("xmrig_resume_latency_microseconds", Metrics::GAUGE, "Worst time from a resume notification to a worker running again since the last pause");
+        metrics.add("xmrig_resume_latency_microseconds", "backend=\"cpu\"", Nonce::resumeLatency(Nonce::CPU));
+
+#       ifdef XMRIG_ALGO_RANDOMX
+        if (d_ptr->algo.family() == Algorithm::RANDOM_X) {
+            const RxTimings timings = Rx::timings();
+
+            metrics.family("xmrig_dataset_init_milliseconds", Metrics::GAUGE, "Duration of the last RandomX dataset initialization by stage");
+            metrics.add("xmrig_dataset_init_milliseconds", "stage=\"allocate\"",  timings.allocate);
+            metrics.add("xmrig_dataset_init_milliseconds", "stage=\"cache\"",     timings.cache);
+            metrics.add("xmrig_dataset_init_milliseconds", "stage=\"compute\"",   timings.compute);
+            metrics.add("xmrig_dataset_init_milliseconds", "stage=\"load\"",      timings.load);
+            metrics.add("xmrig_dataset_init_milliseconds", "stage=\"replicate\"", timings.replicate);
+        }
+#       endif
+    }
 }
 #endif
@@ -38,6 +38,7 @@ namespace xmrig {
 
 class CpuConfig;
 class CpuThread;
+class IMemoryPool;
 class Miner;
 
 
@@ -67,6 +68,11 @@ public:
     const int64_t affinity;
     const Miner *miner;
     const uint32_t intensity;
+
+    // Scratchpad slice assigned by the backend before the threads start, not part of the thread configuration.
+    IMemoryPool *arena      = nullptr;
+    size_t arenaOffset      = 0;
+    uint32_t arenaNode      = 0;
 };
 
 
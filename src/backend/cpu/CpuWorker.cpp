@@ -30,7 +30,9 @@
 #include <map>
 #include <cmath>
 
+#include "backend/common/benchmark/BenchState.h"
 #include "backend/cpu/CpuWorker.h"
+#include "base/tools/Chrono.h"
 #include "core/Miner.h"
 #include "crypto/cn/CnCtx.h"
 #include "crypto/cn/CryptoNight_test.h"
@@ -39,7 +41,9 @@
 #include "crypto/common/VirtualMemory.h"
 #include "crypto/rx/Rx.h"
 #include "crypto/rx/RxVm.h"
+#include "net/JobResult.h"
 #include "net/JobResults.h"
+#include "base/net/stratum/BbpExchange.h"
 #include "base/net/stratum/BiblePay.h"
 
 #ifdef XMRIG_ALGO_RANDOMX
@@ -54,7 +58,8 @@
 
 namespace xmrig {
 
-static constexpr uint32_t kReserveCount = 32768;
+static constexpr uint32_t kReserveCount      = 32768;
+static constexpr uint32_t kBenchReserveCount = 256;
 
 xmrig::gbbp::bbpjob m_bbpjob;
 std::map<std::string, int> xmrig::gbbp::m_mapResultSuccess;
@@ -62,9 +67,9 @@ std::map<std::string, int> xmrig::gbbp::m_mapResultFail;
 std::map<std::string, std::string> xmrig::gbbp::m_mapBBPJob;
 
 template<size_t N>
-inline bool nextRound(WorkerJob<N> &job)
+inline bool nextRound(WorkerJob<N> &job, uint32_t reserveCount)
 {
-    if (!job.nextRound(kReserveCount, 1)) {
+    if (!job.nextRound(reserveCount, 1)) {
         JobResults::done(job.currentJob());
 
         return false;
@@ -87,9 +92,15 @@ xmrig::CpuWorker<N>::CpuWorker(size_t id, const CpuLaunchData &data) :
     m_av(data.av()),
     m_astrobwtMaxSize(data.astrobwtMaxSize * 1000),
     m_miner(data.miner),
+    m_benchSize(BenchState::size()),
+    m_reserveCount(m_benchSize ? kBenchReserveCount : kReserveCount),
     m_ctx()
 {
-    m_memory = new VirtualMemory(m_algorithm.l3() * N, data.hugePages, false, true, m_node);
+    m_memory = new VirtualMemory(m_algorithm.l3() * N, data.hugePages, data.arena, data.arenaOffset, data.arenaNode);
+
+    if (m_benchSize) {
+        m_benchHistogram = new BenchHistogram();
+    }
 }
 
 
@@ -98,27 +109,69 @@ xmrig::CpuWorker<N>::~CpuWorker()
 {
 #   ifdef XMRIG_ALGO_RANDOMX
     delete m_vm;
+    Rx::release(m_dataset);
 #   endif
 
     CnCtx::release(m_ctx, N);
     delete m_memory;
+    delete m_benchHistogram;
 }
 
 
 #ifdef XMRIG_ALGO_RANDOMX
 template<size_t N>
-void xmrig::CpuWorker<N>::allocateRandomX_VM()
+bool xmrig::CpuWorker<N>::benchHash(uint32_t nonce, uint64_t ts)
 {
-    RxDataset *dataset = Rx::dataset(m_job.currentJob(), m_node);
+    // Nonces are reserved in increasing order, so once the worker got past the benchmark size it has nothing left to hash.
+    if (nonce >= m_benchSize) {
+        BenchState::done(id(), m_bench, *m_benchHistogram);
 
-    while (dataset == nullptr) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        return false;
+    }
 
-        if (Nonce::sequence(Nonce::CPU) == 0) {
-            return;
-        }
+    const uint64_t now = Chrono::steadyNSecs();
+
+    // XOR is order independent, so the result does not depend on how nonces were split between threads.
+    m_bench.data ^= *reinterpret_cast<const uint64_t*>(m_hash) ^ *reinterpret_cast<const uint64_t*>(m_bbpHash);
+    m_bench.hashes++;
+
+    if (m_bench.start == 0) {
+        m_bench.start = ts;
+    }
+
+    m_benchHistogram->add(now - ts);
+    m_bench.end = now;
+
+    return true;
+}
+
+
+template<size_t N>
+void xmrig::CpuWorker<N>::allocateRandomX_VM()
+{
+    RxDataset *dataset = nullptr;
 
+    Nonce::wait(Nonce::CPU, [this, &dataset] {
         dataset = Rx::dataset(m_job.currentJob(), m_node);
+
+        return dataset != nullptr || Nonce::sequence(Nonce::CPU) == 0;
+    });
+
+    if (dataset == nullptr) {
+        return;
+    }
+
+    // The dataset can change under a running worker when a prepared next-seed dataset is swapped in.
+    if (dataset != m_dataset) {
+        delete m_vm;
+        m_vm = nullptr;
+
+        Rx::release(m_dataset);
+        m_dataset = dataset;
+    }
+    else {
+        // Already held since the VM was created.
+        Rx::release(dataset);
     }
 
     if (!m_vm) {
@@ -206,14 +259,11 @@ bool xmrig::CpuWorker<N>::selfTest()
 template<size_t N>
 void xmrig::CpuWorker<N>::start()
 {
-	l_bbpjob localbbpjob;
+	BbpExchange::Snapshot bbpJob;
 
 	while (Nonce::sequence(Nonce::CPU) > 0) {
         if (Nonce::isPaused()) {
-            do {
-                std::this_thread::sleep_for(std::chrono::milliseconds(200));
-            }
-            while (Nonce::isPaused() && Nonce::sequence(Nonce::CPU) > 0);
+            Nonce::wait(Nonce::CPU, [] { return !Nonce::isPaused() || Nonce::sequence(Nonce::CPU) == 0; });
 
             if (Nonce::sequence(Nonce::CPU) == 0) {
                 break;
@@ -226,7 +276,7 @@ void xmrig::CpuWorker<N>::start()
 
 #       ifdef XMRIG_ALGO_RANDOMX
         bool first = true;
-        uint64_t tempHash[8] = {};
+        alignas(16) uint64_t tempHash[8] = {};
 		
         // RandomX is faster, we don't need to store stats so often
         if (m_job.currentJob().algorithm().family() == Algorithm::RANDOM_X) {
@@ -234,9 +284,6 @@ void xmrig::CpuWorker<N>::start()
         }
 #       endif
 
-        memcpy(localbbpjob.prevhash, gbbp::m_bbpjob.prevblockhash, 32);
-        localbbpjob.nDifficulty = gbbp::m_bbpjob.difficulty;
-
         while (!Nonce::isOutdated(Nonce::CPU, m_job.sequence())) {
             if ((m_count & storeStatsMask) == 0) {
                 storeStats();
@@ -260,64 +307,55 @@ void xmrig::CpuWorker<N>::start()
             if (job.algorithm().family() == Algorithm::RANDOM_X) {
                 if (first) {
                     first = false;
+
                     randomx_calculate_hash_first(m_vm->get(), tempHash, m_job.blob(), job.size());
                 }
 
-                if (m_count % (2000 + N) == 0)
-                {
-				    if (gbbp::m_bbpjob.fInitialized)
-                    {
-						int r1 = memcmp(localbbpjob.prevhash, gbbp::m_bbpjob.prevblockhash, 32);
-						if (r1 != 0)
-							memcpy(localbbpjob.prevhash, gbbp::m_bbpjob.prevblockhash, 32);
-						if (gbbp::m_bbpjob.fInitialized == true && gbbp::m_bbpjob.fSolutionFound == false && localbbpjob.fSolved == true)
-							localbbpjob.fSolved = false;
-                    }
+                // A single load per hash, the snapshot is only copied when the network thread published a new BBP job.
+                if (BbpExchange::epoch() != bbpJob.epoch) {
+                    BbpExchange::read(bbpJob);
                 }
 
-                memcpy(localbbpjob.priorRandomXHeader, m_job.blob(), job.size());
-                
-				if (!nextRound(m_job)) {
+				if (!nextRound(m_job, m_reserveCount)) {
 					break;
 				}
 				// MINING LOOP
-				randomx_calculate_hash_next_dual(m_vm->get(), localbbpjob.prevhash, localbbpjob.out_bbphash, tempHash, m_job.blob(), job.size(), m_hash);
-				double nDiff1 = FullTest3(localbbpjob.out_bbphash);
-				if ((!localbbpjob.fSolved && localbbpjob.nDifficulty > 0 && nDiff1 >= localbbpjob.nDifficulty))
+				const uint64_t ts = m_benchSize ? Chrono::steadyNSecs() : 0;
+				randomx_calculate_hash_next_dual(m_vm->get(), bbpJob.prevHash, m_bbpHash, tempHash, m_job.blob(), job.size(), m_hash);
+				if (m_benchSize && !benchHash(current_job_nonces[0], ts)) {
+					return;
+				}
+				// RandomX always runs with one hash per worker (selfTest() rejects N > 1), lane 0 is the only lane.
+				if (bbpJob.isReady())
 				{
-					if (gbbp::m_bbpjob.fInitialized)
+					const double nDiff1 = FullTest3(m_bbpHash);
+					if (nDiff1 >= bbpJob.difficulty)
 					{
-						// The randomx_calculate_hash_next_dual provides the solution to the *last* hash in the prior round, so here we have to glean results from the *priorRandomXHeader*
-						auto memory1 = new VirtualMemory(job.algorithm().l3(), false, false, false);
-						RxDataset *dataset1 = Rx::dataset(job, 0);
-						if (dataset1 != nullptr) {
-							auto vm1 = new RxVm(dataset1, memory1->scratchpad(), false, Assembly::NONE);
-							randomx_calculate_dual_hash(vm1->get(), localbbpjob.prevhash, localbbpjob.out_bbphash, localbbpjob.priorRandomXHeader, job.size(), localbbpjob.out_rxhash);
-							delete vm1;
-						}
-						delete memory1;
 						// This RandomX hash has solved a biblepay-pool job!
-						localbbpjob.fSolved = true;
-						// Verify and gather information
-						std::string seed = Buffer::toHex(job.seed().data(), 32).data();
-						std::string rxhash = Buffer::toHex(localbbpjob.out_rxhash, 32).data();
-						std::string bbphash = Buffer::toHex(localbbpjob.out_bbphash, 32).data();
-						std::string lprevhash = Buffer::toHex(localbbpjob.prevhash, 32).data();
-						std::string data = Buffer::toHex(localbbpjob.priorRandomXHeader, job.size()).data();
-						JobResults::submitBBP(data, m_count, rxhash, bbphash, seed, localbbpjob.nDifficulty, MathRound(nDiff1));
+						// The randomx_calculate_hash_next_dual provides the solution to the *last* hash in the prior round, so here we have to glean results from the prior header.
+						// Only the nonce changes between rounds, so the prior header is the current blob with the nonce it was hashed with,
+						// and its RandomX and BBP hashes are still in m_hash/m_bbpHash, nothing needs to be recomputed.
+						BbpSolution solution;
+						memcpy(solution.header, m_job.blob(), job.size());
+						memcpy(solution.header + 39, &current_job_nonces[0], sizeof(uint32_t));
+						memcpy(solution.rxHash, m_hash, 32);
+						memcpy(solution.bbpHash, m_bbpHash, 32);
+						memcpy(solution.seed, job.seed().data(), 32);
+						solution.size       = job.size();
+						solution.jobDiff    = bbpJob.difficulty;
+						solution.solvedDiff = MathRound(nDiff1);
+
+						JobResults::submit(JobResult(job, solution));
 					}
 				}
 
-				for (size_t i = 0; i < N; ++i) 
+				if (*reinterpret_cast<uint64_t*>(m_hash + 24) < job.target())
 				{
-					if (*reinterpret_cast<uint64_t*>(m_hash + (i * 32) + 24) < job.target())
-					{
-						// This dual-hash has solved a RandomX header
-						double nDiff = FullTest3(m_hash);
-						if (nDiff < 1) 
-							nDiff = 1; 
-						JobResults::submit(job, current_job_nonces[i], m_hash + (i * 32), MathRound(nDiff));
-					}
+					// This dual-hash has solved a RandomX header
+					double nDiff = FullTest3(m_hash);
+					if (nDiff < 1) 
+						nDiff = 1; 
+					JobResults::submit(job, current_job_nonces[0], m_hash, MathRound(nDiff));
 				}
 				
             }
@@ -335,7 +373,7 @@ void xmrig::CpuWorker<N>::start()
                     fn(job.algorithm())(m_job.blob(), job.size(), m_hash, m_ctx, job.height());
                 }
 
-                if (!nextRound(m_job)) {
+                if (!nextRound(m_job, m_reserveCount)) {
                     break;
                 };
             }
@@ -442,7 +480,7 @@ void xmrig::CpuWorker<N>::consumeJob()
         return;
     }
 
-    m_job.add(m_miner->job(), kReserveCount, Nonce::CPU);
+    m_job.add(m_miner->job(), m_reserveCount, Nonce::CPU);
 
 #   ifdef XMRIG_ALGO_RANDOMX
     if (m_job.currentJob().algorithm().family() == Algorithm::RANDOM_X) {
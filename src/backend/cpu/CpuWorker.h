@@ -27,6 +27,7 @@
 #define XMRIG_CPUWORKER_H
 
 
+#include "backend/common/benchmark/BenchState.h"
 #include "backend/common/Worker.h"
 #include "backend/common/WorkerJob.h"
 #include "backend/cpu/CpuLaunchData.h"
@@ -37,6 +38,8 @@
 namespace xmrig {
 
 
+class BenchHistogram;
+class RxDataset;
 class RxVm;
 
 
@@ -60,6 +63,7 @@ private:
     inline cn_hash_fun fn(const Algorithm &algorithm) const { return CnHash::fn(algorithm, m_av, m_assembly); }
 
 #   ifdef XMRIG_ALGO_RANDOMX
+    bool benchHash(uint32_t nonce, uint64_t ts);
     void allocateRandomX_VM();
 #   endif
 
@@ -76,14 +80,21 @@ private:
     const CnHash::AlgoVariant m_av;
     const int m_astrobwtMaxSize;
     const Miner *m_miner;
+    const uint32_t m_benchSize;
+    const uint32_t m_reserveCount;
     cryptonight_ctx *m_ctx[N];
+    uint8_t m_bbpHash[32]{ 0 };
     uint8_t m_hash[N * 32]{ 0 };
     VirtualMemory *m_memory = nullptr;
     WorkerJob<N> m_job;
 
 #   ifdef XMRIG_ALGO_RANDOMX
+    RxDataset *m_dataset = nullptr;
     RxVm *m_vm = nullptr;
 #   endif
+
+    BenchHistogram *m_benchHistogram = nullptr;
+    BenchState::Thread m_bench;
 };
 
 
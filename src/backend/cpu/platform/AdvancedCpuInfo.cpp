@@ -154,6 +154,7 @@ xmrig::AdvancedCpuInfo::AdvancedCpuInfo() :
 
     m_avx2 = data.flags[CPU_FEATURE_AVX2] && data.flags[CPU_FEATURE_OSXSAVE];
     m_bmi2 = data.flags[CPU_FEATURE_BMI2];
+    m_sse41 = data.flags[CPU_FEATURE_SSE4_1];
 }
 
 
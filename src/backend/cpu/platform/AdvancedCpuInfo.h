@@ -45,6 +45,7 @@ protected:
     inline bool hasAVX2() const override            { return m_avx2; }
     inline bool hasBMI2() const override            { return m_bmi2; }
     inline bool hasOneGbPages() const override      { return m_pdpe1gb; }
+    inline bool hasSSE41() const override           { return m_sse41; }
     inline const char *backend() const override     { return m_backend; }
     inline const char *brand() const override       { return m_brand; }
     inline MsrMod msrMod() const override           { return m_msrMod; }
@@ -62,6 +63,7 @@ private:
     bool m_avx2           = false;
     bool m_bmi2           = false;
     bool m_L2_exclusive   = false;
+    bool m_sse41          = false;
     char m_backend[32]{};
     char m_brand[64 + 5]{};
     const bool m_pdpe1gb  = false;
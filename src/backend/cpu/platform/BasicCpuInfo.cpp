@@ -53,6 +53,10 @@
 #   define bit_PDPE1GB (1 << 26)
 #endif
 
+#ifndef bit_SSE4_1
+#   define bit_SSE4_1 (1 << 19)
+#endif
+
 
 #include "backend/cpu/platform/BasicCpuInfo.h"
 #include "crypto/common/Assembly.h"
@@ -157,6 +161,12 @@ static inline bool has_pdpe1gb()
 }
 
 
+static inline bool has_sse41()
+{
+    return has_feature(PROCESSOR_INFO, ECX_Reg, bit_SSE4_1);
+}
+
+
 } // namespace xmrig
 
 
@@ -165,7 +175,8 @@ xmrig::BasicCpuInfo::BasicCpuInfo() :
     m_aes(has_aes_ni()),
     m_avx2(has_avx2()),
     m_bmi2(has_bmi2()),
-    m_pdpe1gb(has_pdpe1gb())
+    m_pdpe1gb(has_pdpe1gb()),
+    m_sse41(has_sse41())
 {
     cpu_brand_string(m_brand);
 
@@ -46,6 +46,7 @@ protected:
     inline bool hasAVX2() const override            { return m_avx2; }
     inline bool hasBMI2() const override            { return m_bmi2; }
     inline bool hasOneGbPages() const override      { return m_pdpe1gb; }
+    inline bool hasSSE41() const override           { return m_sse41; }
     inline const char *brand() const override       { return m_brand; }
     inline MsrMod msrMod() const override           { return m_msrMod; }
     inline size_t cores() const override            { return 0; }
@@ -66,6 +67,7 @@ private:
     const bool m_avx2       = false;
     const bool m_bmi2       = false;
     const bool m_pdpe1gb    = false;
+    const bool m_sse41      = false;
     MsrMod m_msrMod         = MSR_MOD_NONE;
     Vendor m_vendor         = VENDOR_UNKNOWN;
 };
@@ -43,6 +43,7 @@
 #include "base/tools/String.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
+#include "crypto/common/Nonce.h"
 #include "rapidjson/document.h"
 
 
@@ -431,6 +432,7 @@ void xmrig::CudaBackend::start(IWorker *worker, bool ready)
         d_ptr->status.print();
 
         CudaWorker::ready = true;
+        Nonce::notify();
     }
 
     mutex.unlock();
@@ -490,6 +492,8 @@ rapidjson::Value xmrig::CudaBackend::toJSON(rapidjson::Document &doc) const
         out.AddMember("versions", versions, allocator);
     }
 
+    out.AddMember("resume-latency", Nonce::resumeLatency(Nonce::CUDA), allocator);
+
     if (d_ptr->threads.empty() || !hashrate()) {
         return out;
     }
@@ -112,10 +112,7 @@ void xmrig::CudaWorker::start()
 {
     while (Nonce::sequence(Nonce::CUDA) > 0) {
         if (!isReady()) {
-            do {
-                std::this_thread::sleep_for(std::chrono::milliseconds(200));
-            }
-            while (!isReady() && Nonce::sequence(Nonce::CUDA) > 0);
+            Nonce::wait(Nonce::CUDA, [] { return isReady() || Nonce::sequence(Nonce::CUDA) == 0; });
 
             if (Nonce::sequence(Nonce::CUDA) == 0) {
                 break;
@@ -47,6 +47,12 @@ xmrig::CudaRxRunner::CudaRxRunner(size_t index, const CudaLaunchData &data) :
 }
 
 
+xmrig::CudaRxRunner::~CudaRxRunner()
+{
+    Rx::release(m_dataset);
+}
+
+
 bool xmrig::CudaRxRunner::run(uint32_t startNonce, uint32_t *rescount, uint32_t *resnonce)
 {
     return callWrapper(CudaLib::rxHash(m_ctx, startNonce, m_target, rescount, resnonce));
@@ -63,5 +69,14 @@ bool xmrig::CudaRxRunner::set(const Job &job, uint8_t *blob)
     auto dataset = Rx::dataset(job, 0);
     m_ready = callWrapper(CudaLib::rxPrepare(m_ctx, dataset->raw(), dataset->size(false), m_datasetHost, m_intensity));
 
+    // With the dataset in host memory the device keeps reading it, so it stays held while the runner lives.
+    if (m_datasetHost) {
+        Rx::release(m_dataset);
+        m_dataset = dataset;
+    }
+    else {
+        Rx::release(dataset);
+    }
+
     return m_ready;
 }
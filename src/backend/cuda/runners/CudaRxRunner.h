@@ -32,10 +32,14 @@
 namespace xmrig {
 
 
+class RxDataset;
+
+
 class CudaRxRunner : public CudaBaseRunner
 {
 public:
     CudaRxRunner(size_t index, const CudaLaunchData &data);
+    ~CudaRxRunner() override;
 
 protected:
     inline size_t intensity() const override { return m_intensity; }
@@ -46,6 +50,7 @@ protected:
 private:
     bool m_ready             = false;
     const bool m_datasetHost = false;
+    RxDataset *m_dataset     = nullptr;
     size_t m_intensity       = 0;
 };
 
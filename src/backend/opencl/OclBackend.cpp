@@ -45,6 +45,7 @@
 #include "base/tools/String.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
+#include "crypto/common/Nonce.h"
 #include "rapidjson/document.h"
 
 
@@ -431,6 +432,7 @@ void xmrig::OclBackend::start(IWorker *worker, bool ready)
         d_ptr->status.print();
 
         OclWorker::ready = true;
+        Nonce::notify();
     }
 
     mutex.unlock();
@@ -476,6 +478,7 @@ rapidjson::Value xmrig::OclBackend::toJSON(rapidjson::Document &doc) const
     out.AddMember("algo",       d_ptr->algo.toJSON(), allocator);
     out.AddMember("profile",    profileName().toJSON(), allocator);
     out.AddMember("platform",   d_ptr->platform.toJSON(doc), allocator);
+    out.AddMember("resume-latency", Nonce::resumeLatency(Nonce::OPENCL), allocator);
 
     if (d_ptr->threads.empty() || !hashrate()) {
         return out;
@@ -164,10 +164,7 @@ void xmrig::OclWorker::start()
         if (!isReady()) {
             m_sharedData.setResumeCounter(0);
 
-            do {
-                std::this_thread::sleep_for(std::chrono::milliseconds(200));
-            }
-            while (!isReady() && Nonce::sequence(Nonce::OPENCL) > 0);
+            Nonce::wait(Nonce::OPENCL, [] { return isReady() || Nonce::sequence(Nonce::OPENCL) == 0; });
 
             if (Nonce::sequence(Nonce::OPENCL) == 0) {
                 break;
@@ -126,6 +126,7 @@ void xmrig::OclRxBaseRunner::set(const Job &job, uint8_t *blob)
 
         auto dataset = Rx::dataset(job, 0);
         enqueueWriteBuffer(m_dataset, CL_TRUE, 0, RxDataset::maxSize(), dataset->raw());
+        Rx::release(dataset);
     }
 
     if (job.size() < Job::kMaxBlobSize) {
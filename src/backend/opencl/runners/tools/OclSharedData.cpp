@@ -143,6 +143,8 @@ void xmrig::OclSharedData::release()
 
 #   ifdef XMRIG_ALGO_RANDOMX
     OclLib::release(m_dataset);
+    Rx::release(m_hostDataset);
+    m_hostDataset = nullptr;
 #   endif
 }
 
@@ -190,9 +192,10 @@ void xmrig::OclSharedData::createDataset(cl_context ctx, const Job &job, bool ho
     cl_int ret;
 
     if (host) {
-        auto dataset = Rx::dataset(job, 0);
+        // The device reads host memory directly, the dataset stays held until the buffer is released.
+        m_hostDataset = Rx::dataset(job, 0);
 
-        m_dataset = OclLib::createBuffer(ctx, CL_MEM_READ_ONLY | CL_MEM_USE_HOST_PTR, RxDataset::maxSize(), dataset->raw(), &ret);
+        m_dataset = OclLib::createBuffer(ctx, CL_MEM_READ_ONLY | CL_MEM_USE_HOST_PTR, RxDataset::maxSize(), m_hostDataset->raw(), &ret);
     }
     else {
         m_dataset = OclLib::createBuffer(ctx, CL_MEM_READ_ONLY, RxDataset::maxSize(), nullptr, &ret);
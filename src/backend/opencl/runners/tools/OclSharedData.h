@@ -38,6 +38,7 @@ namespace xmrig {
 
 
 class Job;
+class RxDataset;
 
 
 class OclSharedData
@@ -73,6 +74,7 @@ private:
 
 #   ifdef XMRIG_ALGO_RANDOMX
     cl_mem m_dataset          = nullptr;
+    RxDataset *m_hostDataset  = nullptr;
 #   endif
 };
 
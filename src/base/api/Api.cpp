@@ -29,6 +29,7 @@
 #include "base/api/Api.h"
 #include "3rdparty/http-parser/http_parser.h"
 #include "base/api/interfaces/IApiListener.h"
+#include "base/api/Metrics.h"
 #include "base/api/requests/HttpApiRequest.h"
 #include "base/crypto/keccak.h"
 #include "base/io/json/Json.h"
@@ -88,7 +89,8 @@ static rapidjson::Value getResources(rapidjson::Document &doc)
 
 xmrig::Api::Api(Base *base) :
     m_base(base),
-    m_timestamp(Chrono::currentMSecsSinceEpoch())
+    m_timestamp(Chrono::currentMSecsSinceEpoch()),
+    m_metrics(new Metrics())
 {
     base->addListener(this);
 
@@ -101,12 +103,14 @@ xmrig::Api::~Api()
 #   ifdef XMRIG_FEATURE_HTTP
     delete m_httpd;
 #   endif
+
+    delete m_metrics;
 }
 
 
 void xmrig::Api::request(const HttpData &req)
 {
-    HttpApiRequest request(req, m_base->config()->http().isRestricted());
+    HttpApiRequest request(req, m_base->config()->http().isRestricted(), m_metrics);
 
     exec(request);
 }
@@ -186,6 +190,15 @@ void xmrig::Api::exec(IApiRequest &request)
 #       endif
         reply.AddMember("features", features, allocator);
     }
+    else if (request.type() == IApiRequest::REQ_METRICS) {
+        request.accept();
+
+        Metrics &metrics = *request.metrics();
+        metrics.reset();
+
+        metrics.family("xmrig_uptime_seconds", Metrics::GAUGE, "Time since the miner was started");
+        metrics.add("xmrig_uptime_seconds", nullptr, (Chrono::currentMSecsSinceEpoch() - m_timestamp) / 1000);
+    }
 
     for (IApiListener *listener : m_listeners) {
         listener->onRequest(request);
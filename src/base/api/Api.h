@@ -43,6 +43,7 @@ class Httpd;
 class HttpData;
 class IApiListener;
 class IApiRequest;
+class Metrics;
 class String;
 
 
@@ -74,7 +75,8 @@ private:
     char m_id[32]{};
     String m_workerId;
     const uint64_t m_timestamp;
-    Httpd *m_httpd = nullptr;
+    Httpd *m_httpd      = nullptr;
+    Metrics *m_metrics;
     std::vector<IApiListener *> m_listeners;
 };
 
@@ -0,0 +1,139 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "base/api/Metrics.h"
+
+
+#include <cinttypes>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+
+namespace xmrig {
+
+
+const char *Metrics::kContentType = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+
+static const char *types[] = { "counter", "gauge", "histogram" };
+static constexpr size_t kReserve = 32 * 1024;
+
+
+// The build uses -ffast-math, so NaN must be detected by its bit pattern.
+static inline bool isFinite(double value)
+{
+    uint64_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+
+    return (bits & 0x7FF0000000000000ULL) != 0x7FF0000000000000ULL;
+}
+
+
+static inline const char *lbrace(const char *labels) { return labels && *labels ? "{" : ""; }
+static inline const char *rbrace(const char *labels) { return labels && *labels ? "}" : ""; }
+
+
+} // namespace xmrig
+
+
+xmrig::Metrics::Metrics() :
+    m_buf(kReserve)
+{
+}
+
+
+void xmrig::Metrics::add(const char *name, const char *labels, double value)
+{
+    if (isFinite(value)) {
+        append("%s%s%s%s %.6g\n", name, lbrace(labels), labels ? labels : "", rbrace(labels), value);
+    }
+    else {
+        append("%s%s%s%s NaN\n", name, lbrace(labels), labels ? labels : "", rbrace(labels));
+    }
+}
+
+
+void xmrig::Metrics::add(const char *name, const char *labels, uint64_t value)
+{
+    append("%s%s%s%s %" PRIu64 "\n", name, lbrace(labels), labels ? labels : "", rbrace(labels), value);
+}
+
+
+void xmrig::Metrics::family(const char *name, Type type, const char *help)
+{
+    append("# TYPE %s %s\n# HELP %s %s\n", name, types[type], name, help);
+}
+
+
+void xmrig::Metrics::finish()
+{
+    append("# EOF\n");
+}
+
+
+void xmrig::Metrics::histogram(const char *name, const char *labels, const double *bounds, const uint64_t *buckets, size_t count, double sum)
+{
+    const char *sep = labels && *labels ? "," : "";
+    uint64_t total  = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        total += buckets[i];
+        append("%s_bucket{%s%sle=\"%g\"} %" PRIu64 "\n", name, labels ? labels : "", sep, bounds[i], total);
+    }
+
+    total += buckets[count];
+    append("%s_bucket{%s%sle=\"+Inf\"} %" PRIu64 "\n", name, labels ? labels : "", sep, total);
+    append("%s_count%s%s%s %" PRIu64 "\n", name, lbrace(labels), labels ? labels : "", rbrace(labels), total);
+    append("%s_sum%s%s%s %.6g\n", name, lbrace(labels), labels ? labels : "", rbrace(labels), sum);
+}
+
+
+void xmrig::Metrics::reset()
+{
+    m_size = 0;
+}
+
+
+void xmrig::Metrics::append(const char *fmt, ...)
+{
+    while (true) {
+        va_list args;
+        va_start(args, fmt);
+        const int rc = vsnprintf(m_buf.data() + m_size, m_buf.size() - m_size, fmt, args);
+        va_end(args);
+
+        if (rc < 0) {
+            return;
+        }
+
+        if (m_size + static_cast<size_t>(rc) < m_buf.size()) {
+            m_size += static_cast<size_t>(rc);
+
+            return;
+        }
+
+        m_buf.resize(m_buf.size() * 2 + static_cast<size_t>(rc));
+    }
+}
@@ -0,0 +1,78 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_METRICS_H
+#define XMRIG_METRICS_H
+
+
+#include "base/tools/Object.h"
+
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace xmrig {
+
+
+// OpenMetrics text exposition writer, the buffer is kept between scrapes so rendering normally does not allocate.
+class Metrics
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(Metrics)
+
+    enum Type {
+        COUNTER,
+        GAUGE,
+        HISTOGRAM
+    };
+
+    static const char *kContentType;
+
+    Metrics();
+
+    inline const char *data() const     { return m_buf.data(); }
+    inline size_t size() const          { return m_size; }
+
+    void add(const char *name, const char *labels, double value);
+    void add(const char *name, const char *labels, uint64_t value);
+    void family(const char *name, Type type, const char *help);
+    void finish();
+    // buckets holds count + 1 non-cumulative values, the last one counts everything above the last bound.
+    void histogram(const char *name, const char *labels, const double *bounds, const uint64_t *buckets, size_t count, double sum);
+    void reset();
+
+private:
+    void append(const char *fmt, ...);
+
+    size_t m_size = 0;
+    std::vector<char> m_buf;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_METRICS_H */
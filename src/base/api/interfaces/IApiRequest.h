@@ -32,6 +32,7 @@
 namespace xmrig {
 
 
+class Metrics;
 class String;
 
 
@@ -55,7 +56,8 @@ public:
     enum RequestType {
         REQ_UNKNOWN,
         REQ_SUMMARY,
-        REQ_JSON_RPC
+        REQ_JSON_RPC,
+        REQ_METRICS
     };
 
 
@@ -79,6 +81,7 @@ public:
     virtual const String &url() const                                   = 0;
     virtual int version() const                                         = 0;
     virtual Method method() const                                       = 0;
+    virtual Metrics *metrics()                                          = 0;
     virtual rapidjson::Document &doc()                                  = 0;
     virtual rapidjson::Value &reply()                                   = 0;
     virtual RequestType type() const                                    = 0;
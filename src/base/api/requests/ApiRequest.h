@@ -56,6 +56,7 @@ protected:
     inline bool isRestricted() const override       { return m_restricted; }
     inline const String &rpcMethod() const override { return m_rpcMethod; }
     inline int version() const override             { return m_version; }
+    inline Metrics *metrics() override              { return m_metrics; }
     inline RequestType type() const override        { return m_type; }
     inline Source source() const override           { return m_source; }
     inline void done(int) override                  { m_state = STATE_DONE; }
@@ -63,6 +64,7 @@ protected:
     int m_version       = 1;
     RequestType m_type  = REQ_UNKNOWN;
     State m_state       = STATE_NEW;
+    Metrics *m_metrics  = nullptr;
     String m_rpcMethod;
 
 private:
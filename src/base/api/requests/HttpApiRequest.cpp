@@ -25,6 +25,7 @@
 
 #include "3rdparty/http-parser/http_parser.h"
 #include "base/api/requests/HttpApiRequest.h"
+#include "base/api/Metrics.h"
 #include "base/io/json/Json.h"
 #include "base/net/http/HttpData.h"
 #include "rapidjson/error/en.h"
@@ -64,7 +65,7 @@ static inline const char *rpcError(int code) {
 } // namespace xmrig
 
 
-xmrig::HttpApiRequest::HttpApiRequest(const HttpData &req, bool restricted) :
+xmrig::HttpApiRequest::HttpApiRequest(const HttpData &req, bool restricted, Metrics *metrics) :
     ApiRequest(SOURCE_HTTP, restricted),
     m_req(req),
     m_res(req.id()),
@@ -74,6 +75,10 @@ xmrig::HttpApiRequest::HttpApiRequest(const HttpData &req, bool restricted) :
         if (url() == "/1/summary" || url() == "/2/summary" || url() == "/api.json") {
             m_type = REQ_SUMMARY;
         }
+        else if (metrics && url() == "/metrics") {
+            m_type    = REQ_METRICS;
+            m_metrics = metrics;
+        }
     }
 
     if (method() == METHOD_POST && url() == "/json_rpc") {
@@ -167,6 +172,14 @@ void xmrig::HttpApiRequest::done(int status)
             setRpcResult(result);
         }
     }
+    else if (type() == REQ_METRICS && status == HTTP_STATUS_OK) {
+        m_metrics->finish();
+
+        m_res.setStatus(status);
+        m_res.setHeader(HttpData::kContentType, Metrics::kContentType);
+
+        return m_res.HttpResponse::end(m_metrics->data(), m_metrics->size());
+    }
     else {
         m_res.setStatus(status);
     }
@@ -41,7 +41,7 @@ class HttpData;
 class HttpApiRequest : public ApiRequest
 {
 public:
-    HttpApiRequest(const HttpData &req, bool restricted);
+    HttpApiRequest(const HttpData &req, bool restricted, Metrics *metrics = nullptr);
 
 protected:
     inline bool hasParseError() const override           { return m_parsed == 2; }
@@ -31,6 +31,7 @@ set(HEADERS_BASE
     src/base/kernel/interfaces/ISignalListener.h
     src/base/kernel/interfaces/IStrategy.h
     src/base/kernel/interfaces/IStrategyListener.h
+    src/base/kernel/interfaces/ITcpProbeListener.h
     src/base/kernel/interfaces/ITimerListener.h
     src/base/kernel/interfaces/IWatcherListener.h
     src/base/kernel/Platform.h
@@ -41,6 +42,7 @@ set(HEADERS_BASE
     src/base/net/http/Http.h
     src/base/net/http/HttpListener.h
     src/base/net/stratum/BaseClient.h
+    src/base/net/stratum/BbpExchange.h
     src/base/net/stratum/BiblePay.h
     src/base/net/stratum/Client.h
     src/base/net/stratum/Job.h
@@ -50,6 +52,7 @@ set(HEADERS_BASE
     src/base/net/stratum/ProxyUrl.h
     src/base/net/stratum/Socks5.h
     src/base/net/stratum/strategies/FailoverStrategy.h
+    src/base/net/stratum/strategies/FastestStrategy.h
     src/base/net/stratum/strategies/SinglePoolStrategy.h
     src/base/net/stratum/strategies/StrategyProxy.h
     src/base/net/stratum/SubmitResult.h
@@ -58,7 +61,9 @@ set(HEADERS_BASE
     src/base/net/tools/MemPool.h
     src/base/net/tools/NetBuffer.h
     src/base/net/tools/Storage.h
+    src/base/net/tools/TcpProbe.h
     src/base/tools/Arguments.h
+    src/base/tools/Barrier.h
     src/base/tools/Baton.h
     src/base/tools/Buffer.h
     src/base/tools/Chrono.h
@@ -94,6 +99,7 @@ set(SOURCES_BASE
     src/base/net/stratum/BaseClient.cpp
     src/base/net/stratum/Client.cpp
     src/base/net/stratum/Job.cpp
+    src/base/net/stratum/BbpExchange.cpp
     src/base/net/stratum/BiblePay.cpp
     src/base/net/stratum/NetworkState.cpp
     src/base/net/stratum/Pool.cpp
@@ -101,10 +107,12 @@ set(SOURCES_BASE
     src/base/net/stratum/ProxyUrl.cpp
     src/base/net/stratum/Socks5.cpp
     src/base/net/stratum/strategies/FailoverStrategy.cpp
+    src/base/net/stratum/strategies/FastestStrategy.cpp
     src/base/net/stratum/strategies/SinglePoolStrategy.cpp
     src/base/net/stratum/Url.cpp
     src/base/net/tools/LineReader.cpp
     src/base/net/tools/NetBuffer.cpp
+    src/base/net/tools/TcpProbe.cpp
     src/base/tools/Arguments.cpp
     src/base/tools/Buffer.cpp
     src/base/tools/String.cpp
@@ -152,6 +160,7 @@ if (WITH_HTTP)
         src/base/api/Api.h
         src/base/api/Httpd.h
         src/base/api/interfaces/IApiRequest.h
+        src/base/api/Metrics.h
         src/base/api/requests/ApiRequest.h
         src/base/api/requests/HttpApiRequest.h
         src/base/kernel/interfaces/IHttpListener.h
@@ -172,6 +181,7 @@ if (WITH_HTTP)
         src/3rdparty/http-parser/http_parser.c
         src/base/api/Api.cpp
         src/base/api/Httpd.cpp
+        src/base/api/Metrics.cpp
         src/base/api/requests/ApiRequest.cpp
         src/base/api/requests/HttpApiRequest.cpp
         src/base/net/http/Fetch.cpp
@@ -311,6 +311,9 @@ void xmrig::BaseTransform::transformUint64(rapidjson::Document &doc, int key, ui
     case IConfig::RetryPauseKey: /* --retry-pause */
         return set(doc, Pools::kRetryPause, arg);
 
+    case IConfig::PoolStrategyKey: /* --pool-strategy */
+        return set(doc, Pools::kPoolStrategy, arg);
+
     case IConfig::DonateLevelKey: /* --donate-level */
         return set(doc, Pools::kDonateLevel, arg);
 
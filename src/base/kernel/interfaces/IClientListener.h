@@ -50,6 +50,7 @@ public:
     virtual void onJobReceived(IClient *client, const Job &job, const rapidjson::Value &params)   = 0;
     virtual void onLogin(IClient *client, rapidjson::Document &doc, rapidjson::Value &params)     = 0;
     virtual void onLoginSuccess(IClient *client)                                                  = 0;
+    virtual void onNotification(IClient *client, const char *method, const rapidjson::Value &params) = 0;
     virtual void onResultAccepted(IClient *client, const SubmitResult &result, const char *error) = 0;
     virtual void onVerifyAlgorithm(const IClient *client, const Algorithm &algorithm, bool *ok)   = 0;
 };
@@ -74,11 +74,14 @@ public:
         DaemonPollKey        = 1019,
         SelfSelectKey        = 1028,
         DataDirKey           = 1035,
+        PoolStrategyKey      = 1041,
 
         // xmrig common
         CPUPriorityKey       = 1021,
         NicehashKey          = 1006,
         PrintTimeKey         = 1007,
+        ProxyHostKey         = 1039,
+        ProxyPortKey         = 1040,
 
         // xmrig cpu
         CPUKey               = 1024,
@@ -94,11 +97,14 @@ public:
         RandomX1GbPagesKey   = 1031,
         RandomXWrmsrKey      = 1032,
         RandomXRdmsrKey      = 1033,
+        RandomXCacheDirKey   = 1038,
         CPUMaxThreadsKey     = 1026,
         MemoryPoolKey        = 1027,
         YieldKey             = 1030,
         AstroBWTMaxSizeKey   = 1034,
         AstroBWTAVX2Key      = 1036,
+        BenchKey             = 1037,
+        BenchMicroKey        = 1042,
 
         // xmrig amd
         OclPlatformKey       = 1400,
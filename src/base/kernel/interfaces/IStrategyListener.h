@@ -47,6 +47,7 @@ public:
     virtual void onActive(IStrategy *strategy, IClient *client)                                                        = 0;
     virtual void onJob(IStrategy *strategy, IClient *client, const Job &job)                                           = 0;
     virtual void onLogin(IStrategy *strategy, IClient *client, rapidjson::Document &doc, rapidjson::Value &params)     = 0;
+    virtual void onNotification(IStrategy *strategy, IClient *client, const char *method, const rapidjson::Value &params) = 0;
     virtual void onPause(IStrategy *strategy)                                                                          = 0;
     virtual void onResultAccepted(IStrategy *strategy, IClient *client, const SubmitResult &result, const char *error) = 0;
     virtual void onVerifyAlgorithm(IStrategy *strategy, const IClient *client, const Algorithm &algorithm, bool *ok)   = 0;
@@ -25,15 +25,60 @@
 
 #include "base/kernel/interfaces/IDnsListener.h"
 #include "base/net/dns/Dns.h"
+#include "base/tools/Chrono.h"
 #include "base/tools/Handle.h"
+#include "base/tools/Timer.h"
 
 
 namespace xmrig {
+    std::map<std::string, Dns::Entry> Dns::m_cache;
     Storage<Dns> Dns::m_storage;
     static const DnsRecord defaultRecord;
+
+
+static addrinfo makeHints()
+{
+    addrinfo hints{};
+    hints.ai_family   = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_protocol = IPPROTO_TCP;
+
+    return hints;
+}
+
+
+static const DnsRecord *pick(const std::vector<DnsRecord> &records, uint64_t now)
+{
+    std::vector<const DnsRecord *> healthy;
+    healthy.reserve(records.size());
+
+    for (const auto &record : records) {
+        if (record.isHealthy(now)) {
+            healthy.push_back(&record);
+        }
+    }
+
+    if (healthy.empty()) {
+        return nullptr;
+    }
+
+    return healthy[healthy.size() == 1 ? 0 : static_cast<size_t>(rand()) % healthy.size()];
 }
 
 
+static void setStatus(std::vector<DnsRecord> &records, const String &ip, int status, uint64_t now)
+{
+    for (auto &record : records) {
+        if (record.ip() == ip) {
+            record.setStatus(status, now);
+        }
+    }
+}
+
+
+} // namespace xmrig
+
+
 xmrig::Dns::Dns(IDnsListener *listener) :
     m_hints(),
     m_listener(listener),
@@ -45,9 +90,7 @@ xmrig::Dns::Dns(IDnsListener *listener) :
     m_resolver = new uv_getaddrinfo_t;
     m_resolver->data = m_storage.ptr(m_key);
 
-    m_hints.ai_family   = AF_UNSPEC;
-    m_hints.ai_socktype = SOCK_STREAM;
-    m_hints.ai_protocol = IPPROTO_TCP;
+    m_hints = makeHints();
 }
 
 
@@ -55,10 +98,37 @@ xmrig::Dns::~Dns()
 {
     m_storage.release(m_key);
 
+    delete m_timer;
     delete m_resolver;
 }
 
 
+void xmrig::Dns::prefetch(const String &host)
+{
+    if (host.isNull()) {
+        return;
+    }
+
+    auto &entry = m_cache[host.data()];
+    if (entry.refreshing) {
+        return;
+    }
+
+    const addrinfo hints = makeHints();
+
+    auto req  = new uv_getaddrinfo_t;
+    req->data = new String(host);
+
+    if (uv_getaddrinfo(uv_default_loop(), req, Dns::onPrefetch, host.data(), nullptr, &hints) == 0) {
+        entry.refreshing = true;
+    }
+    else {
+        delete static_cast<String *>(req->data);
+        delete req;
+    }
+}
+
+
 bool xmrig::Dns::resolve(const String &host)
 {
     if (m_host != host) {
@@ -67,6 +137,33 @@ bool xmrig::Dns::resolve(const String &host)
         clear();
     }
 
+    const uint64_t now = Chrono::steadyMSecs();
+    const auto it      = m_host.isNull() ? m_cache.end() : m_cache.find(m_host.data());
+
+    if (it != m_cache.end() && now < it->second.expire) {
+        const Entry &entry = it->second;
+
+        // Hot entries are renewed in the background before they expire, so reconnects never wait for a lookup.
+        if (entry.status == 0 && (entry.expire - now) < kTTL / 4) {
+            prefetch(m_host);
+        }
+
+        m_status = entry.status;
+        if (m_status == 0) {
+            m_ipv4 = entry.ipv4;
+            m_ipv6 = entry.ipv6;
+        }
+
+        // Listeners expect the result from the event loop, never from inside resolve().
+        if (!m_timer) {
+            m_timer = new Timer(this);
+        }
+
+        m_timer->start(0, 0);
+
+        return true;
+    }
+
     m_status = uv_getaddrinfo(uv_default_loop(), m_resolver, Dns::onResolved, m_host.data(), nullptr, &m_hints);
 
     return m_status == 0;
@@ -85,18 +182,23 @@ const xmrig::DnsRecord &xmrig::Dns::get(DnsRecord::Type prefered) const
         return defaultRecord;
     }
 
-    const size_t ipv4 = m_ipv4.size();
-    const size_t ipv6 = m_ipv6.size();
+    const uint64_t now = Chrono::steadyMSecs();
+    const auto &first  = prefered == DnsRecord::AAAA ? m_ipv6 : m_ipv4;
+    const auto &second = prefered == DnsRecord::AAAA ? m_ipv4 : m_ipv6;
 
-    if (ipv6 && (prefered == DnsRecord::AAAA || !ipv4)) {
-        return m_ipv6[ipv6 == 1 ? 0 : static_cast<size_t>(rand()) % ipv6];
+    // Addresses that failed recently are skipped while there is any other choice.
+    const DnsRecord *record = pick(first, now);
+    if (!record) {
+        record = pick(second, now);
     }
 
-    if (ipv4) {
-        return m_ipv4[ipv4 == 1 ? 0 : static_cast<size_t>(rand()) % ipv4];
+    if (record) {
+        return *record;
     }
 
-    return defaultRecord;
+    const auto &records = first.empty() ? second : first;
+
+    return records[records.size() == 1 ? 0 : static_cast<size_t>(rand()) % records.size()];
 }
 
 
@@ -114,6 +216,27 @@ size_t xmrig::Dns::count(DnsRecord::Type type) const
 }
 
 
+void xmrig::Dns::report(const String &ip, int status)
+{
+    const uint64_t now = Chrono::steadyMSecs();
+
+    setStatus(m_ipv4, ip, status, now);
+    setStatus(m_ipv6, ip, status, now);
+
+    const auto it = m_host.isNull() ? m_cache.end() : m_cache.find(m_host.data());
+    if (it != m_cache.end()) {
+        setStatus(it->second.ipv4, ip, status, now);
+        setStatus(it->second.ipv6, ip, status, now);
+    }
+}
+
+
+void xmrig::Dns::onTimer(const Timer *)
+{
+    m_listener->onResolved(*this, m_status);
+}
+
+
 void xmrig::Dns::clear()
 {
     m_ipv4.clear();
@@ -123,32 +246,96 @@ void xmrig::Dns::clear()
 
 void xmrig::Dns::onResolved(int status, addrinfo *res)
 {
-    m_status = status;
+    const Entry &entry = store(m_host, status, res);
+
+    m_status = entry.status;
 
     if (m_status < 0) {
-        return m_listener->onResolved(*this, status);
+        return m_listener->onResolved(*this, m_status);
     }
 
-    clear();
+    m_ipv4 = entry.ipv4;
+    m_ipv6 = entry.ipv6;
+
+    m_listener->onResolved(*this, m_status);
+}
+
+
+const xmrig::Dns::Entry &xmrig::Dns::store(const String &host, int status, addrinfo *res)
+{
+    auto &entry = m_cache[host.data()];
+    const uint64_t now = Chrono::steadyMSecs();
+
+    std::vector<DnsRecord> ipv4;
+    std::vector<DnsRecord> ipv6;
+
+    if (status == 0) {
+        for (addrinfo *ptr = res; ptr != nullptr; ptr = ptr->ai_next) {
+            if (ptr->ai_family == AF_INET) {
+                ipv4.emplace_back(ptr);
+            }
 
-    addrinfo *ptr = res;
-    while (ptr != nullptr) {
-        if (ptr->ai_family == AF_INET) {
-            m_ipv4.push_back(ptr);
+            if (ptr->ai_family == AF_INET6) {
+                ipv6.emplace_back(ptr);
+            }
         }
 
-        if (ptr->ai_family == AF_INET6) {
-            m_ipv6.push_back(ptr);
+        if (ipv4.empty() && ipv6.empty()) {
+            status = UV_EAI_NONAME;
         }
+    }
+
+    if (status < 0) {
+        entry.status = status;
+        entry.expire = now + kNegativeTTL;
+        entry.ipv4.clear();
+        entry.ipv6.clear();
 
-        ptr = ptr->ai_next;
+        return entry;
     }
 
-    if (isEmpty()) {
-        m_status = UV_EAI_NONAME;
+    // Health stats survive a refresh for the addresses that are still there.
+    for (auto &record : ipv4) {
+        for (const auto &old : entry.ipv4) {
+            if (old.ip() == record.ip()) {
+                record = old;
+            }
+        }
     }
 
-    m_listener->onResolved(*this, m_status);
+    for (auto &record : ipv6) {
+        for (const auto &old : entry.ipv6) {
+            if (old.ip() == record.ip()) {
+                record = old;
+            }
+        }
+    }
+
+    entry.status = 0;
+    entry.expire = now + kTTL;
+    entry.ipv4   = std::move(ipv4);
+    entry.ipv6   = std::move(ipv6);
+
+    return entry;
+}
+
+
+void xmrig::Dns::onPrefetch(uv_getaddrinfo_t *req, int status, addrinfo *res)
+{
+    auto host   = static_cast<String *>(req->data);
+    auto &entry = m_cache[host->data()];
+
+    entry.refreshing = false;
+
+    // A failed refresh keeps serving the records that are already known until they expire.
+    if (status == 0 || (entry.ipv4.empty() && entry.ipv6.empty())) {
+        store(*host, status, res);
+    }
+
+    uv_freeaddrinfo(res);
+
+    delete host;
+    delete req;
 }
 
 
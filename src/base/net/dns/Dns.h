@@ -26,10 +26,13 @@
 #define XMRIG_DNS_H
 
 
+#include <map>
+#include <string>
 #include <vector>
 #include <uv.h>
 
 
+#include "base/kernel/interfaces/ITimerListener.h"
 #include "base/net/dns/DnsRecord.h"
 #include "base/net/tools/Storage.h"
 #include "base/tools/String.h"
@@ -39,13 +42,20 @@ namespace xmrig {
 
 
 class IDnsListener;
+class Timer;
 
 
-class Dns
+// Results are shared through a process-wide cache, getaddrinfo() does not expose record TTLs so a fixed one is used.
+class Dns : public ITimerListener
 {
 public:
+    constexpr static uint64_t kTTL          = 5 * 60 * 1000;
+    constexpr static uint64_t kNegativeTTL  = 5 * 1000;
+
     Dns(IDnsListener *listener);
-    ~Dns();
+    ~Dns() override;
+
+    static void prefetch(const String &host);
 
     inline bool isEmpty() const       { return m_ipv4.empty() && m_ipv6.empty(); }
     inline const String &host() const { return m_host; }
@@ -55,11 +65,26 @@ public:
     const char *error() const;
     const DnsRecord &get(DnsRecord::Type prefered = DnsRecord::A) const;
     size_t count(DnsRecord::Type type = DnsRecord::Unknown) const;
+    void report(const String &ip, int status);
+
+protected:
+    void onTimer(const Timer *timer) override;
 
 private:
+    struct Entry
+    {
+        bool refreshing = false;
+        int status      = 0;
+        uint64_t expire = 0;
+        std::vector<DnsRecord> ipv4;
+        std::vector<DnsRecord> ipv6;
+    };
+
     void clear();
     void onResolved(int status, addrinfo *res);
 
+    static const Entry &store(const String &host, int status, addrinfo *res);
+    static void onPrefetch(uv_getaddrinfo_t *req, int status, addrinfo *res);
     static void onResolved(uv_getaddrinfo_t *req, int status, addrinfo *res);
 
     addrinfo m_hints;
@@ -68,9 +93,11 @@ private:
     std::vector<DnsRecord> m_ipv4;
     std::vector<DnsRecord> m_ipv6;
     String m_host;
+    Timer *m_timer = nullptr;
     uintptr_t m_key;
     uv_getaddrinfo_t *m_resolver;
 
+    static std::map<std::string, Entry> m_cache;
     static Storage<Dns> m_storage;
 };
 
@@ -23,6 +23,7 @@
  */
 
 
+#include <algorithm>
 #include <uv.h>
 
 
@@ -47,6 +48,13 @@ xmrig::DnsRecord::DnsRecord(const addrinfo *addr) :
 }
 
 
+bool xmrig::DnsRecord::isHealthy(uint64_t now) const
+{
+    // Each failure in a row keeps the address out of rotation for another 10 seconds, up to 5 minutes.
+    return m_failures == 0 || (now - m_failedAt) >= std::min<uint64_t>(m_failures, 30) * 10000;
+}
+
+
 sockaddr *xmrig::DnsRecord::addr(uint16_t port) const
 {
     if (m_type == A) {
@@ -65,3 +73,16 @@ sockaddr *xmrig::DnsRecord::addr(uint16_t port) const
 
     return nullptr;
 }
+
+
+void xmrig::DnsRecord::setStatus(int status, uint64_t now)
+{
+    if (status < 0) {
+        m_failures++;
+        m_failedAt = now;
+    }
+    else {
+        m_failures = 0;
+        m_failedAt = 0;
+    }
+}
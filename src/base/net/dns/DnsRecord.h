@@ -26,13 +26,16 @@
 #define XMRIG_DNSRECORD_H
 
 
-struct addrinfo;
-struct sockaddr;
+#include <cstdint>
 
 
 #include "base/tools/String.h"
 
 
+struct addrinfo;
+struct sockaddr;
+
+
 namespace xmrig {
 
 
@@ -48,15 +51,20 @@ public:
     DnsRecord() = default;
     DnsRecord(const addrinfo *addr);
 
+    bool isHealthy(uint64_t now) const;
     sockaddr *addr(uint16_t port = 0) const;
+    void setStatus(int status, uint64_t now);
 
-    inline bool isValid() const     { return m_type != Unknown; }
-    inline const String &ip() const { return m_ip; }
-    inline Type type() const        { return m_type; }
+    inline bool isValid() const         { return m_type != Unknown; }
+    inline const String &ip() const     { return m_ip; }
+    inline Type type() const            { return m_type; }
+    inline uint32_t failures() const    { return m_failures; }
 
 private:
-    Type m_type = Unknown;
+    Type m_type         = Unknown;
     String m_ip;
+    uint32_t m_failures = 0;
+    uint64_t m_failedAt = 0;
 };
 
 
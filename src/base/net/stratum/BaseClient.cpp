@@ -29,6 +29,7 @@
 #include "base/net/stratum/SubmitResult.h"
 #include "rapidjson/document.h"
 #include "base/net/stratum/Pools.h"
+#include "base/net/stratum/BbpExchange.h"
 #include "base/net/stratum/BiblePay.h"
 
 
@@ -103,13 +104,16 @@ bool xmrig::BaseClient::handleResponse(int64_t id, const rapidjson::Value &resul
 			{
 				gbbp::m_bbpjob.iStale = 0;
 				gbbp::m_bbpjob.fNeedsReconnect = true;
-				gbbp::m_bbpjob.fInitialized = false;
+				BbpExchange::invalidate();
 			}
 		}
-		SubmitResult s = SubmitResult(1, (uint64_t)gbbp::m_bbpjob.JobDifficulty, gbbp::m_bbpjob.SolvedDifficulty, 1, 0, (const char*)("BBP"));
-		s.elapsed = Chrono::steadyMSecs() - gbbp::m_bbpjob.nSubmitTime;
-		if (s.elapsed < 0) 
-			s.elapsed = 1;
+		if (m_bbpResults.empty()) {
+			return true;
+		}
+
+		SubmitResult s = m_bbpResults.front();
+		m_bbpResults.pop_front();
+		s.done();
 
 		m_listener->onResultAccepted(this, s, longError);
 		return true;
@@ -26,12 +26,14 @@
 #define XMRIG_BASECLIENT_H
 
 
+#include <deque>
 #include <map>
 
 
 #include "base/kernel/interfaces/IClient.h"
 #include "base/net/stratum/Job.h"
 #include "base/net/stratum/Pool.h"
+#include "base/net/stratum/SubmitResult.h"
 #include "base/tools/Chrono.h"
 
 
@@ -39,7 +41,6 @@ namespace xmrig {
 
 
 class IClientListener;
-class SubmitResult;
 
 
 class BaseClient : public IClient
@@ -96,6 +97,7 @@ protected:
     Pool m_pool;
     Pool bbp_pool;
     SocketState m_state             = UnconnectedState;
+    std::deque<SubmitResult> m_bbpResults;
     std::map<int64_t, SendResult> m_callbacks;
     std::map<int64_t, SubmitResult> m_results;
     String m_ip;
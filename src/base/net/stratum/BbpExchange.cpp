@@ -0,0 +1,114 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "base/net/stratum/BbpExchange.h"
+
+
+#include <cstring>
+
+
+namespace xmrig {
+
+
+std::atomic<uint64_t> BbpExchange::m_sequence{ 0 };
+
+
+static std::atomic<uint64_t> prevHash[4];
+static std::atomic<uint64_t> difficulty{ 0 };
+static std::atomic<bool> initialized{ false };
+
+
+template<typename T>
+static inline void write(std::atomic<uint64_t> &sequence, T func)
+{
+    const uint64_t seq = sequence.load(std::memory_order_relaxed);
+
+    sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    func();
+
+    sequence.store(seq + 2, std::memory_order_release);
+}
+
+
+} // namespace xmrig
+
+
+void xmrig::BbpExchange::invalidate()
+{
+    write(m_sequence, [] { initialized.store(false, std::memory_order_relaxed); });
+}
+
+
+void xmrig::BbpExchange::read(Snapshot &snapshot)
+{
+    uint64_t seq0;
+    uint64_t seq1;
+    uint64_t words[4];
+    uint64_t diff;
+
+    do {
+        seq0 = m_sequence.load(std::memory_order_acquire);
+
+        for (size_t i = 0; i < 4; ++i) {
+            words[i] = prevHash[i].load(std::memory_order_relaxed);
+        }
+
+        diff                 = difficulty.load(std::memory_order_relaxed);
+        snapshot.initialized = initialized.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        seq1 = m_sequence.load(std::memory_order_relaxed);
+    } while ((seq0 & 1) || seq0 != seq1);
+
+    memcpy(snapshot.prevHash, words, sizeof(snapshot.prevHash));
+    memcpy(&snapshot.difficulty, &diff, sizeof(snapshot.difficulty));
+    snapshot.epoch = seq0;
+}
+
+
+void xmrig::BbpExchange::setDifficulty(double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    write(m_sequence, [bits] { difficulty.store(bits, std::memory_order_relaxed); });
+}
+
+
+void xmrig::BbpExchange::setPrevHash(const uint8_t *hash)
+{
+    uint64_t words[4];
+    memcpy(words, hash, sizeof(words));
+
+    write(m_sequence, [&words] {
+        for (size_t i = 0; i < 4; ++i) {
+            prevHash[i].store(words[i], std::memory_order_relaxed);
+        }
+
+        initialized.store(true, std::memory_order_relaxed);
+    });
+}
@@ -0,0 +1,86 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_BBPEXCHANGE_H
+#define XMRIG_BBPEXCHANGE_H
+
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+
+#include "base/net/stratum/Job.h"
+
+
+namespace xmrig {
+
+
+// RandomX header that solved the BBP equation, produced by a mining thread and sent by the network thread.
+struct BbpSolution
+{
+    uint8_t header[Job::kMaxBlobSize];
+    uint8_t rxHash[32];
+    uint8_t bbpHash[32];
+    uint8_t seed[32];
+    size_t size         = 0;
+    double jobDiff      = 0;
+    double solvedDiff   = 0;
+};
+
+
+// Publishes the BBP job from the network thread to the mining threads.
+//
+// The job (prev block hash and difficulty) is published with a seqlock, the sequence doubles as an epoch that
+// workers compare on every hash to pick up a new job. Publishing must happen on a single thread (the main loop).
+// Solutions travel back as JobResult payloads through JobResults, like any other share.
+class BbpExchange
+{
+public:
+    struct Snapshot
+    {
+        inline bool isReady() const { return initialized && difficulty > 0; }
+
+        uint8_t prevHash[32]{};
+        double difficulty   = 0;
+        bool initialized    = false;
+        uint64_t epoch      = 0;
+    };
+
+    static inline uint64_t epoch()      { return m_sequence.load(std::memory_order_acquire); }
+
+    static void invalidate();
+    static void read(Snapshot &snapshot);
+    static void setDifficulty(double difficulty);
+    static void setPrevHash(const uint8_t *prevHash);
+
+private:
+    static std::atomic<uint64_t> m_sequence;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_BBPEXCHANGE_H */
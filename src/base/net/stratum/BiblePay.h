@@ -36,17 +36,6 @@ namespace xmrig {
 	double MathRound(double d);
 
 	static std::mutex m_minermutex;
-	struct l_bbpjob
-	{
-		uint8_t prevhash[64] = { 0x0 };
-		uint8_t priorRandomXHeader[160] = { 0x0 };
-		uint8_t out_bbphash[64] = { 0x0 };
-		uint8_t out_rxhash[32] = { 0x0 };
-		bool fSolved = false;
-		double nDifficulty = 0;
-		double nActualDifficulty = 0;
-		bool fDebug = true;
-	};
 
 
 class gbbp
@@ -68,13 +57,6 @@ public:
     struct bbpjob
     {
 		uint32_t target[8] = { 0x0 };
-		uint8_t prevblockhash[128] = { 0x0 };
-		bool fInitialized = false;
-		bool fSolutionFound = false;
-		int64_t nSubmitTime = 0;
-		double difficulty = 0;
-		double JobDifficulty = 0;
-		double SolvedDifficulty = 0;
 		bool fRequestedRestart = false;
 		int CharityPort = 0;
 		bool fCharityInitialized = false;
@@ -55,6 +55,7 @@
 #include "rapidjson/writer.h"
 
 #include "base/net/stratum/Pools.h"
+#include "base/net/stratum/BbpExchange.h"
 #include "base/net/stratum/BiblePay.h"
 
 #ifdef _MSC_VER
@@ -192,19 +193,42 @@ static inline void be32enc(void* pp, uint32_t x)
 
 int64_t xmrig::Client::submit(const JobResult &result)
 {
+	if (!result.relay.isNull())
+	{
+		if (result.relay.size() > kMaxSendBufferSize) {
+			return -1;
+		}
+
+		if (result.relay.size() > (m_sendBuf.size() - 2)) {
+			m_sendBuf.resize(((result.relay.size() + 1) / 1024 + 1) * 1024);
+		}
+
+		if (send(snprintf(m_sendBuf.data(), m_sendBuf.size(), "%s\n", result.relay.data())) < 0) {
+			return -1;
+		}
+
+		// Replies come back first in first out like our own shares, reqId tells the proxy which miner to answer.
+		m_bbpResults.emplace_back(1, 0, 0, result.reqId, result.backend, "BBP");
 
+		return send(snprintf(m_sendBuf.data(), m_sendBuf.size(), "{\"id\": 1, \"method\": \"mining.subscribe\", \"params\": []}\n"));
+	}
 
-	if (result.clientId == "BBP")
+	if (result.bbp)
 	{
+		const BbpSolution &solution = *result.bbp;
+
 		send(snprintf(m_sendBuf.data(), m_sendBuf.size(),
 			"{\"id\":4, \"method\": \"mining.submit\", \"params\": [\"%s\", \"%s\", \"%s\", \"%s\", \"%s\", \"%s\", %d, %d, %d, %d, %d, %d ]}\n",
 			gbbp::m_mapBBPJob["userid"].c_str(), gbbp::m_mapBBPJob["job_id"].c_str(),
-			gbbp::m_mapBBPJob["randomxheader"].c_str(),
-			gbbp::m_mapBBPJob["jobtime"].c_str(), gbbp::m_mapBBPJob["randomxkey"].c_str(), gbbp::m_mapBBPJob["bbp_hash"].c_str(),
+			Buffer::toHex(solution.header, solution.size).data(),
+			gbbp::m_mapBBPJob["jobtime"].c_str(), Buffer::toHex(solution.seed, sizeof(solution.seed)).data(),
+			Buffer::toHex(solution.bbpHash, sizeof(solution.bbpHash)).data(),
 			gbbp::m_mapResultSuccess["BBP"], gbbp::m_mapResultFail["BBP"],
 			gbbp::m_mapResultSuccess["XMR"], gbbp::m_mapResultFail["XMR"],
 			gbbp::m_mapResultSuccess["XMR-Charity"], gbbp::m_mapResultFail["XMR-Charity"]));
-		gbbp::m_bbpjob.nSubmitTime = Chrono::steadyMSecs();
+
+		// The pool answers every BBP submit with id 100 in submission order, so replies are matched first in first out.
+		m_bbpResults.emplace_back(1, static_cast<uint64_t>(solution.jobDiff), static_cast<uint64_t>(solution.solvedDiff), 0, result.backend, "BBP");
 
 		int n2 = send(snprintf(m_sendBuf.data(), m_sendBuf.size(), "{\"id\": 1, \"method\": \"mining.subscribe\", \"params\": []}\n"));
 		return n2;
@@ -257,7 +281,7 @@ int64_t xmrig::Client::submit(const JobResult &result)
 #   ifdef XMRIG_PROXY_PROJECT
     m_results[m_sequence] = SubmitResult(m_sequence, result.diff, result.actualDiff(), result.id, 0, (const char*)"XMR");
 #   else
-    m_results[m_sequence] = SubmitResult(m_sequence, result.diff, result.actualDiff(), 0, result.backend, (const char*)"XMR");
+    m_results[m_sequence] = SubmitResult(m_sequence, result.diff, result.actualDiff(), result.reqId, result.backend, (const char*)"XMR");
 #   endif
 
     return send(doc);
@@ -475,6 +499,10 @@ bool xmrig::Client::parseJob(const rapidjson::Value &params, int *code)
         return false;
     }
 
+    if (job.algorithm().family() == Algorithm::RANDOM_X) {
+        job.setNextSeedHash(Json::getString(params, "next_seed_hash"));
+    }
+
     m_job.setClientId(m_rpcId);
 
     if (m_job != job) {
@@ -703,6 +731,8 @@ void xmrig::Client::Authorize()
 
 void xmrig::Client::login()
 {
+	m_bbpResults.clear();
+
 	bool fBBP = strlen(m_user) == 34 ? true : false;
 	if (fBBP)
 	{
@@ -835,7 +865,7 @@ bool xmrig::Client::MiningSetDifficulty(const char* method, const rapidjson::Val
 	double nDiff = (double)strtol(gbbp::m_mapBBPJob["Difficulty"].c_str(), NULL, 16);
 	for (int i = 0; i < 8; i++)
 		gbbp::m_bbpjob.target[i] = { 0x0 };
-	gbbp::m_bbpjob.difficulty = nDiff;
+	BbpExchange::setDifficulty(nDiff);
 	return true;
 }
 
@@ -887,8 +917,9 @@ bool xmrig::Client::MiningNotify_BBP(const char* method, const rapidjson::Value&
 		gbbp::m_mapBBPJob["ntime"].length() > 0)
 	{
 		gbbp::m_mapBBPJob["prevhash"] = gbbp::m_mapBBPJob["coinbase"].substr(8, 64);
-		Buffer::fromHex(gbbp::m_mapBBPJob["prevhash"].c_str(), 64, gbbp::m_bbpjob.prevblockhash);
-		gbbp::m_bbpjob.fInitialized = true;
+		uint8_t prevhash[32] = { 0x0 };
+		Buffer::fromHex(gbbp::m_mapBBPJob["prevhash"].c_str(), 64, prevhash);
+		BbpExchange::setPrevHash(prevhash);
 		gbbp::m_bbpjob.fNeedsReconnect = false;
 		fResult = true;
 	}
@@ -976,17 +1007,20 @@ void xmrig::Client::parseNotification(const char *method, const rapidjson::Value
 	if (strcmp(method, "mining.notify") == 0)
 	{
 		MiningNotify_BBP(method, params);
+		m_listener->onNotification(this, method, params);
 		return;
 	}
 	if (strcmp(method, "mining.set_difficulty") == 0)
 	{
 		MiningSetDifficulty(method, params);
+		m_listener->onNotification(this, method, params);
 		return;
 	}
 
 	if (strcmp(method, "mining.set_altruism") == 0)
 	{
 		MiningSetAltruism(method, params);
+		m_listener->onNotification(this, method, params);
 		return;
 	}
     LOG_WARN("[%s] unsupported method: \"%s\"", url(), method);
@@ -1178,6 +1212,8 @@ void xmrig::Client::onConnect(uv_connect_t *req, int status)
         return;
     }
 
+    client->m_dns->report(client->m_ip, status);
+
     if (status < 0) {
         if (!client->isQuiet()) {
             LOG_ERR("[%s] connect error: \"%s\"", client->url(), uv_strerror(status));
@@ -80,6 +80,21 @@ bool xmrig::Job::setBlob(const char *blob)
 }
 
 
+// Seed that will be used after the next epoch switch, only some pools and daemons announce it.
+bool xmrig::Job::setNextSeedHash(const char *hash)
+{
+    if (!hash || (strlen(hash) != kMaxSeedSize * 2)) {
+        m_nextSeed = Buffer();
+
+        return false;
+    }
+
+    m_nextSeed = Buffer::fromHex(hash, kMaxSeedSize * 2);
+
+    return !m_nextSeed.isEmpty();
+}
+
+
 bool xmrig::Job::setSeedHash(const char *hash)
 {
     if (!hash || (strlen(hash) != kMaxSeedSize * 2)) {
@@ -163,6 +178,7 @@ void xmrig::Job::copy(const Job &other)
     m_target     = other.m_target;
     m_index      = other.m_index;
     m_seed       = other.m_seed;
+    m_nextSeed   = other.m_nextSeed;
     m_extraNonce = other.m_extraNonce;
     m_poolWallet = other.m_poolWallet;
 
@@ -190,6 +206,7 @@ void xmrig::Job::move(Job &&other)
     m_target     = other.m_target;
     m_index      = other.m_index;
     m_seed       = std::move(other.m_seed);
+    m_nextSeed   = std::move(other.m_nextSeed);
     m_extraNonce = std::move(other.m_extraNonce);
     m_poolWallet = std::move(other.m_poolWallet);
 
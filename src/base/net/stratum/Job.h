@@ -57,6 +57,7 @@ public:
     ~Job() = default;
     bool isEqual(const Job &other) const;
     bool setBlob(const char *blob);
+    bool setNextSeedHash(const char *hash);
     bool setSeedHash(const char *hash);
     bool setTarget(const char *target);
     void setDiff(uint64_t diff);
@@ -65,6 +66,7 @@ public:
     inline bool isValid() const                         { return m_size > 0 && m_diff > 0; }
     inline bool setId(const char *id)                   { return m_id = id; }
     inline const Algorithm &algorithm() const           { return m_algorithm; }
+    inline const Buffer &nextSeed() const               { return m_nextSeed; }
     inline const Buffer &seed() const                   { return m_seed; }
     inline const String &clientId() const               { return m_clientId; }
     inline const String &extraNonce() const             { return m_extraNonce; }
@@ -88,6 +90,7 @@ public:
     inline void setExtraNonce(const String &extraNonce) { m_extraNonce = extraNonce; }
     inline void setHeight(uint64_t height)              { m_height = height; }
     inline void setIndex(uint8_t index)                 { m_index = index; }
+    inline void setNicehash(bool nicehash)              { m_nicehash = nicehash; }
     inline void setPoolWallet(const String &poolWallet) { m_poolWallet = poolWallet; }
 
 #   ifdef XMRIG_PROXY_PROJECT
@@ -111,6 +114,7 @@ private:
 
     Algorithm m_algorithm;
     bool m_nicehash     = false;
+    Buffer m_nextSeed;
     Buffer m_seed;
     size_t m_size       = 0;
     String m_clientId;
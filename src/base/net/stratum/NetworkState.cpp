@@ -33,6 +33,16 @@
 #include "rapidjson/document.h"
 
 
+#ifdef XMRIG_FEATURE_API
+#   include "base/api/Metrics.h"
+#endif
+
+
+#ifdef XMRIG_FEATURE_TLS
+#   include "base/net/stratum/TlsSessions.h"
+#endif
+
+
 #include <algorithm>
 #include <cstdio>
 #include <cstring>
@@ -40,6 +50,16 @@
 
 
 
+namespace xmrig {
+
+
+const double NetworkState::Histogram::msBounds[] = { 1, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000 };
+const double NetworkState::Histogram::usBounds[] = { 10, 50, 100, 250, 500, 1000, 2500, 5000, 10000, 50000, 100000, 1000000 };
+
+
+} // namespace xmrig
+
+
 xmrig::NetworkState::NetworkState(IStrategyListener *listener) : StrategyProxy(listener)
 {
 }
@@ -56,10 +76,28 @@ rapidjson::Value xmrig::NetworkState::getConnection(rapidjson::Document &doc, in
     connection.AddMember("ip",              m_ip.toJSON(), allocator);
     connection.AddMember("uptime",          connectionTime(), allocator);
     connection.AddMember("ping",            latency(), allocator);
+    connection.AddMember("submit_latency_us", median(m_submitLatency), allocator);
     connection.AddMember("failures",        m_failures, allocator);
     connection.AddMember("tls",             m_tls.toJSON(), allocator);
     connection.AddMember("tls-fingerprint", m_fingerprint.toJSON(), allocator);
 
+#   ifdef XMRIG_FEATURE_TLS
+    const auto stats = m_active ? TlsSessions::stats(m_pool) : nullptr;
+    if (stats) {
+        Value session(kObjectType);
+        session.AddMember("handshakes", stats->handshakes, allocator);
+        session.AddMember("resumed",    stats->resumed, allocator);
+        session.AddMember("hit_rate",   static_cast<double>(stats->resumed) / stats->handshakes, allocator);
+        session.AddMember("time",       stats->time, allocator);
+        session.AddMember("avg_time",   stats->total / stats->handshakes, allocator);
+
+        connection.AddMember("tls-session", session, allocator);
+    }
+    else {
+        connection.AddMember("tls-session", Value(kNullType), allocator);
+    }
+#   endif
+
     connection.AddMember("algo",            m_algorithm.toJSON(), allocator);
     connection.AddMember("diff",            m_diff, allocator);
     connection.AddMember("accepted",        m_accepted, allocator);
@@ -86,6 +124,7 @@ rapidjson::Value xmrig::NetworkState::getResults(rapidjson::Document &doc, int v
     results.AddMember("shares_good",   m_accepted, allocator);
     results.AddMember("shares_total",  m_accepted + m_rejected, allocator);
     results.AddMember("avg_time",      avgTime(), allocator);
+    results.AddMember("submit_latency_us", median(m_submitLatency), allocator);
     results.AddMember("hashes_total",  m_hashes, allocator);
 
     Value best(kArrayType);
@@ -101,6 +140,33 @@ rapidjson::Value xmrig::NetworkState::getResults(rapidjson::Document &doc, int v
 
     return results;
 }
+
+
+void xmrig::NetworkState::getMetrics(Metrics &metrics) const
+{
+    char labels[128];
+
+    metrics.family("xmrig_shares", Metrics::COUNTER, "Shares by source and pool response");
+    for (const auto &kv : m_shares) {
+        snprintf(labels, sizeof(labels), "source=\"%s\",result=\"accepted\"", kv.first.c_str());
+        metrics.add("xmrig_shares_total", labels, kv.second[0]);
+
+        snprintf(labels, sizeof(labels), "source=\"%s\",result=\"rejected\"", kv.first.c_str());
+        metrics.add("xmrig_shares_total", labels, kv.second[1]);
+    }
+
+    metrics.family("xmrig_submit_latency_microseconds", Metrics::HISTOGRAM, "Time from a share being found by a worker to being handed to the pool client");
+    metrics.histogram("xmrig_submit_latency_microseconds", nullptr, m_submitHistogram.bounds, m_submitHistogram.buckets.data(), Histogram::kBounds, m_submitHistogram.sum);
+
+    metrics.family("xmrig_result_latency_milliseconds", Metrics::HISTOGRAM, "Time from a share being submitted to the pool response");
+    metrics.histogram("xmrig_result_latency_milliseconds", nullptr, m_resultHistogram.bounds, m_resultHistogram.buckets.data(), Histogram::kBounds, m_resultHistogram.sum);
+
+    metrics.family("xmrig_pool_connected", Metrics::GAUGE, "Whether a pool connection is active");
+    metrics.add("xmrig_pool_connected", nullptr, static_cast<uint64_t>(m_active ? 1 : 0));
+
+    metrics.family("xmrig_pool_difficulty", Metrics::GAUGE, "Difficulty of the current job");
+    metrics.add("xmrig_pool_difficulty", nullptr, m_diff);
+}
 #endif
 
 
@@ -157,12 +223,19 @@ uint32_t xmrig::NetworkState::avgTime() const
 
 uint32_t xmrig::NetworkState::latency() const
 {
-    const size_t calls = m_latency.size();
+    return median(m_latency);
+}
+
+
+template<typename T>
+uint32_t xmrig::NetworkState::median(const std::vector<T> &values)
+{
+    const size_t calls = values.size();
     if (calls == 0) {
         return 0;
     }
 
-    auto v = m_latency;
+    auto v = values;
     std::nth_element(v.begin(), v.begin() + calls / 2, v.end());
 
     return v[calls / 2];
@@ -177,11 +250,15 @@ uint64_t xmrig::NetworkState::connectionTime() const
 
 void xmrig::NetworkState::add(const SubmitResult &result, const char *error)
 {
+    m_shares[result.Source ? result.Source : ""][error ? 1 : 0]++;
+
     if (error) {
         m_rejected++;
         return;
     }
 
+    m_resultHistogram.add(result.elapsed);
+
     m_accepted++;
     m_hashes += result.diff;
 
@@ -195,6 +272,26 @@ void xmrig::NetworkState::add(const SubmitResult &result, const char *error)
 }
 
 
+// Time in microseconds from the moment a share was found by a worker to the moment it was handed to the pool client.
+void xmrig::NetworkState::addSubmitLatency(uint64_t elapsed)
+{
+    m_submitHistogram.add(elapsed);
+    m_submitLatency.push_back(elapsed > 0xFFFFFFFF ? 0xFFFFFFFF : static_cast<uint32_t>(elapsed));
+}
+
+
+void xmrig::NetworkState::Histogram::add(uint64_t value)
+{
+    size_t i = 0;
+    while (i < kBounds && static_cast<double>(value) > bounds[i]) {
+        ++i;
+    }
+
+    buckets[i]++;
+    sum += static_cast<double>(value);
+}
+
+
 void xmrig::NetworkState::stop()
 {
     m_active      = false;
@@ -205,4 +302,5 @@ void xmrig::NetworkState::stop()
 
     m_failures++;
     m_latency.clear();
+    m_submitLatency.clear();
 }
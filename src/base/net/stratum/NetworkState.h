@@ -32,12 +32,17 @@
 
 
 #include <array>
+#include <map>
+#include <string>
 #include <vector>
 
 
 namespace xmrig {
 
 
+class Metrics;
+
+
 class NetworkState : public StrategyProxy
 {
 public:
@@ -47,10 +52,12 @@ public:
     inline uint64_t accepted() const            { return m_accepted; }
     inline uint64_t rejected() const            { return m_rejected; }
 	void add(const SubmitResult &result, const char *error);
+    void addSubmitLatency(uint64_t elapsed);
 
 #   ifdef XMRIG_FEATURE_API
     rapidjson::Value getConnection(rapidjson::Document &doc, int version) const;
     rapidjson::Value getResults(rapidjson::Document &doc, int version) const;
+    void getMetrics(Metrics &metrics) const;
 #   endif
 
 protected:
@@ -60,8 +67,25 @@ protected:
     void onResultAccepted(IStrategy *strategy, IClient *client, const SubmitResult &result, const char *error) override;
 
 private:
+    class Histogram
+    {
+    public:
+        static constexpr size_t kBounds = 12;
+        static const double msBounds[kBounds];
+        static const double usBounds[kBounds];
+
+        inline Histogram(const double *bounds) : bounds(bounds) {}
+
+        void add(uint64_t value);
+
+        const double *bounds;
+        std::array<uint64_t, kBounds + 1> buckets { { } };
+        double sum = 0.0;
+    };
+
     uint32_t avgTime() const;
     uint32_t latency() const;
+    template<typename T> static uint32_t median(const std::vector<T> &values);
     uint64_t connectionTime() const;
     void stop();
 
@@ -69,7 +93,11 @@ private:
     bool m_active               = false;
     char m_pool[256]{};
     std::array<uint64_t, 10> topDiff { { } };
+    std::map<std::string, std::array<uint64_t, 2> > m_shares;
+    Histogram m_resultHistogram { Histogram::msBounds };
+    Histogram m_submitHistogram { Histogram::usBounds };
     std::vector<uint16_t> m_latency;
+    std::vector<uint32_t> m_submitLatency;
     String m_fingerprint;
     String m_ip;
     String m_tls;
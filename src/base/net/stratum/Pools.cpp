@@ -23,10 +23,14 @@
  */
 
 
+#include <cstring>
+
+
 #include "base/net/stratum/Pools.h"
 #include "base/io/log/Log.h"
 #include "base/kernel/interfaces/IJsonReader.h"
 #include "base/net/stratum/strategies/FailoverStrategy.h"
+#include "base/net/stratum/strategies/FastestStrategy.h"
 #include "base/net/stratum/strategies/SinglePoolStrategy.h"
 #include "donate.h"
 #include "rapidjson/document.h"
@@ -38,6 +42,7 @@ namespace xmrig {
 const char *Pools::kDonateLevel     = "donate-level";
 const char *Pools::kDonateOverProxy = "donate-over-proxy";
 const char *Pools::kPools           = "pools";
+const char *Pools::kPoolStrategy    = "pool-strategy";
 const char *Pools::kRetries         = "retries";
 const char *Pools::kRetryPause      = "retry-pause";
 
@@ -57,7 +62,7 @@ xmrig::Pools::Pools() :
 
 bool xmrig::Pools::isEqual(const Pools &other) const
 {
-    if (m_data.size() != other.m_data.size() || m_retries != other.m_retries || m_retryPause != other.m_retryPause) {
+    if (m_data.size() != other.m_data.size() || m_retries != other.m_retries || m_retryPause != other.m_retryPause || m_fastest != other.m_fastest) {
         return false;
     }
 
@@ -70,6 +75,29 @@ xmrig::IStrategy *xmrig::Pools::createStrategy(IStrategyListener *listener, bool
     
     if (fBBP)
     {
+        // Only stratum pools can be raced, the strategy needs at least two of them or it would have no client.
+        size_t stratum = 0;
+        for (const Pool &pool : m_data) {
+            if (pool.isEnabled() && pool.mode() == Pool::MODE_POOL) {
+                stratum++;
+            }
+        }
+
+        if (m_fastest && stratum > 1) {
+            auto strategy = new FastestStrategy(retryPause(), retries(), listener);
+            for (Pool bbp_pool : m_data) {
+                if (bbp_pool.isEnabled()) {
+                    bbp_pool.setCoinType(String("BBP"));
+
+                    if (!strategy->add(bbp_pool)) {
+                        LOG_WARN("[%s] " YELLOW("not a stratum pool, skipped by the \"fastest\" strategy"), bbp_pool.url().data());
+                    }
+                }
+            }
+
+            return strategy;
+        }
+
         for (Pool bbp_pool : m_data) {
             if (bbp_pool.isEnabled()) 
             {
@@ -157,6 +185,7 @@ void xmrig::Pools::load(const IJsonReader &reader)
     setProxyDonate(reader.getInt(kDonateOverProxy, PROXY_DONATE_AUTO));
     setRetries(reader.getInt(kRetries));
     setRetryPause(reader.getInt(kRetryPause));
+    setPoolStrategy(reader.getString(kPoolStrategy));
 }
 
 
@@ -187,6 +216,12 @@ void xmrig::Pools::setDonateLevel(int level)
 }
 
 
+void xmrig::Pools::setPoolStrategy(const char *strategy)
+{
+    m_fastest = strategy && strcmp(strategy, "fastest") == 0;
+}
+
+
 void xmrig::Pools::setProxyDonate(int value)
 {
     switch (value) {
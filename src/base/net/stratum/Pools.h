@@ -47,6 +47,7 @@ public:
     static const char *kDonateLevel;
     static const char *kDonateOverProxy;
     static const char *kPools;
+    static const char *kPoolStrategy;
     static const char *kRetries;
     static const char *kRetryPause;
 
@@ -59,6 +60,7 @@ public:
     Pools();
 
     inline const std::vector<Pool> &data() const        { return m_data; }
+    inline bool isFastest() const                       { return m_fastest; }
     inline int donateLevel() const                      { return m_donateLevel; }
     inline int retries() const                          { return m_retries; }
     inline int retryPause() const                       { return m_retryPause; }
@@ -76,10 +78,12 @@ public:
 
 private:
     void setDonateLevel(int level);
+    void setPoolStrategy(const char *strategy);
     void setProxyDonate(int value);
     void setRetries(int retries);
     void setRetryPause(int retryPause);
 
+    bool m_fastest              = false;
     int m_donateLevel;
     int m_retries               = 5;
     int m_retryPause            = 5;
@@ -132,6 +132,7 @@ bool xmrig::SelfSelectClient::parseResponse(int64_t id, rapidjson::Value &result
 
     m_job.setHeight(Json::getUint64(result, kHeight));
     m_job.setSeedHash(Json::getString(result, kSeedHash));
+    m_job.setNextSeedHash(Json::getString(result, kNextSeedHash));
 
     submitBlockTemplate(result);
 
@@ -27,7 +27,9 @@
 #include "base/net/stratum/Tls.h"
 #include "base/io/log/Log.h"
 #include "base/net/stratum/Client.h"
+#include "base/net/stratum/TlsSessions.h"
 #include "base/tools/Buffer.h"
+#include "base/tools/Chrono.h"
 
 
 #ifdef _MSC_VER
@@ -42,7 +44,10 @@
 xmrig::Client::Tls::Tls(Client *client) :
     m_client(client)
 {
-    m_ctx = SSL_CTX_new(SSLv23_method());
+    char pool[256]{};
+    snprintf(pool, sizeof(pool) - 1, "%s:%d", client->m_pool.host().data(), client->m_pool.port());
+
+    m_ctx = TlsSessions::ctx(pool);
     assert(m_ctx != nullptr);
 
     if (!m_ctx) {
@@ -51,16 +56,11 @@ xmrig::Client::Tls::Tls(Client *client) :
 
     m_write = BIO_new(BIO_s_mem());
     m_read  = BIO_new(BIO_s_mem());
-    SSL_CTX_set_options(m_ctx, SSL_OP_NO_SSLv2 | SSL_OP_NO_SSLv3);
 }
 
 
 xmrig::Client::Tls::~Tls()
 {
-    if (m_ctx) {
-        SSL_CTX_free(m_ctx);
-    }
-
     if (m_ssl) {
         SSL_free(m_ssl);
     }
@@ -76,8 +76,12 @@ bool xmrig::Client::Tls::handshake()
         return false;
     }
 
+    TlsSessions::resume(m_ssl);
+
     SSL_set_connect_state(m_ssl);
     SSL_set_bio(m_ssl, m_read, m_write);
+
+    m_start = Chrono::steadyMSecs();
     SSL_do_handshake(m_ssl);
 
     return send();
@@ -123,6 +127,8 @@ void xmrig::Client::Tls::read(const char *data, size_t size)
             }
 
             X509_free(cert);
+            TlsSessions::add(m_ssl, Chrono::steadyMSecs() - m_start);
+
             m_ready = true;
             m_client->login();
       }
@@ -58,13 +58,14 @@ private:
     bool verify(X509 *cert);
     bool verifyFingerprint(X509 *cert);
 
-    BIO *m_read     = nullptr;
-    BIO *m_write    = nullptr;
-    bool m_ready    = false;
+    BIO *m_read         = nullptr;
+    BIO *m_write        = nullptr;
+    bool m_ready        = false;
     char m_fingerprint[32 * 2 + 8]{};
     Client *m_client;
-    SSL *m_ssl      = nullptr;
+    SSL *m_ssl          = nullptr;
     SSL_CTX *m_ctx;
+    uint64_t m_start    = 0;
 };
 
 
@@ -0,0 +1,141 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <map>
+#include <openssl/ssl.h>
+#include <string>
+
+
+#include "base/net/stratum/TlsSessions.h"
+#include "base/tools/Object.h"
+
+
+namespace xmrig {
+
+
+class TlsSession
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(TlsSession)
+
+    TlsSession()
+    {
+        ctx = SSL_CTX_new(SSLv23_method());
+        if (!ctx) {
+            return;
+        }
+
+        SSL_CTX_set_options(ctx, SSL_OP_NO_SSLv2 | SSL_OP_NO_SSLv3);
+        SSL_CTX_set_app_data(ctx, this);
+
+        // Sessions are kept here rather than in the OpenSSL cache, TLS 1.3 tickets only arrive after the handshake.
+        SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        SSL_CTX_sess_set_new_cb(ctx, onNewSession);
+    }
+
+    ~TlsSession()
+    {
+        SSL_SESSION_free(session);
+        SSL_CTX_free(ctx);
+    }
+
+    static int onNewSession(SSL *ssl, SSL_SESSION *session)
+    {
+        auto self = static_cast<TlsSession *>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
+
+        SSL_SESSION_free(self->session);
+
+#       if OPENSSL_VERSION_NUMBER >= 0x10101000L
+        // A copy, OpenSSL marks the connection's own session not resumable when the pool drops it without close_notify.
+        self->session = SSL_SESSION_dup(session);
+
+        return 0;
+#       else
+        self->session = session;
+
+        return 1;
+#       endif
+    }
+
+    SSL_CTX *ctx            = nullptr;
+    SSL_SESSION *session    = nullptr;
+    TlsSessions::Stats stats;
+};
+
+
+// Created on first use, after OpenSSL is initialized, so it is also destroyed before the OpenSSL cleanup runs.
+static std::map<std::string, TlsSession> &sessions()
+{
+    static std::map<std::string, TlsSession> map;
+
+    return map;
+}
+
+
+static inline TlsSession *session(SSL *ssl)
+{
+    return static_cast<TlsSession *>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
+}
+
+
+} // namespace xmrig
+
+
+const xmrig::TlsSessions::Stats *xmrig::TlsSessions::stats(const char *pool)
+{
+    const auto &map = sessions();
+    const auto it   = map.find(pool);
+
+    return it != map.end() && it->second.stats.handshakes ? &it->second.stats : nullptr;
+}
+
+
+SSL_CTX *xmrig::TlsSessions::ctx(const char *pool)
+{
+    return sessions()[pool].ctx;
+}
+
+
+void xmrig::TlsSessions::add(SSL *ssl, uint64_t elapsed)
+{
+    auto &stats = session(ssl)->stats;
+
+    stats.handshakes++;
+    stats.time   = elapsed;
+    stats.total += elapsed;
+
+    if (SSL_session_reused(ssl)) {
+        stats.resumed++;
+    }
+}
+
+
+void xmrig::TlsSessions::resume(SSL *ssl)
+{
+    auto self = session(ssl);
+
+    if (self->session) {
+        SSL_set_session(ssl, self->session);
+    }
+}
@@ -0,0 +1,62 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_TLSSESSIONS_H
+#define XMRIG_TLSSESSIONS_H
+
+
+#include <cstdint>
+
+
+using SSL           = struct ssl_st;
+using SSL_CTX       = struct ssl_ctx_st;
+
+
+namespace xmrig {
+
+
+// Process-wide client TLS state, one SSL_CTX per pool "host:port" shared by every connection to that pool.
+// The last session ticket received from a pool is kept, so reconnects can resume instead of doing a full handshake.
+class TlsSessions
+{
+public:
+    struct Stats
+    {
+        uint64_t handshakes = 0;
+        uint64_t resumed    = 0;
+        uint64_t time       = 0;
+        uint64_t total      = 0;
+    };
+
+    static const Stats *stats(const char *pool);
+    static SSL_CTX *ctx(const char *pool);
+    static void add(SSL *ssl, uint64_t elapsed);
+    static void resume(SSL *ssl);
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_TLSSESSIONS_H */
@@ -193,6 +193,14 @@ void xmrig::FailoverStrategy::onLoginSuccess(IClient *client)
 }
 
 
+void xmrig::FailoverStrategy::onNotification(IClient *client, const char *method, const rapidjson::Value &params)
+{
+    if (m_active == client->id()) {
+        m_listener->onNotification(this, client, method, params);
+    }
+}
+
+
 void xmrig::FailoverStrategy::onResultAccepted(IClient *client, const SubmitResult &result, const char *error)
 {
     m_listener->onResultAccepted(this, client, result, error);
@@ -0,0 +1,431 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+
+#include "base/net/stratum/strategies/FastestStrategy.h"
+#include "base/io/log/Log.h"
+#include "base/kernel/interfaces/IClient.h"
+#include "base/kernel/interfaces/IStrategyListener.h"
+#include "base/net/stratum/SubmitResult.h"
+#include "base/net/tools/TcpProbe.h"
+#include "base/tools/Chrono.h"
+
+
+namespace xmrig {
+
+
+// Weight of a new sample in the rolling averages.
+static constexpr double kAlpha = 0.3;
+
+
+static inline void addSample(double &value, double sample)
+{
+    value = value < 0.0 ? sample : value + (sample - value) * kAlpha;
+}
+
+
+} // namespace xmrig
+
+
+xmrig::FastestStrategy::FastestStrategy(int retryPause, int retries, IStrategyListener *listener, bool quiet) :
+    m_quiet(quiet),
+    m_retries(retries),
+    m_retryPause(retryPause),
+    m_listener(listener)
+{
+}
+
+
+xmrig::FastestStrategy::~FastestStrategy()
+{
+    for (auto &candidate : m_pools) {
+        delete candidate.probe;
+    }
+
+    if (m_client) {
+        m_client->deleteLater();
+    }
+}
+
+
+bool xmrig::FastestStrategy::add(const Pool &pool)
+{
+    if (pool.mode() != Pool::MODE_POOL) {
+        return false;
+    }
+
+    if (!m_client) {
+        m_client = pool.createClient(0, this);
+        m_client->setRetries(m_retries);
+        m_client->setRetryPause(m_retryPause * 1000);
+        m_client->setQuiet(m_quiet);
+    }
+
+    Candidate candidate;
+    candidate.pool  = pool;
+
+    // Behind a SOCKS5 proxy the only handshake this host can time is the one with the proxy.
+    if (m_pools.size() < kMaxProbed) {
+        const bool proxy = pool.proxy().isValid();
+        candidate.probe = new TcpProbe(m_pools.size(), proxy ? pool.proxy().host() : pool.host(), proxy ? pool.proxy().port() : pool.port(), this);
+    }
+
+    m_pools.push_back(std::move(candidate));
+
+    return true;
+}
+
+
+int64_t xmrig::FastestStrategy::submit(const JobResult &result)
+{
+    return m_client->submit(result);
+}
+
+
+void xmrig::FastestStrategy::connect()
+{
+    m_stopped   = false;
+    m_racing    = true;
+    m_raceStart = Chrono::steadyMSecs();
+    m_probeAt   = m_raceStart + kProbeInterval;
+
+    probe();
+}
+
+
+void xmrig::FastestStrategy::resume()
+{
+    if (!isActive()) {
+        return;
+    }
+
+    m_listener->onJob(this, m_client, m_client->job());
+}
+
+
+void xmrig::FastestStrategy::setAlgo(const Algorithm &algo)
+{
+    m_client->setAlgo(algo);
+}
+
+
+void xmrig::FastestStrategy::setProxy(const ProxyUrl &proxy)
+{
+    m_client->setProxy(proxy);
+}
+
+
+void xmrig::FastestStrategy::stop()
+{
+    m_stopped     = true;
+    m_racing      = false;
+    m_switching   = false;
+    m_reconnectAt = 0;
+    m_active      = false;
+    m_alive       = false;
+
+    m_client->disconnect();
+
+    m_listener->onPause(this);
+}
+
+
+void xmrig::FastestStrategy::tick(uint64_t now)
+{
+    m_client->tick(now);
+
+    for (auto &candidate : m_pools) {
+        if (candidate.probe) {
+            candidate.probe->tick(now);
+        }
+    }
+
+    if (m_stopped) {
+        return;
+    }
+
+    if (m_racing && (now - m_raceStart) >= kRaceTimeout) {
+        m_racing = false;
+        use(best(m_pools.size()));
+    }
+
+    if (m_reconnectAt && now >= m_reconnectAt) {
+        m_reconnectAt = 0;
+        m_client->connect(m_pools[m_index].pool);
+    }
+
+    if (!m_racing && now >= m_probeAt) {
+        m_probeAt = now + kProbeInterval;
+        probe();
+    }
+}
+
+
+void xmrig::FastestStrategy::onClose(IClient *, int failures)
+{
+    if (m_stopped) {
+        return;
+    }
+
+    if (failures == -1 && m_switching) {
+        m_switching = false;
+
+        return m_client->connect(m_pools[m_index].pool);
+    }
+
+    if (m_active) {
+        m_active = false;
+        m_listener->onPause(this);
+    }
+
+    m_alive = false;
+
+    // Retries are scheduled here instead of by the client, so the next attempt can go to another pool.
+    m_client->disconnect();
+
+    auto &current = m_pools[m_index];
+    if (++current.failures >= m_retries) {
+        current.failures  = 0;
+        current.reachable = false;
+
+        const size_t next = best(m_index);
+        if (next < m_pools.size()) {
+            m_index = next;
+        }
+    }
+
+    m_reconnectAt = Chrono::steadyMSecs() + static_cast<uint64_t>(m_retryPause) * 1000;
+}
+
+
+void xmrig::FastestStrategy::onJobReceived(IClient *client, const Job &job, const rapidjson::Value &)
+{
+    m_listener->onJob(this, client, job);
+}
+
+
+void xmrig::FastestStrategy::onLogin(IClient *client, rapidjson::Document &doc, rapidjson::Value &params)
+{
+    m_listener->onLogin(this, client, doc, params);
+}
+
+
+void xmrig::FastestStrategy::onLoginSuccess(IClient *client)
+{
+    setAlive();
+
+    m_active = true;
+    m_listener->onActive(this, client);
+}
+
+
+void xmrig::FastestStrategy::onNotification(IClient *client, const char *method, const rapidjson::Value &params)
+{
+    // BBP pools have no login response, the first job notification is what tells the connection works.
+    if (!m_alive && strcmp(method, "mining.notify") == 0) {
+        setAlive();
+    }
+
+    m_listener->onNotification(this, client, method, params);
+}
+
+
+void xmrig::FastestStrategy::onResultAccepted(IClient *client, const SubmitResult &result, const char *error)
+{
+    auto &current = m_pools[m_index];
+    if (result.elapsed && current.rtt >= 0.0) {
+        addSample(current.delay, std::max(static_cast<double>(result.elapsed) - current.rtt, 0.0));
+    }
+
+    m_listener->onResultAccepted(this, client, result, error);
+}
+
+
+void xmrig::FastestStrategy::onVerifyAlgorithm(const IClient *client, const Algorithm &algorithm, bool *ok)
+{
+    m_listener->onVerifyAlgorithm(this, client, algorithm, ok);
+}
+
+
+void xmrig::FastestStrategy::onProbe(const TcpProbe &probe, int status, uint64_t elapsed)
+{
+    auto &candidate = m_pools[probe.id()];
+
+    candidate.reachable = status == 0;
+    if (status == 0) {
+        addSample(candidate.rtt, static_cast<double>(elapsed) / 1000.0);
+    }
+
+    if (m_stopped) {
+        return;
+    }
+
+    if (m_racing) {
+        if (status == 0) {
+            m_racing = false;
+
+            if (!m_quiet) {
+                LOG_INFO("[%s:%u] " GREEN_BOLD("won the connect race") " in " WHITE_BOLD("%.1f ms") BLACK_BOLD(" (%zu pools)"),
+                         candidate.pool.host().data(), candidate.pool.port(), candidate.rtt, m_pools.size());
+            }
+
+            use(probe.id());
+        }
+        else if (!isProbing()) {
+            m_racing = false;
+            use(0);
+        }
+
+        return;
+    }
+
+    if (!isProbing()) {
+        evaluate();
+    }
+}
+
+
+bool xmrig::FastestStrategy::isProbing() const
+{
+    for (const auto &candidate : m_pools) {
+        if (candidate.probe && candidate.probe->isPending()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+// Handshake time now, plus the time the pool took on top of it to answer shares while it was in use. The share delay
+// only counts when both pools have one, a pool never used would otherwise always look faster than the active one.
+double xmrig::FastestStrategy::score(const Candidate &candidate, const Candidate &other) const
+{
+    return candidate.delay >= 0.0 && other.delay >= 0.0 ? candidate.rtt + candidate.delay : candidate.rtt;
+}
+
+
+size_t xmrig::FastestStrategy::best(size_t exclude) const
+{
+    size_t index = m_pools.size();
+
+    for (size_t i = 0; i < m_pools.size(); ++i) {
+        const auto &candidate = m_pools[i];
+        if (i == exclude || !candidate.reachable || candidate.rtt < 0.0) {
+            continue;
+        }
+
+        if (index == m_pools.size() || score(candidate, m_pools[index]) < score(m_pools[index], candidate)) {
+            index = i;
+        }
+    }
+
+    // Nothing answered a probe, fall back to the configuration order, this is also how failover-only pools are reached.
+    if (index == m_pools.size() && exclude >= m_pools.size()) {
+        return 0;
+    }
+
+    if (index == m_pools.size() && m_pools.size() > 1) {
+        return (exclude + 1) % m_pools.size();
+    }
+
+    return index;
+}
+
+
+void xmrig::FastestStrategy::setAlive()
+{
+    auto &current = m_pools[m_index];
+
+    current.failures  = 0;
+    current.reachable = true;
+    m_alive           = true;
+}
+
+
+void xmrig::FastestStrategy::evaluate()
+{
+    const auto &current = m_pools[m_index];
+    const size_t index  = best(m_index);
+
+    if (!m_alive || index >= m_pools.size() || index == m_index) {
+        return;
+    }
+
+    // A rival has to be clearly faster, and stay so for several rounds, before a working connection is dropped.
+    const auto &rival   = m_pools[index];
+    const double active = score(current, rival);
+    const double other  = score(rival, current);
+
+    if (current.rtt < 0.0 || (active > other * 1.25 && (active - other) > 5.0)) {
+        ++m_slower;
+    }
+    else {
+        m_slower = 0;
+    }
+
+    if (m_slower < kSwitchRounds) {
+        return;
+    }
+
+    if (!m_quiet) {
+        LOG_INFO("[%s:%u] " YELLOW("rtt %.1f ms, delay %.1f ms") ", switch to " CYAN_BOLD("%s:%u") YELLOW(" rtt %.1f ms, delay %.1f ms"),
+                 current.pool.host().data(), current.pool.port(), current.rtt, std::max(current.delay, 0.0), rival.pool.host().data(), rival.pool.port(), rival.rtt, std::max(rival.delay, 0.0));
+    }
+
+    use(index);
+}
+
+
+void xmrig::FastestStrategy::probe()
+{
+    for (auto &candidate : m_pools) {
+        if (candidate.probe) {
+            candidate.probe->start();
+        }
+    }
+}
+
+
+void xmrig::FastestStrategy::use(size_t index)
+{
+    m_index       = index;
+    m_slower      = 0;
+    m_reconnectAt = 0;
+    m_alive       = false;
+
+    if (m_active) {
+        m_active = false;
+        m_listener->onPause(this);
+    }
+
+    // A live connection is closed first, onClose() then connects to the new pool.
+    m_switching = m_client->disconnect();
+    if (!m_switching) {
+        m_client->connect(m_pools[m_index].pool);
+    }
+}
@@ -0,0 +1,127 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_FASTESTSTRATEGY_H
+#define XMRIG_FASTESTSTRATEGY_H
+
+
+#include <vector>
+
+
+#include "base/kernel/interfaces/IClientListener.h"
+#include "base/kernel/interfaces/IStrategy.h"
+#include "base/kernel/interfaces/ITcpProbeListener.h"
+#include "base/net/stratum/Pool.h"
+#include "base/tools/Object.h"
+
+
+namespace xmrig {
+
+
+class IStrategyListener;
+class TcpProbe;
+
+
+// Keeps a single pool connection like SinglePoolStrategy, but picks the pool by racing TCP handshakes to every candidate
+// and moves to another one when the active pool keeps losing the periodic probes. Only the first kMaxProbed pools are
+// raced, the rest are failover-only. Switching is break-before-make, BBP clients share global job state so two of them
+// must never be connected at the same time.
+class FastestStrategy : public IStrategy, public IClientListener, public ITcpProbeListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(FastestStrategy)
+
+    constexpr static size_t kMaxProbed          = 4;
+    constexpr static uint64_t kProbeInterval    = 60 * 1000;
+    constexpr static uint64_t kRaceTimeout      = 5 * 1000;
+    constexpr static int kSwitchRounds          = 3;
+
+    FastestStrategy(int retryPause, int retries, IStrategyListener *listener, bool quiet = false);
+    ~FastestStrategy() override;
+
+    bool add(const Pool &pool);
+
+protected:
+    inline bool isActive() const override           { return m_active; }
+    inline IClient *client() const override         { return m_client; }
+
+    int64_t submit(const JobResult &result) override;
+    void connect() override;
+    void resume() override;
+    void setAlgo(const Algorithm &algo) override;
+    void setProxy(const ProxyUrl &proxy) override;
+    void stop() override;
+    void tick(uint64_t now) override;
+
+    void onClose(IClient *client, int failures) override;
+    void onJobReceived(IClient *client, const Job &job, const rapidjson::Value &params) override;
+    void onLogin(IClient *client, rapidjson::Document &doc, rapidjson::Value &params) override;
+    void onLoginSuccess(IClient *client) override;
+    void onNotification(IClient *client, const char *method, const rapidjson::Value &params) override;
+    void onResultAccepted(IClient *client, const SubmitResult &result, const char *error) override;
+    void onVerifyAlgorithm(const IClient *client, const Algorithm &algorithm, bool *ok) override;
+
+    void onProbe(const TcpProbe &probe, int status, uint64_t elapsed) override;
+
+private:
+    struct Candidate
+    {
+        bool reachable      = true;
+        double delay        = -1.0;     // rolling share response time above the handshake time, milliseconds
+        double rtt          = -1.0;     // rolling TCP handshake time, milliseconds
+        int failures        = 0;
+        Pool pool;
+        TcpProbe *probe     = nullptr;
+    };
+
+    bool isProbing() const;
+    double score(const Candidate &candidate, const Candidate &other) const;
+    size_t best(size_t exclude) const;
+    void setAlive();
+    void evaluate();
+    void probe();
+    void use(size_t index);
+
+    bool m_active           = false;
+    bool m_alive            = false;
+    bool m_quiet;
+    bool m_racing           = false;
+    bool m_stopped          = true;
+    bool m_switching        = false;
+    const int m_retries;
+    const int m_retryPause;
+    IClient *m_client       = nullptr;
+    IStrategyListener *m_listener;
+    int m_slower            = 0;
+    size_t m_index          = 0;
+    std::vector<Candidate> m_pools;
+    uint64_t m_probeAt      = 0;
+    uint64_t m_raceStart    = 0;
+    uint64_t m_reconnectAt  = 0;
+};
+
+
+} /* namespace xmrig */
+
+#endif /* XMRIG_FASTESTSTRATEGY_H */
@@ -123,6 +123,12 @@ void xmrig::SinglePoolStrategy::onLoginSuccess(IClient *client)
 }
 
 
+void xmrig::SinglePoolStrategy::onNotification(IClient *client, const char *method, const rapidjson::Value &params)
+{
+    m_listener->onNotification(this, client, method, params);
+}
+
+
 void xmrig::SinglePoolStrategy::onResultAccepted(IClient *client, const SubmitResult &result, const char *error)
 {
     m_listener->onResultAccepted(this, client, result, error);
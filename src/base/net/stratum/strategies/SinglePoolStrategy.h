@@ -63,6 +63,7 @@ protected:
     void onJobReceived(IClient *client, const Job &job, const rapidjson::Value &params) override;
     void onLogin(IClient *client, rapidjson::Document &doc, rapidjson::Value &params) override;
     void onLoginSuccess(IClient *client) override;
+    void onNotification(IClient *client, const char *method, const rapidjson::Value &params) override;
     void onResultAccepted(IClient *client, const SubmitResult &result, const char *error) override;
     void onVerifyAlgorithm(const IClient *client, const Algorithm &algorithm, bool *ok) override;
 
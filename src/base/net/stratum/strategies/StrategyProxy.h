@@ -53,6 +53,11 @@ protected:
         m_listener->onLogin(strategy, client, doc, params);
     }
 
+    inline void onNotification(IStrategy *strategy, IClient *client, const char *method, const rapidjson::Value &params) override
+    {
+        m_listener->onNotification(strategy, client, method, params);
+    }
+
     inline void onPause(IStrategy *strategy) override
     {
         m_listener->onPause(strategy);
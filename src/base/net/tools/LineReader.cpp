@@ -38,17 +38,38 @@ void xmrig::LineReader::parse(char *data, size_t size)
         return;
     }
 
-    if (!m_buf) {
-        return getline(data, size);
+    if (m_buf || m_skip) {
+        auto end = static_cast<char *>(memchr(data, '\n', size));
+        if (!end) {
+            return add(data, size);
+        }
+
+        // Only the line split between reads is copied, everything after it is parsed in place.
+        const auto len = static_cast<size_t>(end - data) + 1;
+
+        add(data, len);
+        m_skip = false;
+
+        if (m_buf) {
+            getline(m_buf, m_pos);
+        }
+
+        data += len;
+        size -= len;
+
+        if (size == 0) {
+            return;
+        }
     }
 
-    add(data, size);
-    getline(m_buf, m_pos);
+    getline(data, size);
 }
 
 
 void xmrig::LineReader::reset()
 {
+    m_skip = false;
+
     if (m_buf) {
         NetBuffer::release(m_buf);
         m_buf = nullptr;
@@ -59,7 +80,15 @@ void xmrig::LineReader::reset()
 
 void xmrig::LineReader::add(const char *data, size_t size)
 {
+    if (m_skip) {
+        return;
+    }
+
+    // Longer than any valid message, dropped up to the next line break instead of being parsed truncated.
     if (size > NetBuffer::kChunkSize - m_pos) {
+        reset();
+        m_skip = true;
+
         return;
     }
 
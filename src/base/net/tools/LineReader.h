@@ -50,6 +50,7 @@ private:
     void add(const char *data, size_t size);
     void getline(char *data, size_t size);
 
+    bool m_skip                 = false;
     char *m_buf                 = nullptr;
     ILineListener *m_listener   = nullptr;
     size_t m_pos                = 0;
@@ -20,42 +20,55 @@
 #define XMRIG_MEMPOOL_H
 
 
-#include <map>
-#include <set>
-#include <array>
 #include <cassert>
+#include <cstdint>
+#include <vector>
+
+
+#include "base/tools/Object.h"
 
 
 namespace xmrig {
 
 
+// Fixed size chunks carved out of slabs of INIT_SIZE, free chunks are linked through their own first bytes.
+// Allocation and release are a pointer swap, no lookups and no node allocations. Network buffers only live on the
+// event loop thread, so there is no locking.
 template<size_t CHUNK_SIZE, size_t INIT_SIZE>
 class MemPool
 {
 public:
+    XMRIG_DISABLE_COPY_MOVE(MemPool)
+
     MemPool() = default;
 
+    inline ~MemPool()
+    {
+        for (char *slab : m_slabs) {
+            delete [] slab;
+        }
+    }
+
 
-    constexpr size_t chunkSize() const  { return CHUNK_SIZE; }
-    inline size_t freeSize() const      { return m_free.size() * CHUNK_SIZE; }
-    inline size_t size() const          { return m_data.size() * CHUNK_SIZE * INIT_SIZE; }
+    constexpr size_t chunkSize() const      { return CHUNK_SIZE; }
+    inline size_t freeSize() const          { return m_free * CHUNK_SIZE; }
+    inline size_t size() const              { return m_slabs.size() * CHUNK_SIZE * INIT_SIZE; }
+    inline uint64_t allocations() const     { return m_allocations; }
 
 
     inline char *allocate()
     {
-        if (m_free.empty()) {
+        if (!m_head) {
             resize();
         }
 
-        const size_t i = *m_free.begin();
-        const size_t r = i / INIT_SIZE;
-
-        char *ptr = m_data[r].data() + (i - r * INIT_SIZE) * CHUNK_SIZE;
+        Chunk *chunk = m_head;
+        m_head       = chunk->next;
 
-        m_used.insert({ ptr, i });
-        m_free.erase(i);
+        m_free--;
+        m_allocations++;
 
-        return ptr;
+        return reinterpret_cast<char *>(chunk);
     }
 
 
@@ -65,28 +78,52 @@ public:
             return;
         }
 
-        assert(m_used.count(ptr));
+        assert(owns(ptr));
 
-        m_free.emplace(m_used[ptr]);
-        m_used.erase(ptr);
+        auto chunk  = reinterpret_cast<Chunk *>(const_cast<char *>(ptr));
+        chunk->next = m_head;
+        m_head      = chunk;
+
+        m_free++;
     }
 
 
 private:
+    struct Chunk
+    {
+        Chunk *next;
+    };
+
+    static_assert(CHUNK_SIZE >= sizeof(Chunk) && CHUNK_SIZE % alignof(Chunk) == 0, "Chunk size is too small");
+
+
+    inline bool owns(const char *ptr) const
+    {
+        for (const char *slab : m_slabs) {
+            if (ptr >= slab && ptr < slab + CHUNK_SIZE * INIT_SIZE && (ptr - slab) % CHUNK_SIZE == 0) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+
     inline void resize()
     {
-        const size_t index = m_data.size();
-        m_data[index];
+        char *slab = new char[CHUNK_SIZE * INIT_SIZE];
+        m_slabs.push_back(slab);
 
-        for (size_t i = 0; i < INIT_SIZE; ++i) {
-            m_free.emplace((index * INIT_SIZE) + i);
+        for (size_t i = INIT_SIZE; i > 0; --i) {
+            deallocate(slab + (i - 1) * CHUNK_SIZE);
         }
     }
 
 
-    std::map<const char *, size_t> m_used;
-    std::map<size_t, std::array<char, CHUNK_SIZE * INIT_SIZE> > m_data;
-    std::set<size_t> m_free;
+    Chunk *m_head           = nullptr;
+    size_t m_free           = 0;
+    std::vector<char *> m_slabs;
+    uint64_t m_allocations  = 0;
 };
 
 
@@ -51,6 +51,12 @@ char *xmrig::NetBuffer::allocate()
 }
 
 
+uint64_t xmrig::NetBuffer::allocations()
+{
+    return pool ? pool->allocations() : 0;
+}
+
+
 void xmrig::NetBuffer::destroy()
 {
     if (!pool) {
@@ -25,6 +25,7 @@ using uv_handle_t = struct uv_handle_s;
 
 
 #include <cstddef>
+#include <cstdint>
 
 
 namespace xmrig {
@@ -36,6 +37,7 @@ public:
     static constexpr size_t kChunkSize = 16 * 1024;
 
     static char *allocate();
+    static uint64_t allocations();
     static void destroy();
     static void onAlloc(uv_handle_t *handle, size_t suggested_size, uv_buf_t *buf);
     static void release(const char *buf);
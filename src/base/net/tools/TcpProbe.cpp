@@ -0,0 +1,150 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "base/net/tools/TcpProbe.h"
+#include "base/kernel/interfaces/ITcpProbeListener.h"
+#include "base/net/dns/Dns.h"
+#include "base/tools/Chrono.h"
+#include "base/tools/Handle.h"
+
+
+namespace xmrig {
+
+
+Storage<TcpProbe> TcpProbe::m_storage;
+
+
+} // namespace xmrig
+
+
+xmrig::TcpProbe::TcpProbe(size_t id, const String &host, uint16_t port, ITcpProbeListener *listener) :
+    m_id(id),
+    m_host(host),
+    m_port(port),
+    m_listener(listener)
+{
+    m_key = m_storage.add(this);
+    m_dns = new Dns(this);
+}
+
+
+xmrig::TcpProbe::~TcpProbe()
+{
+    m_storage.release(m_key);
+
+    Handle::close(m_socket);
+
+    delete m_dns;
+}
+
+
+bool xmrig::TcpProbe::start()
+{
+    if (isPending() || m_resolving) {
+        return false;
+    }
+
+    m_start     = Chrono::steadyMSecs();
+    m_resolving = m_dns->resolve(m_host);
+
+    if (!m_resolving) {
+        finish(m_dns->status());
+
+        return false;
+    }
+
+    return true;
+}
+
+
+void xmrig::TcpProbe::tick(uint64_t now)
+{
+    if (!isPending() || (now - m_start) < kTimeout) {
+        return;
+    }
+
+    // Closing a connecting socket cancels the request, onConnect() then reports the failure.
+    if (m_socket) {
+        return Handle::close(m_socket);
+    }
+
+    finish(UV_ETIMEDOUT);
+}
+
+
+void xmrig::TcpProbe::onResolved(const Dns &dns, int status)
+{
+    m_resolving = false;
+
+    if (!isPending()) {
+        return;
+    }
+
+    if (status < 0 && dns.isEmpty()) {
+        return finish(status);
+    }
+
+    m_socket = new uv_tcp_t;
+    m_socket->data = m_storage.ptr(m_key);
+
+    uv_tcp_init(uv_default_loop(), m_socket);
+    uv_tcp_nodelay(m_socket, 1);
+
+    auto req  = new uv_connect_t;
+    req->data = m_storage.ptr(m_key);
+
+    sockaddr *addr = dns.get().addr(m_port);
+    m_connectStart = Chrono::steadyNSecs();
+
+    const int rc = uv_tcp_connect(req, m_socket, addr, onConnect);
+    delete addr;
+
+    if (rc != 0) {
+        delete req;
+        finish(rc);
+    }
+}
+
+
+void xmrig::TcpProbe::onConnect(uv_connect_t *req, int status)
+{
+    TcpProbe *probe = m_storage.get(req->data);
+    delete req;
+
+    if (probe) {
+        probe->finish(status);
+    }
+}
+
+
+void xmrig::TcpProbe::finish(int status)
+{
+    const uint64_t elapsed = status == 0 ? (Chrono::steadyNSecs() - m_connectStart) / 1000 : 0;
+
+    Handle::close(m_socket);
+    m_socket = nullptr;
+    m_start  = 0;
+
+    m_listener->onProbe(*this, status, elapsed);
+}
@@ -0,0 +1,89 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_TCPPROBE_H
+#define XMRIG_TCPPROBE_H
+
+
+#include <uv.h>
+
+
+#include "base/kernel/interfaces/IDnsListener.h"
+#include "base/net/tools/Storage.h"
+#include "base/tools/Object.h"
+#include "base/tools/String.h"
+
+
+namespace xmrig {
+
+
+class Dns;
+class ITcpProbeListener;
+
+
+// Measures how long a TCP handshake with a host takes, the connection is closed as soon as it is established.
+class TcpProbe : public IDnsListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(TcpProbe)
+
+    constexpr static uint64_t kTimeout = 5000;
+
+    TcpProbe(size_t id, const String &host, uint16_t port, ITcpProbeListener *listener);
+    ~TcpProbe() override;
+
+    inline bool isPending() const           { return m_start > 0; }
+    inline const String &host() const       { return m_host; }
+    inline size_t id() const                { return m_id; }
+
+    bool start();
+    void tick(uint64_t now);
+
+protected:
+    void onResolved(const Dns &dns, int status) override;
+
+private:
+    static void onConnect(uv_connect_t *req, int status);
+
+    void finish(int status);
+
+    bool m_resolving            = false;
+    const size_t m_id;
+    const String m_host;
+    const uint16_t m_port;
+    Dns *m_dns;
+    ITcpProbeListener *m_listener;
+    uint64_t m_connectStart     = 0;
+    uint64_t m_start            = 0;
+    uintptr_t m_key;
+    uv_tcp_t *m_socket          = nullptr;
+
+    static Storage<TcpProbe> m_storage;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_TCPPROBE_H */
@@ -0,0 +1,71 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_BARRIER_H
+#define XMRIG_BARRIER_H
+
+
+#include "base/tools/Object.h"
+
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+
+namespace xmrig {
+
+
+class Barrier
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(Barrier)
+
+    inline explicit Barrier(size_t count) : m_count(count) {}
+
+    // Blocks until count threads have called wait(), single use.
+    inline void wait()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        if (m_count == 0 || --m_count == 0) {
+            m_cv.notify_all();
+
+            return;
+        }
+
+        m_cv.wait(lock, [this] { return m_count == 0; });
+    }
+
+private:
+    size_t m_count;
+    std::condition_variable m_cv;
+    std::mutex m_mutex;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_BARRIER_H */
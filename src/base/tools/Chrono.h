@@ -54,6 +54,14 @@ public:
     }
 
 
+    static inline uint64_t steadyNSecs()
+    {
+        using namespace std::chrono;
+
+        return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+    }
+
+
     static inline uint64_t currentMSecsSinceEpoch()
     {
         using namespace std::chrono;
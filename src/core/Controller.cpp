@@ -54,7 +54,11 @@ int xmrig::Controller::init()
 	gbbp::initbbp();
     Base::init();
     VirtualMemory::init(config()->cpu().memPoolSize(), config()->cpu().isHugePages());
-    m_network = new Network(this);
+
+    if (!config()->isBenchmark()) {
+        m_network = new Network(this);
+    }
+
     return 0;
 }
 
@@ -65,7 +69,9 @@ void xmrig::Controller::start()
 
     m_miner = new Miner(this);
 
-    network()->connect();
+    if (!config()->isBenchmark()) {
+        network()->connect();
+    }
 }
 
 
@@ -24,6 +24,8 @@
 
 
 #include <algorithm>
+#include <cmath>
+#include <cstdio>
 #include <mutex>
 #include <thread>
 
@@ -49,6 +51,7 @@
 #ifdef XMRIG_FEATURE_API
 #   include "base/api/Api.h"
 #   include "base/api/interfaces/IApiRequest.h"
+#   include "base/api/Metrics.h"
 #endif
 
 
@@ -64,6 +67,7 @@
 
 #ifdef XMRIG_ALGO_RANDOMX
 #   include "crypto/rx/RxConfig.h"
+#   include "crypto/rx/RxProfiler.h"
 #endif
 
 
@@ -182,8 +186,10 @@ public:
         Value hashrate(kObjectType);
         Value total(kArrayType);
         Value threads(kArrayType);
+        Value counters(kArrayType);
 
         double t[3] = { 0.0 };
+        bool perf   = false;
 
         for (IBackend *backend : backends) {
             const Hashrate *hr = backend->hashrate();
@@ -195,6 +201,11 @@ public:
             t[1] += hr->calc(Hashrate::MediumInterval);
             t[2] += hr->calc(Hashrate::LargeInterval);
 
+            for (size_t i = 0; i < hr->threads(); i++) {
+                perf |= hr->counters(i).isValid();
+                counters.PushBack(hr->counters(i).toJSON(doc), allocator);
+            }
+
             if (version > 1) {
                 continue;
             }
@@ -220,10 +231,85 @@ public:
             hashrate.AddMember("threads", threads, allocator);
         }
 
+        if (perf) {
+            hashrate.AddMember("counters", counters, allocator);
+        }
+
         reply.AddMember("hashrate", hashrate, allocator);
     }
 
 
+#   ifdef XMRIG_FEATURE_API
+    void getMetrics(Metrics &metrics) const
+    {
+        static const char *intervals[]  = { "10s", "60s", "15m" };
+        static const size_t ms[]        = { Hashrate::ShortInterval, Hashrate::MediumInterval, Hashrate::LargeInterval };
+        constexpr size_t kMaxNodes      = 64;
+
+        char labels[128];
+        double total[3]             = { 0.0 };
+        double nodes[kMaxNodes][3]  = {};
+        size_t maxNode              = 0;
+        bool active                 = false;
+
+        metrics.family("xmrig_randomx_hashrate", Metrics::GAUGE, "Hashes per second computed by each worker thread, without the dual hashing multiplier");
+
+        for (IBackend *backend : backends) {
+            const Hashrate *hr = backend->hashrate();
+            if (!hr) {
+                continue;
+            }
+
+            active = true;
+
+            for (size_t i = 0; i < hr->threads(); i++) {
+                const size_t node = std::min<size_t>(hr->node(i), kMaxNodes - 1);
+                maxNode           = std::max(maxNode, node);
+
+                for (size_t j = 0; j < 3; ++j) {
+                    const double value = hr->rate(i, ms[j]);
+
+                    snprintf(labels, sizeof(labels), "backend=\"%s\",thread=\"%zu\",node=\"%zu\",interval=\"%s\"", backend->type().data(), i, node, intervals[j]);
+                    metrics.add("xmrig_randomx_hashrate", labels, value);
+
+                    if (std::isnormal(value)) {
+                        total[j]         += value;
+                        nodes[node][j]   += value;
+                    }
+                }
+            }
+        }
+
+        if (!active) {
+            return;
+        }
+
+        metrics.family("xmrig_node_hashrate", Metrics::GAUGE, "Hashes per second of all worker threads bound to a NUMA node");
+        for (size_t node = 0; node <= maxNode; ++node) {
+            for (size_t j = 0; j < 3; ++j) {
+                snprintf(labels, sizeof(labels), "node=\"%zu\",interval=\"%s\"", node, intervals[j]);
+                metrics.add("xmrig_node_hashrate", labels, nodes[node][j]);
+            }
+        }
+
+        metrics.family("xmrig_total_hashrate", Metrics::GAUGE, "Hashes per second of the whole miner by hashing stage");
+        for (size_t j = 0; j < 3; ++j) {
+            snprintf(labels, sizeof(labels), "stage=\"randomx\",interval=\"%s\"", intervals[j]);
+            metrics.add("xmrig_total_hashrate", labels, total[j]);
+
+            snprintf(labels, sizeof(labels), "stage=\"bbp\",interval=\"%s\"", intervals[j]);
+            metrics.add("xmrig_total_hashrate", labels, Hashrate::isDual() ? total[j] : 0.0);
+        }
+
+        metrics.family("xmrig_reported_hashrate", Metrics::GAUGE, "Hashrate as reported by the summary API, including the dual hashing multiplier");
+        for (size_t j = 0; j < 3; ++j) {
+            snprintf(labels, sizeof(labels), "interval=\"%s\"", intervals[j]);
+            metrics.add("xmrig_reported_hashrate", labels, total[j] * (Hashrate::isDual() ? 2 : 1));
+        }
+    }
+#   endif
+
+
     void getBackends(rapidjson::Value &reply, rapidjson::Document &doc) const
     {
         using namespace rapidjson;
@@ -365,6 +451,13 @@ void xmrig::Miner::execCommand(char command)
         }
         break;
 
+#   ifdef XMRIG_FEATURE_PROFILING
+    case 'f':
+    case 'F':
+        RxProfiler::print();
+        break;
+#   endif
+
     default:
         break;
     }
@@ -541,11 +634,21 @@ void xmrig::Miner::onRequest(IApiRequest &request)
             d_ptr->getMiner(request.reply(), request.doc(), request.version());
             d_ptr->getHashrate(request.reply(), request.doc(), request.version());
         }
+        else if (request.type() == IApiRequest::REQ_METRICS) {
+            d_ptr->getMetrics(*request.metrics());
+        }
         else if (request.url() == "/2/backends") {
             request.accept();
 
             d_ptr->getBackends(request.reply(), request.doc());
         }
+#       ifdef XMRIG_FEATURE_PROFILING
+        else if (request.url() == "/2/profile") {
+            request.accept();
+
+            request.reply() = RxProfiler::toJSON(request.doc());
+        }
+#       endif
     }
     else if (request.type() == IApiRequest::REQ_JSON_RPC) {
         if (request.rpcMethod() == "pause") {
@@ -28,6 +28,7 @@
 #include <cinttypes>
 
 
+#include "backend/common/benchmark/Benchmark.h"
 #include "backend/cpu/Cpu.h"
 #include "base/io/log/Log.h"
 #include "base/kernel/interfaces/IJsonReader.h"
@@ -53,20 +54,31 @@
 #endif
 
 
+#ifdef XMRIG_FEATURE_PROXY
+#   include "net/proxy/ProxyConfig.h"
+#endif
+
+
 namespace xmrig {
 
-static const char *kCPU     = "cpu";
+static const char *kBench      = "bench";
+static const char *kBenchMicro = "bench-micro";
+static const char *kCPU        = "cpu";
 
 #ifdef XMRIG_ALGO_RANDOMX
-static const char *kRandomX = "randomx";
+static const char *kRandomX    = "randomx";
 #endif
 
 #ifdef XMRIG_FEATURE_OPENCL
-static const char *kOcl     = "opencl";
+static const char *kOcl        = "opencl";
 #endif
 
 #ifdef XMRIG_FEATURE_CUDA
-static const char *kCuda    = "cuda";
+static const char *kCuda       = "cuda";
+#endif
+
+#ifdef XMRIG_FEATURE_PROXY
+static const char *kProxy      = "proxy";
 #endif
 
 
@@ -92,11 +104,28 @@ public:
     CudaConfig cuda;
 #   endif
 
+#   ifdef XMRIG_FEATURE_PROXY
+    ProxyConfig proxy;
+#   endif
+
 #   if defined(XMRIG_FEATURE_NVML) || defined (XMRIG_FEATURE_ADL)
     uint32_t healthPrintTime = 60;
 #   endif
+
+    bool benchMicro    = false;
+    uint32_t benchSize = 0;
 };
 
+
+static uint32_t benchSize(const rapidjson::Value &value)
+{
+    if (value.IsUint()) {
+        return value.GetUint();
+    }
+
+    return value.IsString() ? Benchmark::parseSize(value.GetString()) : 0;
+}
+
 }
 
 
@@ -142,6 +171,14 @@ const xmrig::RxConfig &xmrig::Config::rx() const
 #endif
 
 
+#ifdef XMRIG_FEATURE_PROXY
+const xmrig::ProxyConfig &xmrig::Config::proxy() const
+{
+    return d_ptr->proxy;
+}
+#endif
+
+
 #if defined(XMRIG_FEATURE_NVML) || defined (XMRIG_FEATURE_ADL)
 uint32_t xmrig::Config::healthPrintTime() const
 {
@@ -150,9 +187,21 @@ uint32_t xmrig::Config::healthPrintTime() const
 #endif
 
 
+bool xmrig::Config::isBenchMicro() const
+{
+    return d_ptr->benchMicro;
+}
+
+
+uint32_t xmrig::Config::benchSize() const
+{
+    return d_ptr->benchSize;
+}
+
+
 bool xmrig::Config::isShouldSave() const
 {
-    if (!isAutoSave()) {
+    if (!isAutoSave() || isBenchmark()) {
         return false;
     }
 
@@ -174,7 +223,13 @@ bool xmrig::Config::isShouldSave() const
 
 bool xmrig::Config::read(const IJsonReader &reader, const char *fileName)
 {
-    if (!BaseConfig::read(reader, fileName)) {
+    const bool ready = BaseConfig::read(reader, fileName);
+
+    d_ptr->benchSize  = xmrig::benchSize(reader.getValue(kBench));
+    d_ptr->benchMicro = reader.getBool(kBenchMicro);
+
+    // Benchmark mode hashes a synthetic job, so it does not need any pool.
+    if (!ready && !isBenchmark()) {
         return false;
     }
 
@@ -194,6 +249,10 @@ bool xmrig::Config::read(const IJsonReader &reader, const char *fileName)
     d_ptr->cuda.read(reader.getValue(kCuda));
 #   endif
 
+#   ifdef XMRIG_FEATURE_PROXY
+    d_ptr->proxy.load(reader.getValue(kProxy));
+#   endif
+
 #   if defined(XMRIG_FEATURE_NVML) || defined (XMRIG_FEATURE_ADL)
     d_ptr->healthPrintTime = reader.getUint(kHealthPrintTime, d_ptr->healthPrintTime);
 #   endif
@@ -238,7 +297,13 @@ void xmrig::Config::getJSON(rapidjson::Document &doc) const
     doc.AddMember(StringRef(Pools::kDonateOverProxy),   m_pools.proxyDonate(), allocator);
     doc.AddMember(StringRef(kLogFile),                  m_logFile.toJSON(), allocator);
     doc.AddMember(StringRef(Pools::kPools),             m_pools.toJSON(doc), allocator);
+    doc.AddMember(StringRef(Pools::kPoolStrategy),      StringRef(m_pools.isFastest() ? "fastest" : "failover"), allocator);
     doc.AddMember(StringRef(kPrintTime),                printTime(), allocator);
+
+#   ifdef XMRIG_FEATURE_PROXY
+    doc.AddMember(StringRef(kProxy),                    proxy().toJSON(doc), allocator);
+#   endif
+
 #   if defined(XMRIG_FEATURE_NVML) || defined (XMRIG_FEATURE_ADL)
     doc.AddMember(StringRef(kHealthPrintTime),          healthPrintTime(), allocator);
 #   endif
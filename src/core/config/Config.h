@@ -42,6 +42,7 @@ class ConfigPrivate;
 class CudaConfig;
 class IThread;
 class OclConfig;
+class ProxyConfig;
 class RxConfig;
 
 
@@ -67,13 +68,21 @@ public:
     const RxConfig &rx() const;
 #   endif
 
+#   ifdef XMRIG_FEATURE_PROXY
+    const ProxyConfig &proxy() const;
+#   endif
+
 #   if defined(XMRIG_FEATURE_NVML) || defined (XMRIG_FEATURE_ADL)
     uint32_t healthPrintTime() const;
 #   else
     uint32_t healthPrintTime() const { return 0; }
 #   endif
 
+    inline bool isBenchmark() const { return benchSize() > 0; }
+
+    bool isBenchMicro() const;
     bool isShouldSave() const;
+    uint32_t benchSize() const;
     bool read(const IJsonReader &reader, const char *fileName) override;
     void getJSON(rapidjson::Document &doc) const override;
 
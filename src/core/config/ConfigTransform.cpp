@@ -34,6 +34,8 @@ namespace xmrig
 
 static const char *kAffinity    = "affinity";
 static const char *kAsterisk    = "*";
+static const char *kBench       = "bench";
+static const char *kBenchMicro  = "bench-micro";
 static const char *kCpu         = "cpu";
 static const char *kEnabled     = "enabled";
 static const char *kIntensity   = "intensity";
@@ -51,6 +53,10 @@ static const char *kOcl         = "opencl";
 static const char *kCuda        = "cuda";
 #endif
 
+#ifdef XMRIG_FEATURE_PROXY
+static const char *kProxy       = "proxy";
+#endif
+
 
 static inline uint64_t intensity(uint64_t av)
 {
@@ -119,6 +125,12 @@ void xmrig::ConfigTransform::finalize(rapidjson::Document &doc)
         set(doc, kOcl, kEnabled, true);
     }
 #   endif
+
+#   ifdef XMRIG_FEATURE_PROXY
+    if (m_proxy) {
+        set(doc, kProxy, kEnabled, true);
+    }
+#   endif
 }
 
 
@@ -151,6 +163,22 @@ void xmrig::ConfigTransform::transform(rapidjson::Document &doc, int key, const
     case IConfig::YieldKey: /* --cpu-no-yield */
         return set(doc, kCpu, "yield", false);
 
+    case IConfig::BenchKey: /* --bench */
+        return set(doc, kBench, arg);
+
+    case IConfig::BenchMicroKey: /* --bench-micro */
+        return set(doc, kBenchMicro, true);
+
+#   ifdef XMRIG_FEATURE_PROXY
+    case IConfig::ProxyHostKey: /* --proxy-host */
+        m_proxy = true;
+        return set(doc, kProxy, "host", arg);
+
+    case IConfig::ProxyPortKey: /* --proxy-port */
+        m_proxy = true;
+        return set(doc, kProxy, "port", static_cast<uint64_t>(strtol(arg, nullptr, 10)));
+#   endif
+
 #   ifdef XMRIG_FEATURE_ASM
     case IConfig::AssemblyKey: /* --asm */
         return set(doc, kCpu, "asm", arg);
@@ -186,6 +214,9 @@ void xmrig::ConfigTransform::transform(rapidjson::Document &doc, int key, const
 
     case IConfig::RandomXRdmsrKey: /* --randomx-no-rdmsr */
         return set(doc, kRandomX, "rdmsr", false);
+
+    case IConfig::RandomXCacheDirKey: /* --randomx-cache-dir */
+        return set(doc, kRandomX, "cache-dir", arg);
 #   endif
 
 #   ifdef XMRIG_FEATURE_OPENCL
@@ -43,6 +43,7 @@ private:
     void transformUint64(rapidjson::Document &doc, int key, uint64_t arg);
 
     bool m_opencl           = false;
+    bool m_proxy            = false;
     int64_t m_affinity      = -1;
     uint64_t m_intensity    = 1;
     uint64_t m_threads      = 0;
@@ -51,7 +51,8 @@ R"===(
     "randomx": {
         "init": -1,
         "mode": "auto",
-        "numa": true
+        "numa": true,
+        "cache-dir": null
     },
     "cpu": {
         "enabled": true,
@@ -106,6 +107,7 @@ R"===(
     "health-print-time": 60,
     "retries": 5,
     "retry-pause": 5,
+    "pool-strategy": "failover",
     "syslog": false,
     "user-agent": null,
     "watch": true
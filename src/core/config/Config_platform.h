@@ -57,6 +57,10 @@ static const option options[] = {
     { "daemon",                0, nullptr, IConfig::DaemonKey             },
     { "daemon-poll-interval",  1, nullptr, IConfig::DaemonPollKey         },
     { "self-select",           1, nullptr, IConfig::SelfSelectKey         },
+#   endif
+#   ifdef XMRIG_FEATURE_PROXY
+    { "proxy-host",            1, nullptr, IConfig::ProxyHostKey          },
+    { "proxy-port",            1, nullptr, IConfig::ProxyPortKey          },
 #   endif
     { "av",                    1, nullptr, IConfig::AVKey                 },
     { "background",            0, nullptr, IConfig::BackgroundKey         },
@@ -66,12 +70,15 @@ static const option options[] = {
     { "donate-level",          1, nullptr, IConfig::DonateLevelKey        },
     { "donate-over-proxy",     1, nullptr, IConfig::ProxyDonateKey        },
     { "dry-run",               0, nullptr, IConfig::DryRunKey             },
+    { "bench",                 1, nullptr, IConfig::BenchKey              },
+    { "bench-micro",           0, nullptr, IConfig::BenchMicroKey         },
     { "keepalive",             0, nullptr, IConfig::KeepAliveKey          },
     { "log-file",              1, nullptr, IConfig::LogFileKey            },
     { "nicehash",              0, nullptr, IConfig::NicehashKey           },
     { "no-color",              0, nullptr, IConfig::ColorKey              },
     { "no-huge-pages",         0, nullptr, IConfig::HugePagesKey          },
     { "pass",                  1, nullptr, IConfig::PasswordKey           },
+    { "pool-strategy",         1, nullptr, IConfig::PoolStrategyKey       },
     { "print-time",            1, nullptr, IConfig::PrintTimeKey          },
     { "retries",               1, nullptr, IConfig::RetriesKey            },
     { "retry-pause",           1, nullptr, IConfig::RetryPauseKey         },
@@ -114,6 +121,7 @@ static const option options[] = {
     { "wrmsr",                 2, nullptr, IConfig::RandomXWrmsrKey       },
     { "randomx-no-rdmsr",      0, nullptr, IConfig::RandomXRdmsrKey       },
     { "no-rdmsr",              0, nullptr, IConfig::RandomXRdmsrKey       },
+    { "randomx-cache-dir",     1, nullptr, IConfig::RandomXCacheDirKey    },
 #   endif
     #ifdef XMRIG_ALGO_ASTROBWT
     { "astrobwt-max-size",     1, nullptr, IConfig::AstroBWTMaxSizeKey    },
@@ -68,6 +68,7 @@ static inline const std::string &usage()
 
     u += "  -r, --retries=N               number of times to retry before switch to backup server (default: 5)\n";
     u += "  -R, --retry-pause=N           time to pause between retries (default: 5)\n";
+    u += "      --pool-strategy=NAME      failover or fastest, connect to the pool with the lowest latency\n";
     u += "      --user-agent              set custom user-agent string for pool\n";
     u += "      --donate-level=N          donate level, default 5%% (5 minutes in 100 minutes)\n";
     u += "      --donate-over-proxy=N     control donate over xmrig-proxy feature\n";
@@ -92,6 +93,7 @@ static inline const std::string &usage()
     u += "      --randomx-1gb-pages       use 1GB hugepages for dataset (Linux only)\n";
     u += "      --randomx-wrmsr=N         write custom value (0-15) to Intel MSR register 0x1a4 or disable MSR mod (-1)\n";
     u += "      --randomx-no-rdmsr        disable reverting initial MSR values on exit\n";
+    u += "      --randomx-cache-dir=PATH  directory to keep initialized RandomX datasets between restarts\n";
 #   endif
 
 #   ifdef XMRIG_ALGO_ASTROBWT
@@ -109,6 +111,12 @@ static inline const std::string &usage()
     u += "      --http-no-restricted      enable full remote access to HTTP API (only if access token set)\n";
 #   endif
 
+#   ifdef XMRIG_FEATURE_PROXY
+    u += "\nStratum proxy:\n";
+    u += "      --proxy-host=HOST         bind host for downstream miners (default: 0.0.0.0)\n";
+    u += "      --proxy-port=N            accept downstream miners on port N and share the upstream pool connections\n";
+#   endif
+
 #   ifdef XMRIG_FEATURE_OPENCL
     u += "\nOpenCL backend:\n";
     u += "      --opencl                  enable OpenCL mining backend\n";
@@ -163,6 +171,8 @@ static inline const std::string &usage()
     u += "  -V, --version                 output version information and exit\n";
     u += "  -h, --help                    display this help and exit\n";
     u += "      --dry-run                 test configuration and exit\n";
+    u += "      --bench=N                 run offline RandomX/BBP benchmark for N hashes (example: 1M) and exit\n";
+    u += "      --bench-micro             also run the JIT, cache, interpreter and stratum micro benchmarks\n";
 
 #   ifdef XMRIG_FEATURE_HWLOC
     u += "      --export-topology         export hwloc topology to a XML file and exit\n";
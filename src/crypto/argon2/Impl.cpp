@@ -39,11 +39,16 @@ static String implName;
 } // namespace xmrig
 
 
-bool xmrig::argon2::Impl::select(const String &nameHint)
+bool xmrig::argon2::Impl::select(const String &nameHint, bool benchmark)
 {
     if (!selected) {
         if (nameHint.isEmpty() || argon2_select_impl_by_name(nameHint) == 0) {
-            argon2_select_impl();
+            if (benchmark) {
+                argon2_select_impl();
+            }
+            else {
+                argon2_select_impl_fast();
+            }
         }
 
         selected = true;
@@ -60,3 +65,9 @@ const xmrig::String &xmrig::argon2::Impl::name()
 {
     return implName;
 }
+
+
+void xmrig::argon2::Impl::fillSegment(void *memory, uint32_t blocks, uint32_t passes, uint32_t lanes, uint32_t pass, uint32_t lane, uint32_t slice)
+{
+    argon2_fill_segment(memory, blocks, passes, lanes, Argon2_d, pass, lane, slice);
+}
@@ -26,6 +26,9 @@
 #define XMRIG_ARGON2_IMPL_H
 
 
+#include <cstdint>
+
+
 namespace xmrig {
 
 
@@ -38,8 +41,9 @@ namespace argon2 {
 class Impl
 {
 public:
-    static bool select(const String &nameHint);
+    static bool select(const String &nameHint, bool benchmark = true);
     static const String &name();
+    static void fillSegment(void *memory, uint32_t blocks, uint32_t passes, uint32_t lanes, uint32_t pass, uint32_t lane, uint32_t slice);
 };
 
 
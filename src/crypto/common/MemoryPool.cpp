@@ -29,6 +29,7 @@
 #include "crypto/common/VirtualMemory.h"
 
 
+#include <algorithm>
 #include <cassert>
 
 
@@ -80,6 +81,21 @@ uint8_t *xmrig::MemoryPool::get(size_t size, uint32_t)
 }
 
 
+uint8_t *xmrig::MemoryPool::getAt(size_t offset, size_t size, uint32_t)
+{
+    assert(!(offset % pageSize) && !(size % pageSize));
+
+    if (!m_memory || offset > m_memory->size() || (m_memory->size() - offset) < size) {
+        return nullptr;
+    }
+
+    m_offset = std::max(m_offset, offset + size);
+    ++m_refs;
+
+    return m_memory->scratchpad() + offset;
+}
+
+
 void xmrig::MemoryPool::release(uint32_t)
 {
     assert(m_refs > 0);
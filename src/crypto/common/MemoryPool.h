@@ -49,6 +49,7 @@ public:
 protected:
     bool isHugePages(uint32_t node) const override;
     uint8_t *get(size_t size, uint32_t node) override;
+    uint8_t *getAt(size_t offset, size_t size, uint32_t node) override;
     void release(uint32_t node) override;
 
 private:
@@ -42,6 +42,16 @@ xmrig::NUMAMemoryPool::NUMAMemoryPool(size_t size, bool hugePages) :
 }
 
 
+xmrig::NUMAMemoryPool::NUMAMemoryPool(const std::map<uint32_t, size_t> &nodes, bool hugePages) :
+    m_hugePages(hugePages),
+    m_nodes(nodes)
+{
+    for (const auto &kv : m_nodes) {
+        m_size += kv.second;
+    }
+}
+
+
 xmrig::NUMAMemoryPool::~NUMAMemoryPool()
 {
     for (auto kv : m_map) {
@@ -70,6 +80,16 @@ uint8_t *xmrig::NUMAMemoryPool::get(size_t size, uint32_t node)
 }
 
 
+uint8_t *xmrig::NUMAMemoryPool::getAt(size_t offset, size_t size, uint32_t node)
+{
+    if (!m_size) {
+        return nullptr;
+    }
+
+    return getOrCreate(node)->getAt(offset, size, node);
+}
+
+
 void xmrig::NUMAMemoryPool::release(uint32_t node)
 {
     const auto pool = get(node);
@@ -89,7 +109,7 @@ xmrig::IMemoryPool *xmrig::NUMAMemoryPool::getOrCreate(uint32_t node) const
 {
     auto pool = get(node);
     if (!pool) {
-        pool = new MemoryPool(m_nodeSize, m_hugePages, node);
+        pool = new MemoryPool(m_nodes.count(node) ? m_nodes.at(node) : m_nodeSize, m_hugePages, node);
         m_map.insert({ node, pool });
     }
 
@@ -47,11 +47,13 @@ public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(NUMAMemoryPool)
 
     NUMAMemoryPool(size_t size, bool hugePages);
+    NUMAMemoryPool(const std::map<uint32_t, size_t> &nodes, bool hugePages);
     ~NUMAMemoryPool() override;
 
 protected:
     bool isHugePages(uint32_t node) const override;
     uint8_t *get(size_t size, uint32_t node) override;
+    uint8_t *getAt(size_t offset, size_t size, uint32_t node) override;
     void release(uint32_t node) override;
 
 private:
@@ -61,6 +63,7 @@ private:
     bool m_hugePages        = true;
     size_t m_nodeSize       = 0;
     size_t m_size           = 0;
+    std::map<uint32_t, size_t> m_nodes;
     mutable std::map<uint32_t, IMemoryPool *> m_map;
 };
 
@@ -24,8 +24,10 @@
 
 
 #include "crypto/common/Nonce.h"
+#include "base/tools/Chrono.h"
 
 
+#include <condition_variable>
 #include <mutex>
 
 
@@ -33,6 +35,7 @@ namespace xmrig {
 
 
 std::atomic<bool> Nonce::m_paused;
+std::atomic<uint64_t> Nonce::m_resumeLatency[Nonce::MAX];
 std::atomic<uint64_t> Nonce::m_sequence[Nonce::MAX];
 uint32_t Nonce::m_nonces[2] = { 0, 0 };
 
@@ -41,6 +44,14 @@ static std::mutex mutex;
 static Nonce nonce;
 
 
+// Event count for idle workers: notify() bumps the epoch, a waiter only sleeps if the epoch is still the one it saw
+// before checking its condition, so a notification between the check and the sleep is never lost.
+static std::condition_variable waitCv;
+static std::mutex waitMutex;
+static uint64_t waitEpoch   = 0;
+static uint64_t notifyTs    = 0;
+
+
 } // namespace xmrig
 
 
@@ -83,6 +94,32 @@ uint32_t xmrig::Nonce::next(uint8_t index, uint32_t nonce, uint32_t reserveCount
 }
 
 
+void xmrig::Nonce::notify()
+{
+    {
+        std::lock_guard<std::mutex> lock(waitMutex);
+
+        waitEpoch++;
+        notifyTs = Chrono::steadyNSecs();
+    }
+
+    waitCv.notify_all();
+}
+
+
+void xmrig::Nonce::pause(bool paused)
+{
+    if (paused) {
+        for (auto &i : m_resumeLatency) {
+            i = 0;
+        }
+    }
+
+    m_paused = paused;
+    notify();
+}
+
+
 void xmrig::Nonce::reset(uint8_t index)
 {
     std::lock_guard<std::mutex> lock(mutex);
@@ -93,11 +130,11 @@ void xmrig::Nonce::reset(uint8_t index)
 
 void xmrig::Nonce::stop()
 {
-    pause(false);
-
     for (auto &i : m_sequence) {
         i = 0;
     }
+
+    pause(false);
 }
 
 
@@ -106,4 +143,39 @@ void xmrig::Nonce::touch()
     for (auto &i : m_sequence) {
         i++;
     }
+
+    notify();
+}
+
+
+// Blocks the calling worker until ready() returns true, the time from the notification that released it to the
+// actual wake up is kept as the worst resume latency of the backend since the last pause.
+void xmrig::Nonce::wait(Backend backend, const std::function<bool()> &ready)
+{
+    uint64_t ts = 0;
+
+    while (true) {
+        std::unique_lock<std::mutex> lock(waitMutex);
+        const uint64_t epoch = waitEpoch;
+        lock.unlock();
+
+        if (ready()) {
+            break;
+        }
+
+        lock.lock();
+
+        // The timeout only guards against a state change that nobody notified about, such a wake up is not sampled.
+        // The timestamp is read under the same lock as the epoch change, so it belongs to the notification seen here.
+        ts = waitCv.wait_for(lock, std::chrono::seconds(1), [epoch] { return waitEpoch != epoch; }) ? notifyTs : 0;
+    }
+
+    if (ts == 0) {
+        return;
+    }
+
+    const uint64_t latency = (Chrono::steadyNSecs() - ts) / 1000;
+    uint64_t current       = m_resumeLatency[backend].load(std::memory_order_relaxed);
+
+    while (latency > current && !m_resumeLatency[backend].compare_exchange_weak(current, latency, std::memory_order_relaxed)) {}
 }
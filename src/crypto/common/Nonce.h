@@ -27,6 +27,7 @@
 
 
 #include <atomic>
+#include <functional>
 
 
 namespace xmrig {
@@ -47,18 +48,22 @@ public:
 
     static inline bool isOutdated(Backend backend, uint64_t sequence)   { return m_sequence[backend].load(std::memory_order_relaxed) != sequence; }
     static inline bool isPaused()                                       { return m_paused.load(std::memory_order_relaxed); }
+    static inline uint64_t resumeLatency(Backend backend)               { return m_resumeLatency[backend].load(std::memory_order_relaxed); }
     static inline uint64_t sequence(Backend backend)                    { return m_sequence[backend].load(std::memory_order_relaxed); }
-    static inline void pause(bool paused)                               { m_paused = paused; }
-    static inline void stop(Backend backend)                            { m_sequence[backend] = 0; }
-    static inline void touch(Backend backend)                           { m_sequence[backend]++; }
+    static inline void stop(Backend backend)                            { m_sequence[backend] = 0; notify(); }
+    static inline void touch(Backend backend)                           { m_sequence[backend]++; notify(); }
 
     static uint32_t next(uint8_t index, uint32_t nonce, uint32_t reserveCount, bool nicehash, bool *ok = nullptr);
+    static void notify();
+    static void pause(bool paused);
     static void reset(uint8_t index);
     static void stop();
     static void touch();
+    static void wait(Backend backend, const std::function<bool()> &ready);
 
 private:
     static std::atomic<bool> m_paused;
+    static std::atomic<uint64_t> m_resumeLatency[MAX];
     static std::atomic<uint64_t> m_sequence[MAX];
     static uint32_t m_nonces[2];
 };
@@ -61,6 +61,7 @@ xmrig::VirtualMemory::VirtualMemory(size_t size, bool hugePages, bool oneGbPages
 
         m_scratchpad = pool->get(m_size, node);
         if (m_scratchpad) {
+            m_pool = pool;
             m_flags.set(FLAG_HUGEPAGES, pool->isHugePages(node));
             m_flags.set(FLAG_EXTERNAL,  true);
 
@@ -80,6 +81,38 @@ xmrig::VirtualMemory::VirtualMemory(size_t size, bool hugePages, bool oneGbPages
 }
 
 
+// Takes a fixed slice of the arena (or of the global pool if arena is null), so the result does not depend
+// on the order in which threads allocate. Falls back to a private allocation if the slice is not available.
+xmrig::VirtualMemory::VirtualMemory(size_t size, bool hugePages, IMemoryPool *arena, size_t offset, uint32_t node) :
+    m_size(align(size)),
+    m_node(node)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        IMemoryPool *from = arena ? arena : pool;
+
+        if (hugePages && !from->isHugePages(node) && allocateLargePagesMemory()) {
+            return;
+        }
+
+        m_scratchpad = from->getAt(offset, m_size, node);
+        if (m_scratchpad) {
+            m_pool = from;
+            m_flags.set(FLAG_HUGEPAGES, from->isHugePages(node));
+            m_flags.set(FLAG_EXTERNAL,  true);
+
+            return;
+        }
+    }
+
+    if (hugePages && allocateLargePagesMemory()) {
+        return;
+    }
+
+    m_scratchpad = static_cast<uint8_t*>(_mm_malloc(m_size, 64));
+}
+
+
 xmrig::VirtualMemory::~VirtualMemory()
 {
     if (!m_scratchpad) {
@@ -88,7 +121,7 @@ xmrig::VirtualMemory::~VirtualMemory()
 
     if (m_flags.test(FLAG_EXTERNAL)) {
         std::lock_guard<std::mutex> lock(mutex);
-        pool->release(m_node);
+        m_pool->release(m_node);
     }
     else if (isHugePages() || isOneGbPages()) {
         freeLargePagesMemory();
@@ -110,9 +143,29 @@ uint32_t xmrig::VirtualMemory::bindToNUMANode(int64_t)
 {
     return 0;
 }
+
+
+uint32_t xmrig::VirtualMemory::numaNode(int64_t)
+{
+    return 0;
+}
 #endif
 
 
+// nodes maps a NUMA node to the number of 2 MB pages to reserve on it. On NUMA systems the memory of a node
+// is allocated by the first thread that takes a slice of it, so it is local to the threads bound to that node.
+xmrig::IMemoryPool *xmrig::VirtualMemory::createArena(const std::map<uint32_t, size_t> &nodes, bool hugePages)
+{
+#   ifdef XMRIG_FEATURE_HWLOC
+    if (Cpu::info()->nodes() > 1) {
+        return new NUMAMemoryPool(nodes, hugePages);
+    }
+#   endif
+
+    return new MemoryPool(nodes.empty() ? 0 : nodes.begin()->second, hugePages);
+}
+
+
 void xmrig::VirtualMemory::destroy()
 {
     delete pool;
@@ -35,18 +35,23 @@
 #include <bitset>
 #include <cstddef>
 #include <cstdint>
+#include <map>
 #include <utility>
 
 
 namespace xmrig {
 
 
+class IMemoryPool;
+
+
 class VirtualMemory
 {
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(VirtualMemory)
 
     VirtualMemory(size_t size, bool hugePages, bool oneGbPages, bool usePool, uint32_t node = 0, size_t alignSize = 64);
+    VirtualMemory(size_t size, bool hugePages, IMemoryPool *arena, size_t offset, uint32_t node);
     ~VirtualMemory();
 
     inline bool isHugePages() const     { return m_flags.test(FLAG_HUGEPAGES); }
@@ -60,11 +65,15 @@ public:
     static bool isHugepagesAvailable();
     static bool isOneGbPagesAvailable();
     static uint32_t bindToNUMANode(int64_t affinity);
+    static uint32_t numaNode(int64_t affinity);
+    static void *allocateDualMappedMemory(size_t size, void **exec);
     static void *allocateExecutableMemory(size_t size);
     static void *allocateLargePagesMemory(size_t size);
     static void *allocateOneGbPagesMemory(size_t size);
+    static IMemoryPool *createArena(const std::map<uint32_t, size_t> &nodes, bool hugePages);
     static void destroy();
     static void flushInstructionCache(void *p, size_t size);
+    static void freeDualMappedMemory(void *p, void *exec, size_t size);
     static void freeLargePagesMemory(void *p, size_t size);
     static void init(size_t poolSize, bool hugePages);
     static void protectExecutableMemory(void *p, size_t size);
@@ -89,6 +98,7 @@ private:
 
     const size_t m_size;
     const uint32_t m_node;
+    IMemoryPool *m_pool   = nullptr;
     std::bitset<FLAG_MAX> m_flags;
     uint8_t *m_scratchpad = nullptr;
 };
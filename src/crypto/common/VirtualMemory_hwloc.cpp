@@ -51,3 +51,16 @@ uint32_t xmrig::VirtualMemory::bindToNUMANode(int64_t affinity)
 
     return hwloc_bitmap_first(pu->nodeset);
 }
+
+
+uint32_t xmrig::VirtualMemory::numaNode(int64_t affinity)
+{
+    if (affinity < 0 || Cpu::info()->nodes() < 2) {
+        return 0;
+    }
+
+    auto cpu       = static_cast<HwlocCpuInfo *>(Cpu::info());
+    hwloc_obj_t pu = hwloc_get_pu_obj_by_os_index(cpu->topology(), static_cast<unsigned>(affinity));
+
+    return pu ? hwloc_bitmap_first(pu->nodeset) : 0;
+}
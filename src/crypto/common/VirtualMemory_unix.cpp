@@ -25,8 +25,12 @@
  */
 
 
+#include <atomic>
+#include <cstdio>
 #include <cstdlib>
+#include <fcntl.h>
 #include <sys/mman.h>
+#include <unistd.h>
 
 
 #include "backend/cpu/Cpu.h"
@@ -44,9 +48,44 @@
 #       define XMRIG_HAS_1GB_PAGES
 #   endif
 #   include "crypto/common/LinuxMemory.h"
+#   include <sys/syscall.h>
 #endif
 
 
+namespace xmrig {
+
+
+static int createSharedMemory(size_t size)
+{
+#   if defined(XMRIG_OS_LINUX) && defined(SYS_memfd_create)
+    const int fd = static_cast<int>(syscall(SYS_memfd_create, "xmrig-jit", 1U /* MFD_CLOEXEC */));
+#   elif defined(SHM_ANON)
+    const int fd = shm_open(SHM_ANON, O_RDWR | O_CLOEXEC, 0600);
+#   else
+    static std::atomic<uint32_t> counter;
+
+    char name[64];
+    snprintf(name, sizeof(name), "/xmrig-jit-%d-%u", static_cast<int>(getpid()), counter.fetch_add(1));
+
+    const int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd >= 0) {
+        shm_unlink(name);
+    }
+#   endif
+
+    if (fd >= 0 && ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close(fd);
+
+        return -1;
+    }
+
+    return fd;
+}
+
+
+} // namespace xmrig
+
+
 bool xmrig::VirtualMemory::isHugepagesAvailable()
 {
     return true;
@@ -63,6 +102,32 @@ bool xmrig::VirtualMemory::isOneGbPagesAvailable()
 }
 
 
+void *xmrig::VirtualMemory::allocateDualMappedMemory(size_t size, void **exec)
+{
+    const int fd = createSharedMemory(size);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    void *mem = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    void *rx  = mem == MAP_FAILED ? MAP_FAILED : mmap(nullptr, size, PROT_READ | PROT_EXEC, MAP_SHARED, fd, 0);
+
+    close(fd);
+
+    if (rx == MAP_FAILED) {
+        if (mem != MAP_FAILED) {
+            munmap(mem, size);
+        }
+
+        return nullptr;
+    }
+
+    *exec = rx;
+
+    return mem;
+}
+
+
 void *xmrig::VirtualMemory::allocateExecutableMemory(size_t size)
 {
 #   if defined(__APPLE__)
@@ -119,6 +184,13 @@ void xmrig::VirtualMemory::flushInstructionCache(void *p, size_t size)
 }
 
 
+void xmrig::VirtualMemory::freeDualMappedMemory(void *p, void *exec, size_t size)
+{
+    munmap(exec, size);
+    munmap(p, size);
+}
+
+
 void xmrig::VirtualMemory::freeLargePagesMemory(void *p, size_t size)
 {
     munmap(p, size);
@@ -162,6 +162,32 @@ bool xmrig::VirtualMemory::isOneGbPagesAvailable()
 }
 
 
+void *xmrig::VirtualMemory::allocateDualMappedMemory(size_t size, void **exec)
+{
+    HANDLE section = CreateFileMapping(INVALID_HANDLE_VALUE, nullptr, PAGE_EXECUTE_READWRITE, static_cast<DWORD>(static_cast<uint64_t>(size) >> 32), static_cast<DWORD>(size), nullptr);
+    if (section == nullptr) {
+        return nullptr;
+    }
+
+    void *mem = MapViewOfFile(section, FILE_MAP_WRITE, 0, 0, size);
+    void *rx  = mem ? MapViewOfFile(section, FILE_MAP_READ | FILE_MAP_EXECUTE, 0, 0, size) : nullptr;
+
+    CloseHandle(section);
+
+    if (rx == nullptr) {
+        if (mem) {
+            UnmapViewOfFile(mem);
+        }
+
+        return nullptr;
+    }
+
+    *exec = rx;
+
+    return mem;
+}
+
+
 void *xmrig::VirtualMemory::allocateExecutableMemory(size_t size)
 {
     return VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE);
@@ -193,6 +219,13 @@ void xmrig::VirtualMemory::flushInstructionCache(void *p, size_t size)
 }
 
 
+void xmrig::VirtualMemory::freeDualMappedMemory(void *p, void *exec, size_t)
+{
+    UnmapViewOfFile(exec);
+    UnmapViewOfFile(p);
+}
+
+
 void xmrig::VirtualMemory::freeLargePagesMemory(void *p, size_t)
 {
     VirtualFree(p, 0, MEM_RELEASE);
@@ -78,6 +78,99 @@ namespace randomx {
 		}
 	}
 
+#if defined(__GNUC__)
+#define INSTR_LABEL(x) &&exe_label_ ## x,
+#define INSTR_THREADED(x) exe_label_ ## x: \
+	exe_ ## x(bytecode[pc], pc, scratchpad, config); \
+	INSTR_DISPATCH;
+
+#define INSTR_DISPATCH if (++pc >= size) return; \
+	goto *labels[static_cast<uint16_t>(bytecode[pc].type)]
+
+	void BytecodeMachine::executeBytecodeThreaded(InstructionByteCode* bytecode, uint8_t* scratchpad, ProgramConfiguration& config) {
+		// Indexed by InstructionType, IMUL_RCP is compiled to IMUL_R and never reaches the interpreter
+		static void* const labels[] = {
+			INSTR_LABEL(IADD_RS)
+			INSTR_LABEL(IADD_M)
+			INSTR_LABEL(ISUB_R)
+			INSTR_LABEL(ISUB_M)
+			INSTR_LABEL(IMUL_R)
+			INSTR_LABEL(IMUL_M)
+			INSTR_LABEL(IMULH_R)
+			INSTR_LABEL(IMULH_M)
+			INSTR_LABEL(ISMULH_R)
+			INSTR_LABEL(ISMULH_M)
+			&&exe_label_NOP,
+			INSTR_LABEL(INEG_R)
+			INSTR_LABEL(IXOR_R)
+			INSTR_LABEL(IXOR_M)
+			INSTR_LABEL(IROR_R)
+			INSTR_LABEL(IROL_R)
+			INSTR_LABEL(ISWAP_R)
+			INSTR_LABEL(FSWAP_R)
+			INSTR_LABEL(FADD_R)
+			INSTR_LABEL(FADD_M)
+			INSTR_LABEL(FSUB_R)
+			INSTR_LABEL(FSUB_M)
+			INSTR_LABEL(FSCAL_R)
+			INSTR_LABEL(FMUL_R)
+			INSTR_LABEL(FDIV_M)
+			INSTR_LABEL(FSQRT_R)
+			INSTR_LABEL(CBRANCH)
+			INSTR_LABEL(CFROUND)
+			INSTR_LABEL(ISTORE)
+			INSTR_LABEL(NOP)
+		};
+
+		static_assert(sizeof(labels) / sizeof(labels[0]) == static_cast<size_t>(InstructionType::NOP) + 1, "Label table must cover every instruction type");
+
+		const int size = static_cast<int>(RandomX_CurrentConfig.ProgramSize);
+		int pc = -1;
+
+		INSTR_DISPATCH;
+
+		INSTR_THREADED(IADD_RS)
+		INSTR_THREADED(IADD_M)
+		INSTR_THREADED(ISUB_R)
+		INSTR_THREADED(ISUB_M)
+		INSTR_THREADED(IMUL_R)
+		INSTR_THREADED(IMUL_M)
+		INSTR_THREADED(IMULH_R)
+		INSTR_THREADED(IMULH_M)
+		INSTR_THREADED(ISMULH_R)
+		INSTR_THREADED(ISMULH_M)
+		INSTR_THREADED(INEG_R)
+		INSTR_THREADED(IXOR_R)
+		INSTR_THREADED(IXOR_M)
+		INSTR_THREADED(IROR_R)
+		INSTR_THREADED(IROL_R)
+		INSTR_THREADED(ISWAP_R)
+		INSTR_THREADED(FSWAP_R)
+		INSTR_THREADED(FADD_R)
+		INSTR_THREADED(FADD_M)
+		INSTR_THREADED(FSUB_R)
+		INSTR_THREADED(FSUB_M)
+		INSTR_THREADED(FSCAL_R)
+		INSTR_THREADED(FMUL_R)
+		INSTR_THREADED(FDIV_M)
+		INSTR_THREADED(FSQRT_R)
+		INSTR_THREADED(CBRANCH)
+		INSTR_THREADED(CFROUND)
+		INSTR_THREADED(ISTORE)
+
+	exe_label_NOP:
+		INSTR_DISPATCH;
+	}
+
+#undef INSTR_DISPATCH
+#undef INSTR_THREADED
+#undef INSTR_LABEL
+#else
+	void BytecodeMachine::executeBytecodeThreaded(InstructionByteCode* bytecode, uint8_t* scratchpad, ProgramConfiguration& config) {
+		executeBytecode(bytecode, scratchpad, config);
+	}
+#endif
+
 	void BytecodeMachine::compileInstruction(RANDOMX_GEN_ARGS) {
 		int opcode = instr.opcode;
 
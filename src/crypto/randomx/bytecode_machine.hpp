@@ -96,6 +96,11 @@ namespace randomx {
 			}
 		}
 
+		// Same as executeBytecode, but every handler jumps straight to the next one through a label table (computed goto)
+		// instead of returning to a central switch, so each instruction type gets its own indirect branch to predict.
+		// Falls back to executeBytecode on compilers without labels as values.
+		static void executeBytecodeThreaded(InstructionByteCode* bytecode, uint8_t* scratchpad, ProgramConfiguration& config);
+
 		void compileInstruction(RANDOMX_GEN_ARGS)
 #ifdef RANDOMX_GEN_TABLE
 		{
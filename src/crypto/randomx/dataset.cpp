@@ -38,6 +38,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cstring>
 #include <limits>
 #include <cstring>
+#include <thread>
+#include <vector>
 
 #include "crypto/randomx/common.hpp"
 #include "crypto/randomx/dataset.hpp"
@@ -50,6 +52,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "crypto/randomx/argon2_core.h"
 #include "crypto/randomx/jit_compiler.hpp"
 #include "crypto/randomx/intrin_portable.h"
+#include "crypto/argon2/Impl.h"
 
 //static_assert(RANDOMX_ARGON_MEMORY % (RANDOMX_ARGON_LANES * ARGON2_SYNC_POINTS) == 0, "RANDOMX_ARGON_MEMORY - invalid value");
 static_assert(ARGON2_BLOCK_SIZE == randomx::ArgonBlockSize, "Unpexpected value of ARGON2_BLOCK_SIZE");
@@ -67,7 +70,47 @@ namespace randomx {
 	template void deallocCache<DefaultAllocator>(randomx_cache* cache);
 	template void deallocCache<LargePageAllocator>(randomx_cache* cache);
 
+	static void fillMemoryBlocks(const argon2_instance_t* instance) {
+		// rx/0 and the other single lane variants fill every segment on the calling thread.
+		if (instance->lanes == 1) {
+			for (uint32_t r = 0; r < instance->passes; ++r) {
+				for (uint32_t s = 0; s < ARGON2_SYNC_POINTS; ++s) {
+					xmrig::argon2::Impl::fillSegment(instance->memory, instance->memory_blocks, instance->passes, 1, r, 0, s);
+				}
+			}
+
+			return;
+		}
+
+		// Multi-lane variants only (rx/loki uses 2 lanes): segments of one slice only reference finished slices,
+		// so every extra lane gets its own thread.
+		std::vector<std::thread> threads;
+		threads.reserve(instance->lanes);
+
+		for (uint32_t r = 0; r < instance->passes; ++r) {
+			for (uint32_t s = 0; s < ARGON2_SYNC_POINTS; ++s) {
+				for (uint32_t l = 1; l < instance->lanes; ++l) {
+					threads.emplace_back(xmrig::argon2::Impl::fillSegment, instance->memory, instance->memory_blocks, instance->passes, instance->lanes, r, l, s);
+				}
+
+				xmrig::argon2::Impl::fillSegment(instance->memory, instance->memory_blocks, instance->passes, instance->lanes, r, 0, s);
+
+				for (auto& thread : threads) {
+					thread.join();
+				}
+
+				threads.clear();
+			}
+		}
+	}
+
 	void initCache(randomx_cache* cache, const void* key, size_t keySize) {
+		fillCache(cache->memory, key, keySize, false);
+
+		initCachePrograms(cache, key, keySize);
+	}
+
+	void fillCache(uint8_t* memory, const void* key, size_t keySize, bool reference) {
 		uint32_t memory_blocks, segment_length;
 		argon2_instance_t instance;
 		argon2_context context;
@@ -85,7 +128,7 @@ namespace randomx {
 		context.t_cost = RandomX_CurrentConfig.ArgonIterations;
 		context.m_cost = RandomX_CurrentConfig.ArgonMemory;
 		context.lanes = RandomX_CurrentConfig.ArgonLanes;
-		context.threads = 1;
+		context.threads = RandomX_CurrentConfig.ArgonLanes;
 		context.allocate_cbk = NULL;
 		context.free_cbk = NULL;
 		context.flags = ARGON2_DEFAULT_FLAGS;
@@ -106,7 +149,7 @@ namespace randomx {
 		instance.lanes = context.lanes;
 		instance.threads = context.threads;
 		instance.type = Argon2_d;
-		instance.memory = (block*)cache->memory;
+		instance.memory = (block*)memory;
 
 		if (instance.threads > instance.lanes) {
 			instance.threads = instance.lanes;
@@ -117,8 +160,15 @@ namespace randomx {
 		 */
 		rxa2_argon_initialize(&instance, &context);
 
-		rxa2_fill_memory_blocks(&instance);
+		if (reference) {
+			rxa2_fill_memory_blocks(&instance);
+		}
+		else {
+			fillMemoryBlocks(&instance);
+		}
+	}
 
+	void initCachePrograms(randomx_cache* cache, const void* key, size_t keySize) {
 		cache->reciprocalCache.clear();
 		randomx::Blake2Generator gen(key, keySize);
 		for (uint32_t i = 0; i < RandomX_CurrentConfig.CacheAccesses; ++i) {
@@ -138,6 +188,7 @@ namespace randomx {
 		initCache(cache, key, keySize);
 		cache->jit->generateSuperscalarHash(cache->programs, cache->reciprocalCache);
 		cache->jit->generateDatasetInitCode();
+		selectDatasetInit(cache);
 	}
 
 	constexpr uint64_t superscalarMul0 = 6364136223846793005ULL;
@@ -186,4 +237,42 @@ namespace randomx {
 		for (uint32_t itemNumber = startItem; itemNumber < endItem; ++itemNumber, dataset += CacheLineSize)
 			initDatasetItem(cache, dataset, itemNumber);
 	}
+
+	void initDatasetAVX2(randomx_cache* cache, uint8_t* dataset, uint32_t startItem, uint32_t endItem) {
+		// The AVX2 code computes 4 items per iteration, the scalar code takes the remainder
+		const uint32_t count = (endItem - startItem) & ~3U;
+		if (count) {
+			cache->jit->getDatasetInitAVX2Func()(cache, dataset, startItem, startItem + count);
+		}
+		if (startItem + count < endItem) {
+			cache->jit->getDatasetInitFunc()(cache, dataset + count * CacheLineSize, startItem + count, endItem);
+		}
+	}
+
+	static bool checkDatasetInitAVX2(randomx_cache* cache) {
+		constexpr uint32_t checkItems = 64;
+		alignas(64) uint8_t expected[checkItems * CacheLineSize];
+		alignas(64) uint8_t actual[checkItems * CacheLineSize];
+
+		// Odd start item and count, so both the AVX2 loop and the scalar tail are covered
+		cache->jit->getDatasetInitFunc()(cache, expected, 1, checkItems);
+		initDatasetAVX2(cache, actual, 1, checkItems);
+
+		return memcmp(expected, actual, (checkItems - 1) * CacheLineSize) == 0;
+	}
+
+	void selectDatasetInit(randomx_cache* cache) {
+		cache->datasetInit = cache->jit->getDatasetInitFunc();
+		cache->datasetInitKind = RANDOMX_DATASET_INIT_JIT;
+
+		if (cache->jit->getDatasetInitAVX2Func()) {
+			if (checkDatasetInitAVX2(cache)) {
+				cache->datasetInit = &initDatasetAVX2;
+				cache->datasetInitKind = RANDOMX_DATASET_INIT_AVX2;
+			}
+			else {
+				cache->datasetInitKind = RANDOMX_DATASET_INIT_AVX2_MISMATCH;
+			}
+		}
+	}
 }
@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "crypto/randomx/common.hpp"
 #include "crypto/randomx/superscalar_program.hpp"
 #include "crypto/randomx/allocator.hpp"
+#include "crypto/randomx/randomx.h"
 
 /* Global scope for C binding */
 struct randomx_dataset {
@@ -46,6 +47,7 @@ struct randomx_cache {
 	randomx::JitCompiler* jit;
 	randomx::CacheInitializeFunc* initialize;
 	randomx::DatasetInitFunc* datasetInit;
+	randomx_dataset_init_kind datasetInitKind = RANDOMX_DATASET_INIT_INTERPRETED;
 	randomx::SuperscalarProgram programs[RANDOMX_CACHE_MAX_ACCESSES];
 	std::vector<uint64_t> reciprocalCache;
 
@@ -73,7 +75,11 @@ namespace randomx {
 	void deallocCache(randomx_cache* cache);
 
 	void initCache(randomx_cache*, const void*, size_t);
+	void fillCache(uint8_t* memory, const void* key, size_t keySize, bool reference);
+	void initCachePrograms(randomx_cache*, const void*, size_t);
 	void initCacheCompile(randomx_cache*, const void*, size_t);
 	void initDatasetItem(randomx_cache* cache, uint8_t* out, uint64_t blockNumber);
 	void initDataset(randomx_cache* cache, uint8_t* dataset, uint32_t startBlock, uint32_t endBlock);
+	void initDatasetAVX2(randomx_cache* cache, uint8_t* dataset, uint32_t startBlock, uint32_t endBlock);
+	void selectDatasetInit(randomx_cache* cache);
 }
@@ -89,7 +89,7 @@ static size_t CalcDatasetItemSize()
 
 constexpr uint32_t IntRegMap[8] = { 4, 5, 6, 7, 12, 13, 14, 15 };
 
-JitCompilerA64::JitCompilerA64()
+JitCompilerA64::JitCompilerA64(bool)
 	: code((uint8_t*) allocExecutableMemory(CodeSize + CalcDatasetItemSize()))
 	, literalPos(ImulRcpLiteralsEnd)
 	, num32bitLiterals(0)
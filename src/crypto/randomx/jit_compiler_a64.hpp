@@ -46,10 +46,9 @@ namespace randomx {
 
 	class JitCompilerA64 {
 	public:
-		JitCompilerA64();
+		explicit JitCompilerA64(bool optimizedDatasetInit = false);
 		~JitCompilerA64();
 
-		void prepare() {}
 		void generateProgram(Program&, ProgramConfiguration&, uint32_t);
 		void generateProgramLight(Program&, ProgramConfiguration&, uint32_t);
 
@@ -60,6 +59,7 @@ namespace randomx {
 
 		ProgramFunc* getProgramFunc() { return reinterpret_cast<ProgramFunc*>(code); }
 		DatasetInitFunc* getDatasetInitFunc();
+		DatasetInitFunc* getDatasetInitAVX2Func() { return nullptr; }
 		uint8_t* getCode() { return code; }
 		size_t getCodeSize();
 
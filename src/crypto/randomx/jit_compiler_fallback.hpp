@@ -41,10 +41,9 @@ namespace randomx {
 
 	class JitCompilerFallback {
 	public:
-		JitCompilerFallback() {
+		explicit JitCompilerFallback(bool = false) {
 			throw std::runtime_error("JIT compilation is not supported on this platform");
 		}
-		void prepare() {}
 		void generateProgram(Program&, ProgramConfiguration&, uint32_t) {
 
 		}
@@ -64,6 +63,9 @@ namespace randomx {
 		DatasetInitFunc* getDatasetInitFunc() {
 			return nullptr;
 		}
+		DatasetInitFunc* getDatasetInitAVX2Func() {
+			return nullptr;
+		}
 		uint8_t* getCode() {
 			return nullptr;
 		}
@@ -26,6 +26,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <algorithm>
 #include <stdexcept>
 #include <cstring>
 #include <climits>
@@ -291,7 +292,7 @@ namespace randomx {
 
 	static std::atomic<size_t> codeOffset;
 
-	JitCompilerX86::JitCompilerX86() {
+	JitCompilerX86::JitCompilerX86(bool optimizedDatasetInit) {
 		applyTweaks();
 
 		int32_t info[4];
@@ -301,9 +302,15 @@ namespace randomx {
 		cpuid(0x80000001, info);
 		hasXOP = ((info[2] & (1 << 11)) != 0);
 
-		allocatedCode = (uint8_t*)allocExecutableMemory(CodeSize * 2);
+		initDatasetAVX2 = optimizedDatasetInit;
+
+		allocatedSize = CodeSize * 2 + (initDatasetAVX2 ? DatasetInitAVX2CodeSize + DatasetInitAVX2ConstSize : 0);
+		void* exec = nullptr;
+		allocatedCode = (uint8_t*)allocJitMemory(allocatedSize, &exec);
+		allocatedCodeExec = (uint8_t*)exec;
 		// Shift code base address to improve caching - all threads will use different L2/L3 cache sets
 		code = allocatedCode + (codeOffset.fetch_add(59 * 64) % CodeSize);
+		codeExec = allocatedCodeExec + (code - allocatedCode);
 		memcpy(code, codePrologue, prologueSize);
 		if (hasXOP) {
 			memcpy(code + prologueSize, codeLoopLoadXOP, loopLoadXOPSize);
@@ -316,20 +323,13 @@ namespace randomx {
 		codePosFirst = prologueSize + (hasXOP ? loopLoadXOPSize : loopLoadSize);
 
 #		ifdef XMRIG_FIX_RYZEN
-		mainLoopBounds.first = code + prologueSize;
-		mainLoopBounds.second = code + epilogueOffset;
+		mainLoopBounds.first = codeExec + prologueSize;
+		mainLoopBounds.second = codeExec + epilogueOffset;
 #		endif
 	}
 
 	JitCompilerX86::~JitCompilerX86() {
-		freePagedMemory(allocatedCode, CodeSize);
-	}
-
-	void JitCompilerX86::prepare() {
-		for (size_t i = 0; i < sizeof(engine); i += 64)
-			rx_prefetch_nta((const char*)(&engine) + i);
-		for (size_t i = 0; i < sizeof(RandomX_CurrentConfig); i += 64)
-			rx_prefetch_nta((const char*)(&RandomX_CurrentConfig) + i);
+		freeJitMemory(allocatedCode, allocatedCodeExec, allocatedSize);
 	}
 
 	void JitCompilerX86::generateProgram(Program& prog, ProgramConfiguration& pcfg, uint32_t flags) {
@@ -391,6 +391,10 @@ namespace randomx {
 			}
 		}
 		emitByte(RET, code, codePos);
+
+		if (initDatasetAVX2) {
+			initDatasetAVX2 = generateSuperscalarHashAVX2(programs, reciprocalCache);
+		}
 	}
 
 	template
@@ -451,17 +455,13 @@ namespace randomx {
 			(this->*gen4)(instr4);
 		}
 
-		emit(REX_MOV_RR, code, codePos);
-		emitByte(0xc0 + pcfg.readReg2, code, codePos);
-		emit(REX_XOR_EAX, code, codePos);
-		emitByte(0xc0 + pcfg.readReg3, code, codePos);
+		*(uint64_t*)(code + codePos) = 0x0000c03341c08b41ULL + (static_cast<uint64_t>(pcfg.readReg2) << 16) + (static_cast<uint64_t>(pcfg.readReg3) << 40);
+		codePos += 6;
 	}
 
 	void JitCompilerX86::generateProgramEpilogue(Program& prog, ProgramConfiguration& pcfg) {
-		emit(REX_MOV_RR64, code, codePos);
-		emitByte(0xc0 + pcfg.readReg0, code, codePos);
-		emit(REX_XOR_RAX_R64, code, codePos);
-		emitByte(0xc0 + pcfg.readReg1, code, codePos);
+		*(uint64_t*)(code + codePos) = 0x0000c03349c08b49ULL + (static_cast<uint64_t>(pcfg.readReg0) << 16) + (static_cast<uint64_t>(pcfg.readReg1) << 40);
+		codePos += 6;
 		emit(RandomX_CurrentConfig.codePrefetchScratchpadTweaked, prefetchScratchpadSize, code, codePos);
 		memcpy(code + codePos, codeLoopStore, loopStoreSize);
 		codePos += loopStoreSize;
@@ -481,11 +481,13 @@ namespace randomx {
 			}
 		}
 
-		emit(SUB_EBX, code, codePos);
-		emit(JNZ, code, codePos);
-		emit32(prologueSize - codePos - 4, code, codePos);
-		emitByte(JMP, code, codePos);
-		emit32(epilogueOffset - codePos - 4, code, codePos);
+		// sub ebx, 1; jnz loop; jmp epilogue
+		uint8_t* p = code + codePos;
+		*(uint64_t*)(p) = 0x850f01eb83ULL;
+		*(uint32_t*)(p + 5) = prologueSize - codePos - 9;
+		p[9] = JMP;
+		*(uint32_t*)(p + 10) = epilogueOffset - codePos - 14;
+		codePos += 14;
 	}
 
 	void JitCompilerX86::generateSuperscalarCode(Instruction& instr, std::vector<uint64_t> &reciprocalCache) {
@@ -582,6 +584,408 @@ namespace randomx {
 		}
 	}
 
+	// AVX2 dataset initialization: ymm0-ymm7 hold registers r0-r7 of 4 consecutive dataset items
+	// (one item per 64-bit lane), ymm8-ymm14 are temporaries and ymm15 is kept at zero.
+	// GP registers: rdi = cache memory, rsi = dataset output, rbp = item number, rax/rbx/rcx/rdx = cache lines of lanes 0-3.
+
+	static constexpr int AVX2_TMP = 8;
+	static constexpr int AVX2_ZERO = 15;
+
+	enum AVX2Map { MAP_0F = 1, MAP_0F38 = 2, MAP_0F3A = 3 };
+	enum AVX2Prefix { PP_NONE = 0, PP_66 = 1, PP_F3 = 2 };
+
+	static void emitVEX(uint8_t* code, int& codePos, int map, int pp, int W, int L, int reg, int vvvv, int rm) {
+		if ((map == MAP_0F) && (W == 0) && (rm < 8)) {
+			code[codePos++] = 0xC5;
+			code[codePos++] = ((~reg & 8) << 4) | ((~vvvv & 15) << 3) | (L << 2) | pp;
+		}
+		else {
+			code[codePos++] = 0xC4;
+			code[codePos++] = ((~reg & 8) << 4) | 0x40 | ((~rm & 8) << 2) | map;
+			code[codePos++] = (W << 7) | ((~vvvv & 15) << 3) | (L << 2) | pp;
+		}
+	}
+
+	// ymm dst = op(ymm a, ymm b)
+	static void emitAVX2(uint8_t* code, int& codePos, uint8_t opcode, int dst, int a, int b, int map = MAP_0F, bool commutative = false) {
+		if (commutative && (b >= 8) && (a < 8)) {
+			std::swap(a, b);
+		}
+		emitVEX(code, codePos, map, PP_66, 0, 1, dst, a, b);
+		code[codePos++] = opcode;
+		code[codePos++] = 0xC0 | ((dst & 7) << 3) | (b & 7);
+	}
+
+	// ymm dst = op(ymm a, [rip + constant])
+	static void emitAVX2Const(uint8_t* code, int& codePos, uint8_t opcode, int dst, int a, int constOffset) {
+		emitVEX(code, codePos, MAP_0F, PP_66, 0, 1, dst, a, 0);
+		code[codePos++] = opcode;
+		code[codePos++] = ((dst & 7) << 3) | 5;
+		const int32_t disp = constOffset - (codePos + 4);
+		memcpy(code + codePos, &disp, sizeof(disp));
+		codePos += 4;
+	}
+
+	// vpsrlq/vpsllq ymm dst, ymm src, imm8
+	static void emitAVX2Shift(uint8_t* code, int& codePos, bool left, int dst, int src, uint8_t count) {
+		emitVEX(code, codePos, MAP_0F, PP_66, 0, 1, left ? 6 : 2, dst, src);
+		code[codePos++] = 0x73;
+		code[codePos++] = 0xC0 | ((left ? 6 : 2) << 3) | (src & 7);
+		code[codePos++] = count;
+	}
+
+	// vmovdqu ymm reg, [base + disp8] (load) or vmovdqa [base + disp32], ymm reg (store)
+	static void emitAVX2Mem(uint8_t* code, int& codePos, bool store, int reg, int base, int32_t disp) {
+		emitVEX(code, codePos, MAP_0F, store ? PP_66 : PP_F3, 0, 1, reg, 0, base);
+		code[codePos++] = store ? 0x7F : 0x6F;
+		if (disp == 0) {
+			code[codePos++] = ((reg & 7) << 3) | base;
+		}
+		else {
+			code[codePos++] = 0x80 | ((reg & 7) << 3) | base;
+			memcpy(code + codePos, &disp, sizeof(disp));
+			codePos += 4;
+		}
+	}
+
+#	ifdef _WIN64
+	// vmovdqu [rsp + disp32], xmm reg (store) or vmovdqu xmm reg, [rsp + disp32] (load)
+	static void emitXMMStack(uint8_t* code, int& codePos, bool store, int reg, int32_t disp) {
+		emitVEX(code, codePos, MAP_0F, PP_F3, 0, 0, reg, 0, 0);
+		code[codePos++] = store ? 0x7F : 0x6F;
+		code[codePos++] = 0x84 | ((reg & 7) << 3);
+		code[codePos++] = 0x24;
+		memcpy(code + codePos, &disp, sizeof(disp));
+		codePos += 4;
+	}
+#	endif
+
+	static int addConstAVX2(uint8_t* code, int& constPos, uint64_t value) {
+		const int offset = CodeSize + DatasetInitAVX2CodeSize + constPos;
+		for (int i = 0; i < 4; ++i) {
+			memcpy(code + offset + i * 8, &value, sizeof(value));
+		}
+		constPos += 32;
+		return offset;
+	}
+
+	// dst = src * c (lower 64 bits), t0 and t1 are clobbered
+	static void emitMulConstAVX2(uint8_t* code, int& codePos, int& constPos, int dst, int src, uint64_t c, int t0, int t1) {
+		const int lo = addConstAVX2(code, constPos, c);
+		const int hi = addConstAVX2(code, constPos, c >> 32);
+		emitAVX2Shift(code, codePos, false, t0, src, 32);
+		emitAVX2Const(code, codePos, 0xF4, t0, t0, lo);
+		emitAVX2Const(code, codePos, 0xF4, t1, src, hi);
+		emitAVX2(code, codePos, 0xD4, t0, t0, t1, MAP_0F, true);
+		emitAVX2Shift(code, codePos, true, t0, t0, 32);
+		emitAVX2Const(code, codePos, 0xF4, dst, src, lo);
+		emitAVX2(code, codePos, 0xD4, dst, dst, t0, MAP_0F, true);
+	}
+
+	template<size_t N>
+	bool JitCompilerX86::generateSuperscalarHashAVX2(SuperscalarProgram(&programs)[N], std::vector<uint64_t> &reciprocalCache) {
+		static const uint8_t PROLOGUE[] = {
+			0x53,                                     // push rbx
+			0x55,                                     // push rbp
+#		ifdef _WIN64
+			0x57,                                     // push rdi
+			0x56,                                     // push rsi
+			0x48, 0x81, 0xEC, 0xA0, 0x00, 0x00, 0x00, // sub rsp, 160
+#		endif
+		};
+		static const uint8_t PROLOGUE_ARGS[] = {
+#		ifdef _WIN64
+			0x48, 0x8B, 0x39,                         // mov rdi, [rcx]
+			0x48, 0x89, 0xD6,                         // mov rsi, rdx
+			0x44, 0x89, 0xC5,                         // mov ebp, r8d
+			0x45, 0x89, 0xC9,                         // mov r9d, r9d
+			0x41, 0x51,                               // push r9
+#		else
+			0x48, 0x8B, 0x3F,                         // mov rdi, [rdi]
+			0x89, 0xD5,                               // mov ebp, edx
+			0x89, 0xC9,                               // mov ecx, ecx
+			0x51,                                     // push rcx
+#		endif
+		};
+		static const uint8_t LINE_ADDRESSES[] = {
+			0x48, 0x89, 0xE8,                         // mov rax, rbp
+			0x48, 0x8D, 0x5D, 0x01,                   // lea rbx, [rbp + 1]
+			0x48, 0x8D, 0x4D, 0x02,                   // lea rcx, [rbp + 2]
+			0x48, 0x8D, 0x55, 0x03,                   // lea rdx, [rbp + 3]
+		};
+		static const uint8_t AND_LINE[4][2] = { { 0x81, 0xE0 }, { 0x81, 0xE3 }, { 0x81, 0xE1 }, { 0x81, 0xE2 } };
+		static const uint8_t SHL_ADD_PREFETCH_LINE[4][10] = {
+			{ 0x48, 0xC1, 0xE0, 0x06, 0x48, 0x01, 0xF8, 0x0F, 0x18, 0x00 },
+			{ 0x48, 0xC1, 0xE3, 0x06, 0x48, 0x01, 0xFB, 0x0F, 0x18, 0x03 },
+			{ 0x48, 0xC1, 0xE1, 0x06, 0x48, 0x01, 0xF9, 0x0F, 0x18, 0x01 },
+			{ 0x48, 0xC1, 0xE2, 0x06, 0x48, 0x01, 0xFA, 0x0F, 0x18, 0x02 },
+		};
+		static const uint8_t LOOP_TAIL[] = {
+			0x48, 0x81, 0xC6, 0x00, 0x01, 0x00, 0x00, // add rsi, 256
+			0x48, 0x83, 0xC5, 0x04,                   // add rbp, 4
+			0x48, 0x3B, 0x2C, 0x24,                   // cmp rbp, [rsp]
+			0x0F, 0x82,                               // jb
+		};
+		static const uint8_t EPILOGUE[] = {
+			0xC5, 0xF8, 0x77,                         // vzeroupper
+#		ifdef _WIN64
+			0x48, 0x81, 0xC4, 0xA0, 0x00, 0x00, 0x00, // add rsp, 160
+			0x5E,                                     // pop rsi
+			0x5F,                                     // pop rdi
+#		endif
+			0x5D,                                     // pop rbp
+			0x5B,                                     // pop rbx
+			0xC3,                                     // ret
+		};
+
+		constexpr uint64_t superscalarMul0 = 6364136223846793005ULL;
+		static const uint64_t superscalarAdd[8] = { 0, 9298411001130361340ULL, 12065312585734608966ULL, 9306329213124626780ULL,
+			5281919268842080866ULL, 10536153434571861004ULL, 3398623926847679864ULL, 9549104520008361294ULL };
+
+		const uint32_t lineMask = (RandomX_CurrentConfig.ArgonMemory * ArgonBlockSize) / CacheLineSize - 1;
+		const int codeEnd = CodeSize + DatasetInitAVX2CodeSize - 1024;
+		const int constEnd = DatasetInitAVX2ConstSize - 64;
+
+		int pos = CodeSize;
+		int constPos = 0;
+
+		emit(PROLOGUE, code, pos);
+#		ifdef _WIN64
+		for (int i = 0; i < 10; ++i) {
+			emitXMMStack(code, pos, true, 6 + i, i * 16);
+		}
+#		endif
+		emit(PROLOGUE_ARGS, code, pos);
+		emitAVX2(code, pos, 0xEF, AVX2_ZERO, AVX2_ZERO, AVX2_ZERO);
+
+		const int itemOffsets = addConstAVX2(code, constPos, 0);
+		for (uint64_t i = 0; i < 4; ++i) {
+			const uint64_t item = i + 1;
+			memcpy(code + itemOffsets + i * 8, &item, sizeof(item));
+		}
+		const int lineMaskConst = addConstAVX2(code, constPos, lineMask);
+		int addConst[8];
+		for (int k = 1; k < 8; ++k) {
+			addConst[k] = addConstAVX2(code, constPos, superscalarAdd[k]);
+		}
+
+		while (pos % 64) {
+			const int nopSize = std::min(64 - pos % 64, 8);
+			emit(NOPX[nopSize - 1], nopSize, code, pos);
+		}
+		const int loopStart = pos;
+
+		emit(LINE_ADDRESSES, code, pos);
+		for (int l = 0; l < 4; ++l) {
+			emit(AND_LINE[l], code, pos);
+			emit32(lineMask, code, pos);
+			emit(SHL_ADD_PREFETCH_LINE[l], code, pos);
+		}
+
+		// vmovq xmm8, rbp; vpbroadcastq ymm8, xmm8; vpaddq ymm8, ymm8, [1, 2, 3, 4]
+		emitVEX(code, pos, MAP_0F, PP_66, 1, 0, AVX2_TMP, 0, 5);
+		emitByte(0x6E, code, pos);
+		emitByte(0xC5, code, pos);
+		emitAVX2(code, pos, 0x59, AVX2_TMP, 0, AVX2_TMP, MAP_0F38);
+		emitAVX2Const(code, pos, 0xD4, AVX2_TMP, AVX2_TMP, itemOffsets);
+
+		emitMulConstAVX2(code, pos, constPos, 0, AVX2_TMP, superscalarMul0, AVX2_TMP + 1, AVX2_TMP + 2);
+		for (int k = 1; k < 8; ++k) {
+			emitAVX2Const(code, pos, 0xEF, k, 0, addConst[k]);
+		}
+
+		static const int lineBase[4] = { 0, 3, 1, 2 }; // rax, rbx, rcx, rdx
+		static const int loadPerm[4][3] = { { 12, 8, 0x20 }, { 13, 9, 0x20 }, { 12, 8, 0x31 }, { 13, 9, 0x31 } };
+		static const int storePerm[4][4] = { { 12, 8, 10, 0x20 }, { 13, 9, 11, 0x20 }, { 8, 8, 10, 0x31 }, { 9, 9, 11, 0x31 } };
+
+		const int savedCodePos = codePos;
+
+		for (unsigned j = 0; j < RandomX_CurrentConfig.CacheAccesses; ++j) {
+			SuperscalarProgram& prog = programs[j];
+			codePos = pos;
+			for (unsigned i = 0; i < prog.getSize(); ++i) {
+				if ((codePos > codeEnd) || (constPos > constEnd)) {
+					codePos = savedCodePos;
+					return false;
+				}
+				generateSuperscalarCodeAVX2(prog(i), reciprocalCache, constPos);
+			}
+			pos = codePos;
+			codePos = savedCodePos;
+
+			// Transpose cache lines of the 4 items into registers and xor them in
+			for (int half = 0; half < 2; ++half) {
+				for (int l = 0; l < 4; ++l) {
+					emitAVX2Mem(code, pos, false, AVX2_TMP + l, lineBase[l], half * 32);
+				}
+				emitAVX2(code, pos, 0x6C, 12, 8, 9);
+				emitAVX2(code, pos, 0x6D, 13, 8, 9);
+				emitAVX2(code, pos, 0x6C, 8, 10, 11);
+				emitAVX2(code, pos, 0x6D, 9, 10, 11);
+				for (int q = 0; q < 4; ++q) {
+					emitAVX2(code, pos, 0x46, 10, loadPerm[q][0], loadPerm[q][1], MAP_0F3A);
+					emitByte(loadPerm[q][2], code, pos);
+					emitAVX2(code, pos, 0xEF, half * 4 + q, half * 4 + q, 10, MAP_0F, true);
+				}
+			}
+
+			if (j < RandomX_CurrentConfig.CacheAccesses - 1) {
+				emitAVX2Const(code, pos, 0xDB, AVX2_TMP, prog.getAddressRegister(), lineMaskConst);
+				emitAVX2Shift(code, pos, true, AVX2_TMP, AVX2_TMP, 6);
+				for (int l = 0; l < 4; ++l) {
+					if (l == 2) {
+						// vextracti128 xmm8, ymm8, 1
+						emitAVX2(code, pos, 0x39, AVX2_TMP, 0, AVX2_TMP, MAP_0F3A);
+						emitByte(1, code, pos);
+					}
+					if (l & 1) {
+						// vpextrq r64, xmm8, 1
+						emitVEX(code, pos, MAP_0F3A, PP_66, 1, 0, AVX2_TMP, 0, lineBase[l]);
+						emitByte(0x16, code, pos);
+						emitByte(0xC0 | lineBase[l], code, pos);
+						emitByte(1, code, pos);
+					}
+					else {
+						// vmovq r64, xmm8
+						emitVEX(code, pos, MAP_0F, PP_66, 1, 0, AVX2_TMP, 0, lineBase[l]);
+						emitByte(0x7E, code, pos);
+						emitByte(0xC0 | lineBase[l], code, pos);
+					}
+					emit(SHL_ADD_PREFETCH_LINE[l] + 4, 6, code, pos);
+				}
+			}
+		}
+
+		// Transpose registers back to 4 dataset items and store them
+		for (int half = 0; half < 2; ++half) {
+			const int r = half * 4;
+			emitAVX2(code, pos, 0x6C, 8, r + 0, r + 1);
+			emitAVX2(code, pos, 0x6D, 9, r + 0, r + 1);
+			emitAVX2(code, pos, 0x6C, 10, r + 2, r + 3);
+			emitAVX2(code, pos, 0x6D, 11, r + 2, r + 3);
+			for (int q = 0; q < 4; ++q) {
+				emitAVX2(code, pos, 0x46, storePerm[q][0], storePerm[q][1], storePerm[q][2], MAP_0F3A);
+				emitByte(storePerm[q][3], code, pos);
+				emitAVX2Mem(code, pos, true, storePerm[q][0], 6, q * 64 + half * 32);
+			}
+		}
+
+		emit(LOOP_TAIL, code, pos);
+		emit32(loopStart - (pos + 4), code, pos);
+
+		emitByte(0x58, code, pos); // pop rax
+#		ifdef _WIN64
+		for (int i = 0; i < 10; ++i) {
+			emitXMMStack(code, pos, false, 6 + i, i * 16);
+		}
+#		endif
+		emit(EPILOGUE, code, pos);
+
+		return true;
+	}
+
+	void JitCompilerX86::generateSuperscalarCodeAVX2(Instruction& instr, std::vector<uint64_t> &reciprocalCache, int& constPos) {
+		constexpr int T0 = AVX2_TMP;
+		constexpr int T1 = AVX2_TMP + 1;
+		constexpr int T2 = AVX2_TMP + 2;
+		constexpr int T3 = AVX2_TMP + 3;
+		constexpr int T4 = AVX2_TMP + 4;
+		constexpr int T5 = AVX2_TMP + 5;
+		constexpr int T6 = AVX2_TMP + 6;
+
+		const int dst = instr.dst;
+		const int src = instr.src;
+
+		switch ((SuperscalarInstructionType)instr.opcode)
+		{
+		case randomx::SuperscalarInstructionType::ISUB_R:
+			emitAVX2(code, codePos, 0xFB, dst, dst, src);
+			break;
+		case randomx::SuperscalarInstructionType::IXOR_R:
+			emitAVX2(code, codePos, 0xEF, dst, dst, src);
+			break;
+		case randomx::SuperscalarInstructionType::IADD_RS:
+			if (instr.getModShift() == 0) {
+				emitAVX2(code, codePos, 0xD4, dst, dst, src);
+			}
+			else {
+				emitAVX2Shift(code, codePos, true, T0, src, instr.getModShift());
+				emitAVX2(code, codePos, 0xD4, dst, dst, T0, MAP_0F, true);
+			}
+			break;
+		case randomx::SuperscalarInstructionType::IMUL_R:
+			emitAVX2Shift(code, codePos, false, T0, dst, 32);
+			emitAVX2Shift(code, codePos, false, T1, src, 32);
+			emitAVX2(code, codePos, 0xF4, T0, T0, src, MAP_0F, true);
+			emitAVX2(code, codePos, 0xF4, T1, T1, dst, MAP_0F, true);
+			emitAVX2(code, codePos, 0xD4, T0, T0, T1);
+			emitAVX2Shift(code, codePos, true, T0, T0, 32);
+			emitAVX2(code, codePos, 0xF4, dst, dst, src);
+			emitAVX2(code, codePos, 0xD4, dst, dst, T0, MAP_0F, true);
+			break;
+		case randomx::SuperscalarInstructionType::IROR_C:
+			{
+				const uint32_t shift = instr.getImm32() & 63;
+				if (shift) {
+					emitAVX2Shift(code, codePos, false, T0, dst, shift);
+					emitAVX2Shift(code, codePos, true, dst, dst, 64 - shift);
+					emitAVX2(code, codePos, 0xEB, dst, dst, T0, MAP_0F, true);
+				}
+			}
+			break;
+		case randomx::SuperscalarInstructionType::IADD_C7:
+		case randomx::SuperscalarInstructionType::IADD_C8:
+		case randomx::SuperscalarInstructionType::IADD_C9:
+			emitAVX2Const(code, codePos, 0xD4, dst, dst, addConstAVX2(code, constPos, signExtend2sCompl(instr.getImm32())));
+			break;
+		case randomx::SuperscalarInstructionType::IXOR_C7:
+		case randomx::SuperscalarInstructionType::IXOR_C8:
+		case randomx::SuperscalarInstructionType::IXOR_C9:
+			emitAVX2Const(code, codePos, 0xEF, dst, dst, addConstAVX2(code, constPos, signExtend2sCompl(instr.getImm32())));
+			break;
+		case randomx::SuperscalarInstructionType::IMULH_R:
+		case randomx::SuperscalarInstructionType::ISMULH_R:
+			{
+				const bool isSigned = (SuperscalarInstructionType)instr.opcode == SuperscalarInstructionType::ISMULH_R;
+				if (isSigned) {
+					// the signed high half is the unsigned one minus (dst < 0 ? src : 0) and (src < 0 ? dst : 0)
+					emitAVX2(code, codePos, 0x37, T5, AVX2_ZERO, dst, MAP_0F38);
+					emitAVX2(code, codePos, 0xDB, T5, T5, src, MAP_0F, true);
+					emitAVX2(code, codePos, 0x37, T6, AVX2_ZERO, src, MAP_0F38);
+					emitAVX2(code, codePos, 0xDB, T6, T6, dst, MAP_0F, true);
+					emitAVX2(code, codePos, 0xD4, T5, T5, T6);
+				}
+				emitAVX2Shift(code, codePos, false, T0, dst, 32);
+				emitAVX2Shift(code, codePos, false, T1, src, 32);
+				emitAVX2(code, codePos, 0xF4, T2, dst, src);
+				emitAVX2(code, codePos, 0xF4, T3, T0, src, MAP_0F, true);
+				emitAVX2(code, codePos, 0xF4, T4, dst, T1, MAP_0F, true);
+				emitAVX2(code, codePos, 0xF4, T0, T0, T1);
+				emitAVX2Shift(code, codePos, false, T2, T2, 32);
+				emitAVX2(code, codePos, 0xD4, T3, T3, T2);
+				emitAVX2(code, codePos, 0x02, T2, T3, AVX2_ZERO, MAP_0F3A);
+				emitByte(0xAA, code, codePos);
+				emitAVX2(code, codePos, 0xD4, T4, T4, T2);
+				emitAVX2Shift(code, codePos, false, T3, T3, 32);
+				emitAVX2Shift(code, codePos, false, T4, T4, 32);
+				emitAVX2(code, codePos, 0xD4, T0, T0, T3);
+				if (isSigned) {
+					emitAVX2(code, codePos, 0xD4, T0, T0, T4);
+					emitAVX2(code, codePos, 0xFB, dst, T0, T5);
+				}
+				else {
+					emitAVX2(code, codePos, 0xD4, dst, T0, T4);
+				}
+			}
+			break;
+		case randomx::SuperscalarInstructionType::IMUL_RCP:
+			emitMulConstAVX2(code, codePos, constPos, dst, dst, reciprocalCache[instr.getImm32()], T0, T1);
+			break;
+		default:
+			UNREACHABLE;
+		}
+	}
+
 	template<bool rax>
 	FORCE_INLINE void JitCompilerX86::genAddressReg(const Instruction& instr, uint8_t* code, int& codePos) {
 		const uint32_t src = *((uint32_t*)&instr) & 0xFF0000;
@@ -589,12 +993,18 @@ namespace randomx {
 		*(uint32_t*)(code + codePos) = (rax ? 0x24808d41 : 0x24888d41) + src;
 		codePos += (src == (RegisterNeedsSib << 16)) ? 4 : 3;
 
-		emit32(instr.getImm32(), code, codePos);
-		if (rax)
-			emitByte(AND_EAX_I, code, codePos);
-		else
-			emit(AND_ECX_I, code, codePos);
-		emit32(instr.getModMem() ? ScratchpadL1Mask : ScratchpadL2Mask, code, codePos);
+		*(uint32_t*)(code + codePos) = instr.getImm32();
+		codePos += 4;
+
+		const uint64_t mask = instr.getModMem() ? ScratchpadL1Mask : ScratchpadL2Mask;
+		if (rax) {
+			*(uint64_t*)(code + codePos) = AND_EAX_I | (mask << 8);
+			codePos += 5;
+		}
+		else {
+			*(uint64_t*)(code + codePos) = 0xe181 | (mask << 16);
+			codePos += 6;
+		}
 	}
 
 	template void JitCompilerX86::genAddressReg<false>(const Instruction& instr, uint8_t* code, int& codePos);
@@ -605,14 +1015,11 @@ namespace randomx {
 		*(uint32_t*)(code + codePos) = 0x24808d41 + dst;
 		codePos += (dst == (RegisterNeedsSib << 16)) ? 4 : 3;
 
-		emit32(instr.getImm32(), code, codePos);
-		emitByte(AND_EAX_I, code, codePos);
-		if (instr.getModCond() < StoreL3Condition) {
-			emit32(instr.getModMem() ? ScratchpadL1Mask : ScratchpadL2Mask, code, codePos);
-		}
-		else {
-			emit32(ScratchpadL3Mask, code, codePos);
-		}
+		*(uint32_t*)(code + codePos) = instr.getImm32();
+
+		const uint64_t mask = (instr.getModCond() < StoreL3Condition) ? (instr.getModMem() ? ScratchpadL1Mask : ScratchpadL2Mask) : ScratchpadL3Mask;
+		*(uint64_t*)(code + codePos + 4) = AND_EAX_I | (mask << 8);
+		codePos += 9;
 	}
 
 	FORCE_INLINE void JitCompilerX86::genAddressImm(const Instruction& instr, uint8_t* code, int& codePos) {
@@ -648,16 +1055,16 @@ namespace randomx {
 	void JitCompilerX86::h_IADD_M(const Instruction& instr) {
 		uint8_t* const p = code;
 		int pos = codePos;
-		
+
 		const uint32_t dst = instr.dst;
 		if (instr.src != dst) {
 			genAddressReg<true>(instr, p, pos);
 			emit32(0x0604034c + (dst << 19), p, pos);
 		}
 		else {
-			emit(REX_ADD_RM, p, pos);
-			emitByte(0x86 + (dst << 3), p, pos);
-			genAddressImm(instr, p, pos);
+			*(uint32_t*)(p + pos) = 0x0086034c + (dst << 19);
+			*(uint32_t*)(p + pos + 3) = instr.getImm32() & ScratchpadL3Mask;
+			pos += 7;
 		}
 
 		registerUsage[dst] = pos;
@@ -671,34 +1078,37 @@ namespace randomx {
 	void JitCompilerX86::h_ISUB_R(const Instruction& instr) {
 		uint8_t* const p = code;
 		int pos = codePos;
-		
-		if (instr.src != instr.dst) {
-			emit(REX_SUB_RR, p, pos);
-			emitByte(0xc0 + 8 * instr.dst + instr.src, p, pos);
+
+		const uint32_t src = instr.src;
+		const uint32_t dst = instr.dst;
+
+		if (src != dst) {
+			*(uint32_t*)(p + pos) = 0x00c02b4d + (dst << 19) + (src << 16);
+			pos += 3;
 		}
 		else {
-			emit(REX_81, p, pos);
-			emitByte(0xe8 + instr.dst, p, pos);
-			emit32(instr.getImm32(), p, pos);
+			*(uint32_t*)(p + pos) = 0x00e88149 + (dst << 16);
+			*(uint32_t*)(p + pos + 3) = instr.getImm32();
+			pos += 7;
 		}
 
-		registerUsage[instr.dst] = pos;
+		registerUsage[dst] = pos;
 		codePos = pos;
 	}
 
 	void JitCompilerX86::h_ISUB_M(const Instruction& instr) {
 		uint8_t* const p = code;
 		int pos = codePos;
-		
+
 		const uint32_t dst = instr.dst;
 		if (instr.src != dst) {
 			genAddressReg<true>(instr, p, pos);
 			emit32(0x06042b4c + (dst << 19), p, pos);
 		}
 		else {
-			emit(REX_SUB_RM, p, pos);
-			emitByte(0x86 + (dst << 3), p, pos);
-			genAddressImm(instr, p, pos);
+			*(uint32_t*)(p + pos) = 0x00862b4c + (dst << 19);
+			*(uint32_t*)(p + pos + 3) = instr.getImm32() & ScratchpadL3Mask;
+			pos += 7;
 		}
 
 		registerUsage[dst] = pos;
@@ -708,38 +1118,42 @@ namespace randomx {
 	void JitCompilerX86::h_IMUL_R(const Instruction& instr) {
 		uint8_t* const p = code;
 		int pos = codePos;
-		
-		if (instr.src != instr.dst) {
-			emit(REX_IMUL_RR, p, pos);
-			emitByte(0xc0 + 8 * instr.dst + instr.src, p, pos);
+
+		const uint32_t src = instr.src;
+		const uint32_t dst = instr.dst;
+
+		if (src != dst) {
+			*(uint32_t*)(p + pos) = 0xc0af0f4d + (dst << 27) + (src << 24);
+			pos += 4;
 		}
 		else {
-			emit(REX_IMUL_RRI, p, pos);
-			emitByte(0xc0 + 9 * instr.dst, p, pos);
-			emit32(instr.getImm32(), p, pos);
+			*(uint32_t*)(p + pos) = 0x00c0694d + (dst << 19) + (dst << 16);
+			*(uint32_t*)(p + pos + 3) = instr.getImm32();
+			pos += 7;
 		}
 
-		registerUsage[instr.dst] = pos;
+		registerUsage[dst] = pos;
 		codePos = pos;
 	}
 
 	void JitCompilerX86::h_IMUL_M(const Instruction& instr) {
 		uint8_t* const p = code;
 		int pos = codePos;
-		
-		if (instr.src != instr.dst) {
+
+		const uint64_t dst = instr.dst;
+
+		if (instr.src != dst) {
 			genAddressReg<true>(instr, p, pos);
-			emit(REX_IMUL_RM, p, pos);
-			emitByte(0x04 + 8 * instr.dst, p, pos);
-			emitByte(0x06, p, pos);
+			*(uint64_t*)(p + pos) = 0x0604af0f4cULL + (dst << 27);
+			pos += 5;
 		}
 		else {
-			emit(REX_IMUL_RM, p, pos);
-			emitByte(0x86 + 8 * instr.dst, p, pos);
-			genAddressImm(instr, p, pos);
+			*(uint32_t*)(p + pos) = static_cast<uint32_t>(0x86af0f4c + (dst << 27));
+			*(uint32_t*)(p + pos + 4) = instr.getImm32() & ScratchpadL3Mask;
+			pos += 8;
 		}
 
-		registerUsage[instr.dst] = pos;
+		registerUsage[dst] = pos;
 		codePos = pos;
 	}
 
@@ -747,14 +1161,12 @@ namespace randomx {
 		uint8_t* const p = code;
 		int pos = codePos;
 
-		const uint32_t dst = instr.dst;
+		const uint64_t src = instr.src;
+		const uint64_t dst = instr.dst;
 
-		emit(REX_MOV_RR64, p, pos);
-		emitByte(0xc0 + dst, p, pos);
-		emit(REX_MUL_R, p, pos);
-		emitByte(0xe0 + instr.src, p, pos);
-		emit(REX_MOV_R64R, p, pos);
-		emitByte(0xc2 + 8 * dst, p, pos);
+		*(uint64_t*)(p + pos) = 0x8b4ce0f749c08b49ULL + (dst << 16) + (src << 40);
+		p[pos + 8] = static_cast<uint8_t>(0xc2 + 8 * dst);
+		pos += 9;
 
 		registerUsage[dst] = pos;
 		codePos = pos;
@@ -778,24 +1190,23 @@ namespace randomx {
 	void JitCompilerX86::h_IMULH_M(const Instruction& instr) {
 		uint8_t* const p = code;
 		int pos = codePos;
-		
-		if (instr.src != instr.dst) {
+
+		const uint64_t dst = instr.dst;
+
+		if (instr.src != dst) {
 			genAddressReg<false>(instr, p, pos);
-			emit(REX_MOV_RR64, p, pos);
-			emitByte(0xc0 + instr.dst, p, pos);
-			emit(REX_MUL_MEM, p, pos);
+			*(uint64_t*)(p + pos) = 0x4c0e24f748c08b49ULL + (dst << 16);
+			*(uint32_t*)(p + pos + 8) = static_cast<uint32_t>(0x0000c28b + (dst << 11));
+			pos += 10;
 		}
 		else {
-			emit(REX_MOV_RR64, p, pos);
-			emitByte(0xc0 + instr.dst, p, pos);
-			emit(REX_MUL_M, p, pos);
-			emitByte(0xa6, p, pos);
-			genAddressImm(instr, p, pos);
+			*(uint64_t*)(p + pos) = 0x0000a6f748c08b49ULL + (dst << 16);
+			*(uint32_t*)(p + pos + 6) = instr.getImm32() & ScratchpadL3Mask;
+			*(uint32_t*)(p + pos + 10) = static_cast<uint32_t>(0x00c28b4c + (dst << 19));
+			pos += 13;
 		}
-		emit(REX_MOV_R64R, p, pos);
-		emitByte(0xc2 + 8 * instr.dst, p, pos);
 
-		registerUsage[instr.dst] = pos;
+		registerUsage[dst] = pos;
 		codePos = pos;
 	}
 
@@ -825,53 +1236,55 @@ namespace randomx {
 	void JitCompilerX86::h_ISMULH_R(const Instruction& instr) {
 		uint8_t* const p = code;
 		int pos = codePos;
-		
-		emit(REX_MOV_RR64, p, pos);
-		emitByte(0xc0 + instr.dst, p, pos);
-		emit(REX_MUL_R, p, pos);
-		emitByte(0xe8 + instr.src, p, pos);
-		emit(REX_MOV_R64R, p, pos);
-		emitByte(0xc2 + 8 * instr.dst, p, pos);
-
-		registerUsage[instr.dst] = pos;
+
+		const uint64_t src = instr.src;
+		const uint64_t dst = instr.dst;
+
+		*(uint64_t*)(p + pos) = 0x8b4ce8f749c08b49ULL + (dst << 16) + (src << 40);
+		p[pos + 8] = static_cast<uint8_t>(0xc2 + 8 * dst);
+		pos += 9;
+
+		registerUsage[dst] = pos;
 		codePos = pos;
 	}
 
 	void JitCompilerX86::h_ISMULH_M(const Instruction& instr) {
 		uint8_t* const p = code;
 		int pos = codePos;
-		
-		if (instr.src != instr.dst) {
+
+		const uint64_t dst = instr.dst;
+
+		if (instr.src != dst) {
 			genAddressReg<false>(instr, p, pos);
-			emit(REX_MOV_RR64, p, pos);
-			emitByte(0xc0 + instr.dst, p, pos);
-			emit(REX_IMUL_MEM, p, pos);
+			*(uint64_t*)(p + pos) = 0x4c0e2cf748c08b49ULL + (dst << 16);
+			*(uint32_t*)(p + pos + 8) = static_cast<uint32_t>(0x0000c28b + (dst << 11));
+			pos += 10;
 		}
 		else {
-			emit(REX_MOV_RR64, p, pos);
-			emitByte(0xc0 + instr.dst, p, pos);
-			emit(REX_MUL_M, p, pos);
-			emitByte(0xae, p, pos);
-			genAddressImm(instr, p, pos);
+			*(uint64_t*)(p + pos) = 0x0000aef748c08b49ULL + (dst << 16);
+			*(uint32_t*)(p + pos + 6) = instr.getImm32() & ScratchpadL3Mask;
+			*(uint32_t*)(p + pos + 10) = static_cast<uint32_t>(0x00c28b4c + (dst << 19));
+			pos += 13;
 		}
-		emit(REX_MOV_R64R, p, pos);
-		emitByte(0xc2 + 8 * instr.dst, p, pos);
 
-		registerUsage[instr.dst] = pos;
+		registerUsage[dst] = pos;
 		codePos = pos;
 	}
 
 	void JitCompilerX86::h_IMUL_RCP(const Instruction& instr) {
 		uint8_t* const p = code;
 		int pos = codePos;
-		
+
 		uint64_t divisor = instr.getImm32();
 		if (!isZeroOrPowerOf2(divisor)) {
-			emit(MOV_RAX_I, p, pos);
-			emit64(randomx_reciprocal_fast(divisor), p, pos);
-			emit(REX_IMUL_RM, p, pos);
-			emitByte(0xc0 + 8 * instr.dst, p, pos);
-			registerUsage[instr.dst] = pos;
+			const uint32_t dst = instr.dst;
+
+			*(uint32_t*)(p + pos) = 0x0000b848;
+			*(uint64_t*)(p + pos + 2) = randomx_reciprocal_fast(divisor);
+			*(uint32_t*)(p + pos + 10) = 0xc0af0f4c + (dst << 27);
+			pos += 14;
+
+			registerUsage[dst] = pos;
 		}
 
 		codePos = pos;
@@ -880,69 +1293,74 @@ namespace randomx {
 	void JitCompilerX86::h_INEG_R(const Instruction& instr) {
 		uint8_t* const p = code;
 		int pos = codePos;
-		
-		emit(REX_NEG, p, pos);
-		emitByte(0xd8 + instr.dst, p, pos);
 
-		registerUsage[instr.dst] = pos;
+		const uint32_t dst = instr.dst;
+
+		*(uint32_t*)(p + pos) = 0x00d8f749 + (dst << 16);
+		pos += 3;
+
+		registerUsage[dst] = pos;
 		codePos = pos;
 	}
 
 	void JitCompilerX86::h_IXOR_R(const Instruction& instr) {
 		uint8_t* const p = code;
 		int pos = codePos;
-		
-		if (instr.src != instr.dst) {
-			emit(REX_XOR_RR, p, pos);
-			emitByte(0xc0 + 8 * instr.dst + instr.src, p, pos);
+
+		const uint32_t src = instr.src;
+		const uint32_t dst = instr.dst;
+
+		if (src != dst) {
+			*(uint32_t*)(p + pos) = 0x00c0334d + (dst << 19) + (src << 16);
+			pos += 3;
 		}
 		else {
-			emit(REX_XOR_RI, p, pos);
-			emitByte(0xf0 + instr.dst, p, pos);
-			emit32(instr.getImm32(), p, pos);
+			*(uint32_t*)(p + pos) = 0x00f08149 + (dst << 16);
+			*(uint32_t*)(p + pos + 3) = instr.getImm32();
+			pos += 7;
 		}
 
-		registerUsage[instr.dst] = pos;
+		registerUsage[dst] = pos;
 		codePos = pos;
 	}
 
 	void JitCompilerX86::h_IXOR_M(const Instruction& instr) {
 		uint8_t* const p = code;
 		int pos = codePos;
-		
-		if (instr.src != instr.dst) {
+
+		const uint32_t dst = instr.dst;
+
+		if (instr.src != dst) {
 			genAddressReg<true>(instr, p, pos);
-			emit(REX_XOR_RM, p, pos);
-			emitByte(0x04 + 8 * instr.dst, p, pos);
-			emitByte(0x06, p, pos);
+			emit32(0x0604334c + (dst << 19), p, pos);
 		}
 		else {
-			emit(REX_XOR_RM, p, pos);
-			emitByte(0x86 + 8 * instr.dst, p, pos);
-			genAddressImm(instr, p, pos);
+			*(uint32_t*)(p + pos) = 0x0086334c + (dst << 19);
+			*(uint32_t*)(p + pos + 3) = instr.getImm32() & ScratchpadL3Mask;
+			pos += 7;
 		}
 
-		registerUsage[instr.dst] = pos;
+		registerUsage[dst] = pos;
 		codePos = pos;
 	}
 
 	void JitCompilerX86::h_IROR_R(const Instruction& instr) {
 		uint8_t* const p = code;
 		int pos = codePos;
-		
-		if (instr.src != instr.dst) {
-			emit(REX_MOV_RR, p, pos);
-			emitByte(0xc8 + instr.src, p, pos);
-			emit(REX_ROT_CL, p, pos);
-			emitByte(0xc8 + instr.dst, p, pos);
+
+		const uint64_t src = instr.src;
+		const uint64_t dst = instr.dst;
+
+		if (src != dst) {
+			*(uint64_t*)(p + pos) = 0x0000c8d349c88b41ULL + (src << 16) + (dst << 40);
+			pos += 6;
 		}
 		else {
-			emit(REX_ROT_I8, p, pos);
-			emitByte(0xc8 + instr.dst, p, pos);
-			emitByte(instr.getImm32() & 63, p, pos);
+			*(uint32_t*)(p + pos) = static_cast<uint32_t>(0x00c8c149 + (dst << 16) + ((instr.getImm32() & 63) << 24));
+			pos += 4;
 		}
 
-		registerUsage[instr.dst] = pos;
+		registerUsage[dst] = pos;
 		codePos = pos;
 	}
 
@@ -950,31 +1368,35 @@ namespace randomx {
 		uint8_t* const p = code;
 		int pos = codePos;
 
-		if (instr.src != instr.dst) {
-			emit(REX_MOV_RR, p, pos);
-			emitByte(0xc8 + instr.src, p, pos);
-			emit(REX_ROT_CL, p, pos);
-			emitByte(0xc0 + instr.dst, p, pos);
+		const uint64_t src = instr.src;
+		const uint64_t dst = instr.dst;
+
+		if (src != dst) {
+			*(uint64_t*)(p + pos) = 0x0000c0d349c88b41ULL + (src << 16) + (dst << 40);
+			pos += 6;
 		}
 		else {
-			emit(REX_ROT_I8, p, pos);
-			emitByte(0xc0 + instr.dst, p, pos);
-			emitByte(instr.getImm32() & 63, p, pos);
+			*(uint32_t*)(p + pos) = static_cast<uint32_t>(0x00c0c149 + (dst << 16) + ((instr.getImm32() & 63) << 24));
+			pos += 4;
 		}
 
-		registerUsage[instr.dst] = pos;
+		registerUsage[dst] = pos;
 		codePos = pos;
 	}
 
 	void JitCompilerX86::h_ISWAP_R(const Instruction& instr) {
 		uint8_t* const p = code;
 		int pos = codePos;
-		
-		if (instr.src != instr.dst) {
-			emit(REX_XCHG, p, pos);
-			emitByte(0xc0 + instr.src + 8 * instr.dst, p, pos);
-			registerUsage[instr.dst] = pos;
-			registerUsage[instr.src] = pos;
+
+		const uint32_t src = instr.src;
+		const uint32_t dst = instr.dst;
+
+		if (src != dst) {
+			*(uint32_t*)(p + pos) = 0x00c0874d + (dst << 19) + (src << 16);
+			pos += 3;
+
+			registerUsage[dst] = pos;
+			registerUsage[src] = pos;
 		}
 
 		codePos = pos;
@@ -983,10 +1405,11 @@ namespace randomx {
 	void JitCompilerX86::h_FSWAP_R(const Instruction& instr) {
 		uint8_t* const p = code;
 		int pos = codePos;
-		
-		emit(SHUFPD, p, pos);
-		emitByte(0xc0 + 9 * instr.dst, p, pos);
-		emitByte(1, p, pos);
+
+		const uint64_t dst = instr.dst;
+
+		*(uint64_t*)(p + pos) = 0x01c0c60f66ULL + (dst << 27) + (dst << 24);
+		pos += 5;
 
 		codePos = pos;
 	}
@@ -995,10 +1418,11 @@ namespace randomx {
 		uint8_t* const p = code;
 		int pos = codePos;
 
-		const uint32_t dst = instr.dst % RegisterCountFlt;
-		const uint32_t src = instr.src % RegisterCountFlt;
-		emit(REX_ADDPD, p, pos);
-		emitByte(0xc0 + src + 8 * dst, p, pos);
+		const uint64_t dst = instr.dst % RegisterCountFlt;
+		const uint64_t src = instr.src % RegisterCountFlt;
+
+		*(uint64_t*)(p + pos) = 0xc0580f4166ULL + (dst << 35) + (src << 32);
+		pos += 5;
 
 		codePos = pos;
 	}
@@ -1006,12 +1430,13 @@ namespace randomx {
 	void JitCompilerX86::h_FADD_M(const Instruction& instr) {
 		uint8_t* const p = code;
 		int pos = codePos;
-		
+
 		const uint32_t dst = instr.dst % RegisterCountFlt;
+
 		genAddressReg<true>(instr, p, pos);
-		emit(REX_CVTDQ2PD_XMM12, p, pos);
-		emit(REX_ADDPD, p, pos);
-		emitByte(0xc4 + 8 * dst, p, pos);
+		*(uint64_t*)(p + pos) = 0x41660624e60f44f3ULL;
+		*(uint32_t*)(p + pos + 8) = 0x00c4580f + (dst << 19);
+		pos += 11;
 
 		codePos = pos;
 	}
@@ -1019,11 +1444,12 @@ namespace randomx {
 	void JitCompilerX86::h_FSUB_R(const Instruction& instr) {
 		uint8_t* const p = code;
 		int pos = codePos;
-		
-		const uint32_t dst = instr.dst % RegisterCountFlt;
-		const uint32_t src = instr.src % RegisterCountFlt;
-		emit(REX_SUBPD, p, pos);
-		emitByte(0xc0 + src + 8 * dst, p, pos);
+
+		const uint64_t dst = instr.dst % RegisterCountFlt;
+		const uint64_t src = instr.src % RegisterCountFlt;
+
+		*(uint64_t*)(p + pos) = 0xc05c0f4166ULL + (dst << 35) + (src << 32);
+		pos += 5;
 
 		codePos = pos;
 	}
@@ -1031,12 +1457,13 @@ namespace randomx {
 	void JitCompilerX86::h_FSUB_M(const Instruction& instr) {
 		uint8_t* const p = code;
 		int pos = codePos;
-		
+
 		const uint32_t dst = instr.dst % RegisterCountFlt;
+
 		genAddressReg<true>(instr, p, pos);
-		emit(REX_CVTDQ2PD_XMM12, p, pos);
-		emit(REX_SUBPD, p, pos);
-		emitByte(0xc4 + 8 * dst, p, pos);
+		*(uint64_t*)(p + pos) = 0x41660624e60f44f3ULL;
+		*(uint32_t*)(p + pos + 8) = 0x00c45c0f + (dst << 19);
+		pos += 11;
 
 		codePos = pos;
 	}
@@ -1044,10 +1471,11 @@ namespace randomx {
 	void JitCompilerX86::h_FSCAL_R(const Instruction& instr) {
 		uint8_t* const p = code;
 		int pos = codePos;
-		
+
 		const uint32_t dst = instr.dst % RegisterCountFlt;
-		emit(REX_XORPS, p, pos);
-		emitByte(0xc7 + 8 * dst, p, pos);
+
+		*(uint32_t*)(p + pos) = 0xc7570f41 + (dst << 27);
+		pos += 4;
 
 		codePos = pos;
 	}
@@ -1055,11 +1483,12 @@ namespace randomx {
 	void JitCompilerX86::h_FMUL_R(const Instruction& instr) {
 		uint8_t* const p = code;
 		int pos = codePos;
-		
-		const uint32_t dst = instr.dst % RegisterCountFlt;
-		const uint32_t src = instr.src % RegisterCountFlt;
-		emit(REX_MULPD, p, pos);
-		emitByte(0xe0 + src + 8 * dst, p, pos);
+
+		const uint64_t dst = instr.dst % RegisterCountFlt;
+		const uint64_t src = instr.src % RegisterCountFlt;
+
+		*(uint64_t*)(p + pos) = 0xe0590f4166ULL + (dst << 35) + (src << 32);
+		pos += 5;
 
 		codePos = pos;
 	}
@@ -1067,18 +1496,21 @@ namespace randomx {
 	void JitCompilerX86::h_FDIV_M(const Instruction& instr) {
 		uint8_t* const p = code;
 		int pos = codePos;
-		
-		const uint32_t dst = instr.dst % RegisterCountFlt;
+
+		const uint64_t dst = instr.dst % RegisterCountFlt;
+
 		genAddressReg<true>(instr, p, pos);
-		emit(REX_CVTDQ2PD_XMM12, p, pos);
+		*(uint64_t*)(p + pos) = 0x00000624e60f44f3ULL;
 		if (hasXOP) {
-			emit(REX_VPCMOV_XMM12, p, pos);
+			*(uint64_t*)(p + pos + 6) = 0x0000d0e6a218488fULL;
+			pos += 12;
 		}
 		else {
-			emit(REX_ANDPS_XMM12, p, pos);
+			*(uint64_t*)(p + pos + 6) = 0xe6560f45e5540f45ULL;
+			pos += 14;
 		}
-		emit(REX_DIVPD, p, pos);
-		emitByte(0xe4 + 8 * dst, p, pos);
+		*(uint64_t*)(p + pos) = 0xe45e0f4166ULL + (dst << 35);
+		pos += 5;
 
 		codePos = pos;
 	}
@@ -1086,10 +1518,11 @@ namespace randomx {
 	void JitCompilerX86::h_FSQRT_R(const Instruction& instr) {
 		uint8_t* const p = code;
 		int pos = codePos;
-		
+
 		const uint32_t dst = instr.dst % RegisterCountFlt;
-		emit(SQRTPD, p, pos);
-		emitByte(0xe4 + 9 * dst, p, pos);
+
+		*(uint32_t*)(p + pos) = 0xe4510f66 + (dst << 27) + (dst << 24);
+		pos += 4;
 
 		codePos = pos;
 	}
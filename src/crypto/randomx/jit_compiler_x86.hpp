@@ -45,21 +45,27 @@ namespace randomx {
 
 	constexpr uint32_t CodeSize = 64 * 1024;
 
+	// AVX2 dataset initialization code and its 32-byte constants follow the regular code of the cache's compiler
+	constexpr uint32_t DatasetInitAVX2CodeSize = 384 * 1024;
+	constexpr uint32_t DatasetInitAVX2ConstSize = 256 * 1024;
+
 	class JitCompilerX86 {
 	public:
-		JitCompilerX86();
+		explicit JitCompilerX86(bool optimizedDatasetInit = false);
 		~JitCompilerX86();
-		void prepare();
 		void generateProgram(Program&, ProgramConfiguration&, uint32_t);
 		void generateProgramLight(Program&, ProgramConfiguration&, uint32_t);
 		template<size_t N>
 		void generateSuperscalarHash(SuperscalarProgram (&programs)[N], std::vector<uint64_t> &);
 		void generateDatasetInitCode();
 		ProgramFunc* getProgramFunc() {
-			return (ProgramFunc*)code;
+			return (ProgramFunc*)codeExec;
 		}
 		DatasetInitFunc* getDatasetInitFunc() {
-			return (DatasetInitFunc*)code;
+			return (DatasetInitFunc*)codeExec;
+		}
+		DatasetInitFunc* getDatasetInitAVX2Func() {
+			return initDatasetAVX2 ? (DatasetInitFunc*)(codeExec + CodeSize) : nullptr;
 		}
 		uint8_t* getCode() {
 			return code;
@@ -69,7 +75,11 @@ namespace randomx {
 		alignas(64) static InstructionGeneratorX86 engine[256];
 		int registerUsage[RegistersCount];
 		uint8_t* allocatedCode;
+		uint8_t* allocatedCodeExec;
+		size_t allocatedSize;
+		// Generated code is written through code and executed through codeExec (same address unless the buffer is W^X double mapped)
 		uint8_t* code;
+		uint8_t* codeExec;
 #		ifdef XMRIG_FIX_RYZEN
 		std::pair<const void*, const void*> mainLoopBounds;
 #		endif
@@ -80,6 +90,7 @@ namespace randomx {
 		static bool BranchesWithin32B;
 		bool hasAVX;
 		bool hasXOP;
+		bool initDatasetAVX2;
 
 		static void applyTweaks();
 		void generateProgramPrologue(Program&, ProgramConfiguration&);
@@ -91,6 +102,9 @@ namespace randomx {
 		static void genSIB(int scale, int index, int base, uint8_t* code, int& codePos);
 
 		void generateSuperscalarCode(Instruction &, std::vector<uint64_t> &);
+		template<size_t N>
+		bool generateSuperscalarHashAVX2(SuperscalarProgram (&programs)[N], std::vector<uint64_t> &);
+		void generateSuperscalarCodeAVX2(Instruction &, std::vector<uint64_t> &, int& constPos);
 
 		static void emitByte(uint8_t val, uint8_t* code, int& codePos) {
 			code[codePos] = val;
@@ -34,6 +34,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "crypto/randomx/vm_compiled.hpp"
 #include "crypto/randomx/vm_compiled_light.hpp"
 #include "crypto/randomx/blake2/blake2.h"
+#include "crypto/randomx/blake2_generator.hpp"
+#include "crypto/randomx/program.hpp"
 
 #if defined(_M_X64) || defined(__x86_64__)
 #include "crypto/randomx/jit_compiler_x86_static.hpp"
@@ -43,13 +45,26 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 #include "backend/cpu/Cpu.h"
+#include "crypto/rx/BbpBlake256.h"
+#include "crypto/rx/RxProfiler.h"
 #include <cassert>
+#include <chrono>
+#include <vector>
 
 
-extern "C"
-{
-#include "crypto/cn/c_blake256.h"
-}
+#ifdef __SSE2__
+using rx_float_state = uint32_t;
+
+static inline void rx_save_float_state(rx_float_state &state)          { state = _mm_getcsr(); }
+static inline void rx_restore_float_state(const rx_float_state &state) { _mm_setcsr(state); }
+#else
+#include <cfenv>
+
+using rx_float_state = fenv_t;
+
+static inline void rx_save_float_state(rx_float_state &state)          { fegetenv(&state); }
+static inline void rx_restore_float_state(const rx_float_state &state) { fesetenv(&state); }
+#endif
 
 
 
@@ -339,10 +354,11 @@ extern "C" {
 					break;
 
 				case RANDOMX_FLAG_JIT:
-					cache->jit          = new randomx::JitCompiler();
+					cache->jit          = new randomx::JitCompiler(xmrig::Cpu::info()->hasAVX2());
 					cache->initialize   = &randomx::initCacheCompile;
 					cache->datasetInit  = cache->jit->getDatasetInitFunc();
 					cache->memory       = memory;
+					cache->datasetInitKind = RANDOMX_DATASET_INIT_JIT;
 					break;
 
 				default:
@@ -365,6 +381,28 @@ extern "C" {
 		cache->initialize(cache, key, keySize);
 	}
 
+	void randomx_restore_cache(randomx_cache *cache, const void *key, size_t keySize) {
+		assert(cache != nullptr);
+		assert(keySize == 0 || key != nullptr);
+		randomx::initCachePrograms(cache, key, keySize);
+
+		if (cache->jit) {
+			cache->jit->generateSuperscalarHash(cache->programs, cache->reciprocalCache);
+			cache->jit->generateDatasetInitCode();
+			randomx::selectDatasetInit(cache);
+		}
+	}
+
+	randomx_dataset_init_kind randomx_get_dataset_init_kind(randomx_cache *cache) {
+		assert(cache != nullptr);
+		return cache->datasetInitKind;
+	}
+
+	void *randomx_get_cache_memory(randomx_cache *cache) {
+		assert(cache != nullptr);
+		return cache->memory;
+	}
+
 	void randomx_release_cache(randomx_cache* cache) {
 		delete cache;
 	}
@@ -526,21 +564,16 @@ extern "C" {
 			// BiblePay's randomx hash is a 160 byte solution to an equation.  
 			// Part A of the equation is the solution to an actual RandomX hash in any RandomX coin (or pool), while part B is the BlakeHash(BBP_PrevBlockHash + RandomX Hash) equals < BBP_Current_Block_Difficulty
 			// Note that part B must contain the prior BBP blockhash to solve.
-			uint8_t uOut[64] = { 0x0 };
 			// First get the RandomX VM's final hash of the RX-coin's header:
-			machine->getFinalResult(uOut, RANDOMX_HASH_SIZE);
-			memcpy(output, uOut, RANDOMX_HASH_SIZE);
-			// Construct the equations output buffer (must be zero padded as we enforce the zeroes)
-			uint8_t uBBPIn[160] = { 0x0 };
+			machine->getFinalResult(output, RANDOMX_HASH_SIZE);
+			// The equation input is 160 bytes, zero padded as we enforce the zeroes:
 			// The BBP Previous block hash goes in position 0-31, then the RandomX hash that solves the BBP Equation in 32-64:
-			memcpy(uBBPIn + 32, uOut, 32);
-			memcpy(uBBPIn, bbp_prev_hash, 32);
 			// We leave some extra space between 65-160 in case RandomX hashes enlarge, or the solution enlarges later.
 			// Next, we blake hash the output, resulting in the Biblepay block hash for the next best block:
 			// The blakehash difficulty target must be less than the BBP diff target of the *next block*
 			// Note: Since we require the original RandomX hash to be proven, and the BBP prior blockhash must be in the equation, this prevents pre-mining BBP blocks.
 			// This also ensures BBPs chain is equally as hard to mine with a standalone RandomX miner (than the dual hash affords).
-			blake256_hash(out_bbphash, uBBPIn, 160);
+			xmrig::BbpBlake256::hash(static_cast<const uint8_t*>(bbp_prev_hash), static_cast<const uint8_t*>(output), out_bbphash);
 			// This blakehash is what BBP uses to secure the chain as of March 2020.
 			
 		}
@@ -559,14 +592,19 @@ extern "C" {
 
 	void randomx_calculate_hash_next(randomx_vm* machine, uint64_t (&tempHash)[8], const void* nextInput, size_t nextInputSize, void* output) 
 	{
+		RX_PROFILE_HASH();
+
 		machine->resetRoundingMode();
 		for (uint32_t chain = 0; chain < RandomX_CurrentConfig.ProgramCount - 1; ++chain) {
 			machine->run(&tempHash);
+
+			RX_PROFILE_SCOPE(REGISTER_HASH);
 			rx_blake2b(tempHash, sizeof(tempHash), machine->getRegisterFile(), sizeof(randomx::RegisterFile), nullptr, 0);
 		}
 		machine->run(&tempHash);
 
 		// Finish current hash and fill the scratchpad for the next hash at the same time
+		RX_PROFILE_SCOPE(HASH_AND_FILL);
 		rx_blake2b(tempHash, sizeof(tempHash), nextInput, nextInputSize, nullptr, 0);
 		machine->hashAndFill(output, RANDOMX_HASH_SIZE, tempHash);
 	}
@@ -578,28 +616,195 @@ extern "C" {
 		assert(nextInputSize == 0 || nextInput != nullptr);
 		assert(output != nullptr);
 
+		RX_PROFILE_HASH();
+
 		machine->resetRoundingMode();
 		for (uint32_t chain = 0; chain < RandomX_CurrentConfig.ProgramCount - 1; ++chain) {
 			machine->run(&tempHash);
+
+			RX_PROFILE_SCOPE(REGISTER_HASH);
 			rx_blake2b(tempHash, sizeof(tempHash), machine->getRegisterFile(), sizeof(randomx::RegisterFile), nullptr, 0);
 		}
 		machine->run(&tempHash);
 		// Finish current hash and fill the scratchpad for the next hash at the same time
-		rx_blake2b(tempHash, sizeof(tempHash), nextInput, nextInputSize, nullptr, 0);
-		uint8_t uOut[64] = { 0x0 };
-		machine->hashAndFill(output, RANDOMX_HASH_SIZE, tempHash);
-		memcpy(uOut, output, RANDOMX_HASH_SIZE);
-		// Construct the equations output buffer (must be zero padded as we enforce the zeroes)
-		uint8_t uBBPIn[160] = { 0x0 };
+		{
+			RX_PROFILE_SCOPE(HASH_AND_FILL);
+			rx_blake2b(tempHash, sizeof(tempHash), nextInput, nextInputSize, nullptr, 0);
+			machine->hashAndFill(output, RANDOMX_HASH_SIZE, tempHash);
+		}
+		// The equation input is 160 bytes, zero padded as we enforce the zeroes:
 		// The BBP Previous block hash goes in position 0-31, then the RandomX hash that solves the BBP Equation in 32-64:
-		memcpy(uBBPIn + 32, uOut, 32);
-		memcpy(uBBPIn, bbp_prev_hash, 32);
 		// We leave some extra space between 65-160 in case RandomX hashes enlarge, or the solution enlarges later.
 		// Next, we blake hash the output, resulting in the Biblepay block hash for the next best block:
 		// The blakehash difficulty target must be less than the BBP diff target of the *next block*
 		// Note: Since we require the original RandomX hash to be proven, and the BBP prior blockhash must be in the equation, this prevents pre-mining BBP blocks.
 		// This also ensures BBPs chain is equally as hard to mine with a standalone RandomX miner (than the dual hash affords).
-		blake256_hash(out_bbphash, uBBPIn, 160);
+		RX_PROFILE_SCOPE(BBP_BLAKE256);
+		xmrig::BbpBlake256::hash(static_cast<const uint8_t*>(bbp_prev_hash), static_cast<const uint8_t*>(output), out_bbphash);
 		// This blakehash is what BBP uses to secure the chain as of March 2020.
 	}
+
+	static void initBenchmarkPrograms(randomx::Blake2Generator& gen, std::vector<randomx::Program>& programs, std::vector<randomx::ProgramConfiguration>& configs) {
+		for (size_t i = 0; i < programs.size(); ++i) {
+			uint32_t* words = reinterpret_cast<uint32_t*>(&programs[i]);
+			for (size_t j = 0; j < sizeof(randomx::Program) / sizeof(uint32_t); ++j) {
+				words[j] = gen.getUInt32();
+			}
+
+			randomx::ProgramConfiguration& config = configs[i];
+			config.readReg0 = 0 + (gen.getByte() & 1);
+			config.readReg1 = 2 + (gen.getByte() & 1);
+			config.readReg2 = 4 + (gen.getByte() & 1);
+			config.readReg3 = 6 + (gen.getByte() & 1);
+			config.eMask[0] = programs[i].getEntropy(14);
+			config.eMask[1] = programs[i].getEntropy(15);
+		}
+	}
+
+	double randomx_jit_benchmark(randomx_flags flags, uint32_t count) {
+		constexpr uint32_t programCount = 16;
+
+		randomx::JitCompiler* jit = nullptr;
+		try {
+			jit = new randomx::JitCompiler();
+		}
+		catch (std::exception&) {
+			return 0.0;
+		}
+
+		std::vector<randomx::Program> programs(programCount);
+		std::vector<randomx::ProgramConfiguration> configs(programCount);
+
+		static const char seed[] = "RandomX JIT benchmark";
+		randomx::Blake2Generator gen(seed, sizeof(seed));
+		initBenchmarkPrograms(gen, programs, configs);
+
+		// Warm up the code buffer and the instruction handlers.
+		for (uint32_t i = 0; i < programCount; ++i) {
+			jit->generateProgram(programs[i], configs[i], flags);
+		}
+
+		// The programs are split into rounds of programCount and the fastest round is reported,
+		// so a preempted round does not skew the result.
+		double best = 0.0;
+		for (uint32_t n = 0; n < count; n += programCount) {
+			const auto start = std::chrono::steady_clock::now();
+
+			for (uint32_t i = 0; i < programCount; ++i) {
+				jit->generateProgram(programs[i], configs[i], flags);
+			}
+
+			const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			if (best == 0.0 || elapsed < best) {
+				best = elapsed;
+			}
+		}
+
+		delete jit;
+
+		return best > 0.0 ? programCount / best : 0.0;
+	}
+
+	double randomx_interpreter_benchmark(uint32_t count, int threaded) {
+		constexpr uint32_t programCount = 16;
+
+		std::vector<randomx::Program> programs(programCount);
+		std::vector<randomx::ProgramConfiguration> configs(programCount);
+
+		static const char seed[] = "RandomX interpreter benchmark";
+		randomx::Blake2Generator gen(seed, sizeof(seed));
+		initBenchmarkPrograms(gen, programs, configs);
+
+		// Scratchpad and registers hold pseudo-random data, as they do after the first program iteration of a hash.
+		std::vector<uint64_t> scratchpad(RandomX_CurrentConfig.ScratchpadL3_Size / sizeof(uint64_t));
+		for (uint64_t& word : scratchpad) {
+			word = (static_cast<uint64_t>(gen.getUInt32()) << 32) | gen.getUInt32();
+		}
+
+		randomx::NativeRegisterFile nreg;
+		for (unsigned i = 0; i < randomx::RegisterCountFlt; ++i) {
+			nreg.a[i] = rx_cvt_packed_int_vec_f128(&scratchpad[i]);
+		}
+
+		std::vector<randomx::InstructionByteCode> bytecode(programCount * RANDOMX_PROGRAM_MAX_SIZE);
+		randomx::BytecodeMachine machine;
+		for (uint32_t i = 0; i < programCount; ++i) {
+			machine.compileProgram(programs[i], &bytecode[i * RANDOMX_PROGRAM_MAX_SIZE], nreg);
+		}
+
+		auto execute = threaded ? &randomx::BytecodeMachine::executeBytecodeThreaded : &randomx::BytecodeMachine::executeBytecode;
+		uint8_t* memory = reinterpret_cast<uint8_t*>(scratchpad.data());
+
+		rx_float_state float_state;
+		rx_save_float_state(float_state);
+
+		// Every program is run with the registers loaded the same way the VM loads them before each iteration.
+		auto run = [&](uint32_t i) {
+			for (unsigned r = 0; r < randomx::RegistersCount; ++r) {
+				nreg.r[r] = scratchpad[i * randomx::RegistersCount + r];
+			}
+			for (unsigned r = 0; r < randomx::RegisterCountFlt; ++r) {
+				nreg.f[r] = rx_cvt_packed_int_vec_f128(&scratchpad[i * randomx::RegistersCount + r]);
+				nreg.e[r] = rx_cvt_packed_int_vec_f128(&scratchpad[i * randomx::RegistersCount + randomx::RegisterCountFlt + r]);
+			}
+
+			rx_reset_float_state();
+			execute(&bytecode[i * RANDOMX_PROGRAM_MAX_SIZE], memory, configs[i]);
+		};
+
+		for (uint32_t i = 0; i < programCount; ++i) {
+			run(i);
+		}
+
+		double best = 0.0;
+		for (uint32_t n = 0; n < count; n += programCount) {
+			const auto start = std::chrono::steady_clock::now();
+
+			for (uint32_t i = 0; i < programCount; ++i) {
+				run(i);
+			}
+
+			const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			if (best == 0.0 || elapsed < best) {
+				best = elapsed;
+			}
+		}
+
+		rx_restore_float_state(float_state);
+
+		return best > 0.0 ? programCount / best : 0.0;
+	}
+
+	double randomx_cache_init_benchmark(uint32_t count, int reference) {
+		using Allocator = randomx::AlignedAllocator<randomx::CacheLineSize>;
+
+		uint8_t* memory = nullptr;
+		try {
+			memory = static_cast<uint8_t*>(Allocator::allocMemory(RANDOMX_CACHE_MAX_SIZE));
+		}
+		catch (std::exception&) {
+			return 0.0;
+		}
+
+		static const char seed[] = "RandomX cache benchmark";
+
+		// First fill only faults the memory in, the cache is the same 256 MB for every round.
+		randomx::fillCache(memory, seed, sizeof(seed), reference != 0);
+
+		double best = 0.0;
+		for (uint32_t n = 0; n < count; ++n) {
+			const auto start = std::chrono::steady_clock::now();
+
+			randomx::fillCache(memory, seed, sizeof(seed), reference != 0);
+
+			const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			if (best == 0.0 || elapsed < best) {
+				best = elapsed;
+			}
+		}
+
+		Allocator::freeMemory(memory, RANDOMX_CACHE_MAX_SIZE);
+
+		return best * 1000.0;
+	}
 }
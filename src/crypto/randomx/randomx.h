@@ -53,6 +53,14 @@ enum randomx_flags {
 };
 
 
+enum randomx_dataset_init_kind {
+  RANDOMX_DATASET_INIT_INTERPRETED = 0,
+  RANDOMX_DATASET_INIT_JIT = 1,
+  RANDOMX_DATASET_INIT_AVX2 = 2,
+  RANDOMX_DATASET_INIT_AVX2_MISMATCH = 3,
+};
+
+
 struct randomx_dataset;
 struct randomx_cache;
 class randomx_vm;
@@ -230,6 +238,37 @@ RANDOMX_EXPORT randomx_cache *randomx_create_cache(randomx_flags flags, uint8_t
 */
 RANDOMX_EXPORT void randomx_init_cache(randomx_cache *cache, const void *key, size_t keySize);
 
+/**
+ * Initializes SuperscalarHash for a cache whose memory was already filled by
+ * randomx_init_cache with the same key (for example restored from disk).
+ * The Argon2 fill is skipped.
+ *
+ * @param cache is a pointer to a previously allocated randomx_cache structure. Must not be NULL.
+ * @param key is a pointer to memory which contains the key value. Must not be NULL.
+ * @param keySize is the number of bytes of the key.
+*/
+RANDOMX_EXPORT void randomx_restore_cache(randomx_cache *cache, const void *key, size_t keySize);
+
+/**
+ * Returns a pointer to the internal memory buffer of the cache structure. The size
+ * of the internal memory buffer is RANDOMX_CACHE_MAX_SIZE.
+ *
+ * @param cache is a pointer to a previously allocated randomx_cache structure. Must not be NULL.
+ *
+ * @return Pointer to the internal memory buffer of the cache structure.
+*/
+RANDOMX_EXPORT void *randomx_get_cache_memory(randomx_cache *cache);
+
+/**
+ * Returns the Dataset initialization code selected for the cache by the last key change.
+ * On x86-64 CPUs with AVX2 the JIT cache computes 4 Dataset items per pass; that code is checked
+ * bit-for-bit against the scalar JIT code after compilation and RANDOMX_DATASET_INIT_AVX2_MISMATCH
+ * is returned when the check failed and the scalar code is used instead.
+ *
+ * @param cache is a pointer to a previously allocated randomx_cache structure. Must not be NULL.
+*/
+RANDOMX_EXPORT randomx_dataset_init_kind randomx_get_dataset_init_kind(randomx_cache *cache);
+
 /**
  * Releases all memory occupied by the randomx_cache structure.
  *
@@ -351,6 +390,41 @@ RANDOMX_EXPORT void randomx_calculate_hash_first(randomx_vm* machine, uint64_t (
 RANDOMX_EXPORT void randomx_calculate_hash_next(randomx_vm* machine, uint64_t (&tempHash)[8], const void* nextInput, size_t nextInputSize, void* output);
 RANDOMX_EXPORT void randomx_calculate_hash_next_dual(randomx_vm* machine, const void* bbp_prev_hash, uint8_t out_bbphash[], uint64_t(&tempHash)[8], const void* nextInput, size_t nextInputSize, void* output);
 
+/**
+ * Measures the JIT compiler alone: compiles a fixed set of pseudo-random programs into a private
+ * code buffer without executing them, in rounds until count programs are compiled.
+ *
+ * @param flags are the VM flags the programs are compiled for (RANDOMX_FLAG_AMD selects the Ryzen dataset read code).
+ * @param count is the number of programs to compile.
+ *
+ * @return Programs compiled per second in the fastest round or 0 if JIT compilation is not supported
+ *         on the current platform.
+*/
+RANDOMX_EXPORT double randomx_jit_benchmark(randomx_flags flags, uint32_t count);
+
+/**
+ * Measures the bytecode interpreter alone: compiles a fixed set of pseudo-random programs to bytecode
+ * and executes them over a pseudo-random scratchpad, in rounds until count programs are executed.
+ *
+ * @param count is the number of programs to execute.
+ * @param threaded selects the computed goto dispatch (1) or the switch based one (0).
+ *
+ * @return Programs executed per second in the fastest round.
+*/
+RANDOMX_EXPORT double randomx_interpreter_benchmark(uint32_t count, int threaded);
+
+/**
+ * Measures the Argon2 fill of the cache memory alone (no superscalar programs), in count rounds
+ * over a private 256 MiB buffer with a fixed key.
+ *
+ * @param count is the number of rounds.
+ * @param reference selects the portable reference fill (1) or the SIMD fill_segment kernels
+ *        selected by argon2::Impl (0).
+ *
+ * @return Milliseconds of the fastest round or 0 if the memory could not be allocated.
+*/
+RANDOMX_EXPORT double randomx_cache_init_benchmark(uint32_t count, int reference);
+
 #if defined(__cplusplus)
 }
 #endif
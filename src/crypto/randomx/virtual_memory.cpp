@@ -26,13 +26,19 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <atomic>
 #include <stdexcept>
 
 
+#include "base/io/log/Log.h"
 #include "crypto/common/VirtualMemory.h"
 #include "crypto/randomx/virtual_memory.hpp"
 
 
+// Set once the OS refused a writable and executable mapping (SELinux deny_execmem, PaX MPROTECT, etc.).
+static std::atomic<bool> jitDualMapped{ false };
+
+
 void* allocExecutableMemory(std::size_t bytes) {
     void *mem = xmrig::VirtualMemory::allocateExecutableMemory(bytes);
     if (mem == nullptr) {
@@ -43,6 +49,31 @@ void* allocExecutableMemory(std::size_t bytes) {
 }
 
 
+// Returns the view the JIT compiler writes to, *exec receives the view the generated code runs from.
+// Both are the same RWX mapping unless it is denied, then two views (RW and RX) of one shared memory object are used.
+void* allocJitMemory(std::size_t bytes, void** exec) {
+    if (!jitDualMapped.load(std::memory_order_relaxed)) {
+        void *mem = xmrig::VirtualMemory::allocateExecutableMemory(bytes);
+        if (mem) {
+            *exec = mem;
+
+            return mem;
+        }
+
+        if (!jitDualMapped.exchange(true)) {
+            LOG_WARN(BLUE_BG(WHITE_BOLD_S " rx  ") " " YELLOW_BOLD("RWX memory denied, JIT switched to W^X double mapping"));
+        }
+    }
+
+    void *mem = xmrig::VirtualMemory::allocateDualMappedMemory(bytes, exec);
+    if (mem == nullptr) {
+        throw std::runtime_error("Failed to allocate executable memory");
+    }
+
+    return mem;
+}
+
+
 void* allocLargePagesMemory(std::size_t bytes) {
     void *mem = xmrig::VirtualMemory::allocateLargePagesMemory(bytes);
     if (mem == nullptr) {
@@ -56,3 +87,13 @@ void* allocLargePagesMemory(std::size_t bytes) {
 void freePagedMemory(void* ptr, std::size_t bytes) {
     xmrig::VirtualMemory::freeLargePagesMemory(ptr, bytes);
 }
+
+
+void freeJitMemory(void* ptr, void* exec, std::size_t bytes) {
+    if (exec == ptr) {
+        xmrig::VirtualMemory::freeLargePagesMemory(ptr, bytes);
+    }
+    else {
+        xmrig::VirtualMemory::freeDualMappedMemory(ptr, exec, bytes);
+    }
+}
@@ -31,5 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cstddef>
 
 void* allocExecutableMemory(std::size_t);
+void* allocJitMemory(std::size_t, void**);
 void* allocLargePagesMemory(std::size_t);
 void freePagedMemory(void*, std::size_t);
+void freeJitMemory(void*, void*, std::size_t);
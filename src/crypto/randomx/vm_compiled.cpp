@@ -28,6 +28,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "crypto/randomx/vm_compiled.hpp"
 #include "crypto/randomx/common.hpp"
+#include "crypto/rx/RxProfiler.h"
 
 namespace randomx {
 
@@ -41,11 +42,17 @@ namespace randomx {
 
 	template<bool softAes>
 	void CompiledVm<softAes>::run(void* seed) {
-		compiler.prepare();
-		VmBase<softAes>::generateProgram(seed);
-		randomx_vm::initialize();
-		compiler.generateProgram(program, config, randomx_vm::getFlags());
+		{
+			RX_PROFILE_SCOPE(PROGRAM);
+			VmBase<softAes>::generateProgram(seed);
+			randomx_vm::initialize();
+		}
+		{
+			RX_PROFILE_SCOPE(JIT);
+			compiler.generateProgram(program, config, randomx_vm::getFlags());
+		}
 		mem.memory = datasetPtr->memory + datasetOffset;
+		RX_PROFILE_SCOPE(EXECUTE);
 		execute();
 	}
 
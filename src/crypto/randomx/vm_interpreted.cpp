@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "crypto/randomx/dataset.hpp"
 #include "crypto/randomx/intrin_portable.h"
 #include "crypto/randomx/reciprocal.h"
+#include "crypto/rx/RxProfiler.h"
 
 namespace randomx {
 
@@ -41,8 +42,12 @@ namespace randomx {
 
 	template<bool softAes>
 	void InterpretedVm<softAes>::run(void* seed) {
-		VmBase<softAes>::generateProgram(seed);
-		randomx_vm::initialize();
+		{
+			RX_PROFILE_SCOPE(PROGRAM);
+			VmBase<softAes>::generateProgram(seed);
+			randomx_vm::initialize();
+		}
+		RX_PROFILE_SCOPE(EXECUTE);
 		execute();
 	}
 
@@ -75,7 +80,7 @@ namespace randomx {
 			for (unsigned i = 0; i < RegisterCountFlt; ++i)
 				nreg.e[i] = maskRegisterExponentMantissa(config, rx_cvt_packed_int_vec_f128(scratchpad + spAddr1 + 8 * (RegisterCountFlt + i)));
 
-			executeBytecode(bytecode, scratchpad, config);
+			executeBytecodeThreaded(bytecode, scratchpad, config);
 
 			mem.mx ^= nreg.r[config.readReg2] ^ nreg.r[config.readReg3];
 			mem.mx &= CacheLineAlignMask;
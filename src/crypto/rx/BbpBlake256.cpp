@@ -0,0 +1,165 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <cstring>
+
+
+#include "crypto/rx/BbpBlake256.h"
+#include "backend/common/Tags.h"
+#include "base/io/log/Log.h"
+#include "crypto/rx/BbpBlake256_impl.h"
+
+
+extern "C"
+{
+#include "crypto/cn/c_blake256.h"
+}
+
+
+namespace xmrig {
+
+
+BbpBlake256::Id BbpBlake256::m_id = BbpBlake256::SCALAR;
+
+
+static const char *kNames[] = { "scalar", "reference" };
+
+
+struct OpsScalar
+{
+    using V = uint32_t;
+
+    static inline V add(V a, V b)       { return a + b; }
+    static inline V xor_(V a, V b)      { return a ^ b; }
+    static inline V set1(uint32_t x)    { return x; }
+    static inline V rotr16(V x)         { return (x >> 16) | (x << 16); }
+    static inline V rotr12(V x)         { return (x >> 12) | (x << 20); }
+    static inline V rotr8(V x)          { return (x >> 8)  | (x << 24); }
+    static inline V rotr7(V x)          { return (x >> 7)  | (x << 25); }
+};
+
+
+} // namespace xmrig
+
+
+void xmrig::BbpBlake256::init()
+{
+    m_id = SCALAR;
+
+    if (!verify()) {
+        m_id = REFERENCE;
+
+        LOG_ERR("%s" RED("BBP blake256 %s self-test failed, use %s implementation"), rx_tag(), kNames[SCALAR], name());
+
+        return;
+    }
+
+    LOG_VERBOSE("%s" WHITE_BOLD("BBP blake256 ") CYAN_BOLD("%s"), rx_tag(), name());
+}
+
+
+const char *xmrig::BbpBlake256::name()
+{
+    return kNames[m_id];
+}
+
+
+void xmrig::BbpBlake256::hash(const uint8_t *prevHash, const uint8_t *rxHash, uint8_t *out)
+{
+    if (m_id == REFERENCE) {
+        uint8_t input[kInputSize]{};
+        memcpy(input, prevHash, 32);
+        memcpy(input + 32, rxHash, 32);
+
+        blake256_hash(out, input, sizeof(input));
+
+        return;
+    }
+
+    hash1(prevHash, rxHash, out);
+}
+
+
+void xmrig::BbpBlake256::hash1(const uint8_t *prevHash, const uint8_t *rxHash, uint8_t *out)
+{
+    uint32_t m[16];
+    uint32_t h[8];
+
+    for (int i = 0; i < 8; ++i) {
+        m[i]     = bbp::load32be(prevHash + i * 4);
+        m[8 + i] = bbp::load32be(rxHash + i * 4);
+    }
+
+    bbp::hash<OpsScalar>(m, h);
+
+    for (int i = 0; i < 8; ++i) {
+        const uint32_t x = bbp::bswap32(h[i]);
+        memcpy(out + i * 4, &x, sizeof(x));
+    }
+}
+
+
+bool xmrig::BbpBlake256::verify()
+{
+    constexpr size_t count = 8;
+
+    uint8_t prevHash[32];
+    uint8_t rxHash[count * 32];
+    uint8_t out[count * 32];
+    uint8_t input[kInputSize]{};
+    uint8_t ref[32];
+    uint32_t x = 0x9E3779B9;
+
+    auto next = [&x]() {
+        x = x * 1664525 + 1013904223;
+
+        return static_cast<uint8_t>(x >> 24);
+    };
+
+    for (auto &b : prevHash) {
+        b = next();
+    }
+
+    for (auto &b : rxHash) {
+        b = next();
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        hash1(prevHash, rxHash + i * 32, out + i * 32);
+    }
+
+    memcpy(input, prevHash, sizeof(prevHash));
+
+    for (size_t i = 0; i < count; ++i) {
+        memcpy(input + 32, rxHash + i * 32, 32);
+        blake256_hash(ref, input, sizeof(input));
+
+        if (memcmp(ref, out + i * 32, sizeof(ref)) != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,65 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_BBPBLAKE256_H
+#define XMRIG_BBPBLAKE256_H
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace xmrig
+{
+
+
+class BbpBlake256
+{
+public:
+    enum Id : uint32_t {
+        SCALAR,
+        REFERENCE
+    };
+
+    constexpr static size_t kInputSize = 160;
+
+    // Checks the scalar kernel against the reference c_blake256 code, falls back to c_blake256 itself if it does not match.
+    static void init();
+    static const char *name();
+
+    // BLAKE-256 of [prevHash (32) | rxHash (32) | zeros (96)].
+    static void hash(const uint8_t *prevHash, const uint8_t *rxHash, uint8_t *out);
+
+private:
+    static void hash1(const uint8_t *prevHash, const uint8_t *rxHash, uint8_t *out);
+    static bool verify();
+
+    static Id m_id;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_BBPBLAKE256_H */
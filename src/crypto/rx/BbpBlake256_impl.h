@@ -0,0 +1,208 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_BBPBLAKE256_IMPL_H
+#define XMRIG_BBPBLAKE256_IMPL_H
+
+
+#include <cstdint>
+
+
+// BLAKE-256 of the fixed BBP input [prev hash (32) | RandomX hash (32) | zeros (96)].
+//
+// 160 bytes are always 3 compressions with counters 512, 1024 and 1280 bits, only the first block depends on
+// the input, the second block is all zeros and the third one contains just the padding and the message length.
+// Rounds are unrolled at compile time, so message schedule indexes are constants and the message words of the two
+// fixed blocks fold into immediates.
+namespace xmrig {
+namespace bbp {
+
+
+static constexpr uint8_t kSigma[14][16] = {
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15},
+    {14,10, 4, 8, 9,15,13, 6, 1,12, 0, 2,11, 7, 5, 3},
+    {11, 8,12, 0, 5, 2,15,13,10,14, 3, 6, 7, 1, 9, 4},
+    { 7, 9, 3, 1,13,12,11,14, 2, 6, 5,10, 4, 0,15, 8},
+    { 9, 0, 5, 7, 2, 4,10,15,14, 1,11,12, 6, 8, 3,13},
+    { 2,12, 6,10, 0,11, 8, 3, 4,13, 7, 5,15,14, 1, 9},
+    {12, 5, 1,15,14,13, 4,10, 0, 7, 6, 3, 9, 2, 8,11},
+    {13,11, 7,14,12, 1, 3, 9, 5, 0,15, 4, 8, 6, 2,10},
+    { 6,15,14, 9,11, 3, 0, 8,12, 2,13, 7, 1, 4,10, 5},
+    {10, 2, 8, 4, 7, 6, 1, 5,15,11, 9,14, 3,12,13, 0},
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15},
+    {14,10, 4, 8, 9,15,13, 6, 1,12, 0, 2,11, 7, 5, 3},
+    {11, 8,12, 0, 5, 2,15,13,10,14, 3, 6, 7, 1, 9, 4},
+    { 7, 9, 3, 1,13,12,11,14, 2, 6, 5,10, 4, 0,15, 8}
+};
+
+
+static constexpr uint32_t kCst[16] = {
+    0x243F6A88, 0x85A308D3, 0x13198A2E, 0x03707344,
+    0xA4093822, 0x299F31D0, 0x082EFA98, 0xEC4E6C89,
+    0x452821E6, 0x38D01377, 0xBE5466CF, 0x34E90C6C,
+    0xC0AC29B7, 0xC97C50DD, 0x3F84D5B5, 0xB5470917
+};
+
+
+static const uint32_t kIV[8] = {
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+    0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+};
+
+
+// Third block: 0x80 padding right after the 32 remaining zero bytes, 0x01 end marker and 1280 bits message length.
+static constexpr uint32_t kLastBlock[16] = {
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0x80000000, 0, 0, 0, 0, 0x00000001, 0, 160 * 8
+};
+
+
+static inline uint32_t bswap32(uint32_t x)
+{
+    return (x >> 24) | ((x >> 8) & 0xFF00) | ((x << 8) & 0xFF0000) | (x << 24);
+}
+
+
+static inline uint32_t load32be(const uint8_t *p)
+{
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) | (static_cast<uint32_t>(p[2]) << 8) | p[3];
+}
+
+
+enum Block {
+    INPUT_BLOCK,
+    ZERO_BLOCK,
+    LAST_BLOCK
+};
+
+
+// Message word e of round r xored with its round constant.
+template<typename Ops, Block B, int r, int e, typename V = typename Ops::V>
+struct Word
+{
+    static inline V get(const V *m) { return Ops::xor_(m[kSigma[r][e]], Ops::set1(kCst[kSigma[r][e ^ 1]])); }
+};
+
+
+template<typename Ops, int r, int e, typename V>
+struct Word<Ops, ZERO_BLOCK, r, e, V>
+{
+    static inline V get(const V *) { return Ops::set1(kCst[kSigma[r][e ^ 1]]); }
+};
+
+
+template<typename Ops, int r, int e, typename V>
+struct Word<Ops, LAST_BLOCK, r, e, V>
+{
+    static inline V get(const V *) { return Ops::set1(kLastBlock[kSigma[r][e]] ^ kCst[kSigma[r][e ^ 1]]); }
+};
+
+
+template<typename Ops, Block B, int r, int a, int b, int c, int d, int e, typename V = typename Ops::V>
+static inline void G(V *v, const V *m)
+{
+    v[a] = Ops::add(Ops::add(v[a], v[b]), Word<Ops, B, r, e>::get(m));
+    v[d] = Ops::rotr16(Ops::xor_(v[d], v[a]));
+    v[c] = Ops::add(v[c], v[d]);
+    v[b] = Ops::rotr12(Ops::xor_(v[b], v[c]));
+    v[a] = Ops::add(Ops::add(v[a], v[b]), Word<Ops, B, r, e + 1>::get(m));
+    v[d] = Ops::rotr8(Ops::xor_(v[d], v[a]));
+    v[c] = Ops::add(v[c], v[d]);
+    v[b] = Ops::rotr7(Ops::xor_(v[b], v[c]));
+}
+
+
+template<typename Ops, Block B, int r>
+struct Rounds
+{
+    template<typename V>
+    static inline void run(V *v, const V *m)
+    {
+        G<Ops, B, r, 0, 4,  8, 12,  0>(v, m);
+        G<Ops, B, r, 1, 5,  9, 13,  2>(v, m);
+        G<Ops, B, r, 2, 6, 10, 14,  4>(v, m);
+        G<Ops, B, r, 3, 7, 11, 15,  6>(v, m);
+        G<Ops, B, r, 3, 4,  9, 14, 14>(v, m);
+        G<Ops, B, r, 2, 7,  8, 13, 12>(v, m);
+        G<Ops, B, r, 0, 5, 10, 15,  8>(v, m);
+        G<Ops, B, r, 1, 6, 11, 12, 10>(v, m);
+
+        Rounds<Ops, B, r + 1>::run(v, m);
+    }
+};
+
+
+template<typename Ops, Block B>
+struct Rounds<Ops, B, 14>
+{
+    template<typename V>
+    static inline void run(V *, const V *) {}
+};
+
+
+template<typename Ops, Block B, typename V = typename Ops::V>
+static inline void compress(V *h, const V *m, uint32_t t)
+{
+    V v[16];
+
+    for (int i = 0; i < 8; ++i) {
+        v[i] = h[i];
+    }
+
+    for (int i = 0; i < 4; ++i) {
+        v[i + 8] = Ops::set1(kCst[i]);
+    }
+
+    v[12] = Ops::set1(kCst[4] ^ t);
+    v[13] = Ops::set1(kCst[5] ^ t);
+    v[14] = Ops::set1(kCst[6]);
+    v[15] = Ops::set1(kCst[7]);
+
+    Rounds<Ops, B, 0>::run(v, m);
+
+    for (int i = 0; i < 8; ++i) {
+        h[i] = Ops::xor_(h[i], Ops::xor_(v[i], v[i + 8]));
+    }
+}
+
+
+// m[0..7] must hold the big endian words of the prev hash, m[8..15] the words of the RandomX hashes, h receives the digest words.
+template<typename Ops, typename V = typename Ops::V>
+static inline void hash(const V *m, V *h)
+{
+    for (int i = 0; i < 8; ++i) {
+        h[i] = Ops::set1(kIV[i]);
+    }
+
+    compress<Ops, INPUT_BLOCK>(h, m, 512);
+    compress<Ops, ZERO_BLOCK>(h, m, 1024);
+    compress<Ops, LAST_BLOCK>(h, m, 1280);
+}
+
+
+} // namespace bbp
+} // namespace xmrig
+
+
+#endif /* XMRIG_BBPBLAKE256_IMPL_H */
@@ -29,10 +29,15 @@
 #include "backend/common/Tags.h"
 #include "backend/cpu/CpuConfig.h"
 #include "base/io/log/Log.h"
+#include "crypto/rx/BbpBlake256.h"
 #include "crypto/rx/RxConfig.h"
+#include "crypto/rx/RxDataset.h"
 #include "crypto/rx/RxQueue.h"
 
 
+#include <algorithm>
+
+
 namespace xmrig {
 
 
@@ -73,7 +78,11 @@ bool xmrig::Rx::init(const Job &job, const RxConfig &config, const CpuConfig &cp
         return true;
     }
 
+    d_ptr->queue.promote(job);
+
     if (isReady(job)) {
+        prefetch(job, config, cpu);
+
         return true;
     }
 
@@ -87,12 +96,26 @@ bool xmrig::Rx::init(const Job &job, const RxConfig &config, const CpuConfig &cp
         osInitialized = true;
     }
 
-    d_ptr->queue.enqueue(job, config.nodeset(), config.threads(cpu.limit()), cpu.isHugePages(), config.isOneGbPages(), config.mode(), cpu.priority());
+    d_ptr->queue.enqueue(job, config.nodeset(), config.threads(cpu.limit()), cpu.isHugePages(), config.isOneGbPages(), config.mode(), cpu.priority(), config.cacheDir());
+    prefetch(job, config, cpu);
 
     return false;
 }
 
 
+void xmrig::Rx::prefetch(const Job &job, const RxConfig &config, const CpuConfig &cpu)
+{
+    if (job.nextSeed().size() != job.seed().size() || job.nextSeed() == job.seed() || config.mode() == RxConfig::LightMode) {
+        return;
+    }
+
+    // Low priority, the miner threads keep running while the next dataset is built from spare cycles.
+    const int priority = cpu.priority() >= 0 ? std::min(cpu.priority(), 1) : 1;
+
+    d_ptr->queue.prefetch(RxSeed(job.algorithm(), job.nextSeed()), config.nodeset(), config.threads(cpu.limit()), cpu.isHugePages(), config.isOneGbPages(), config.mode(), priority, config.cacheDir());
+}
+
+
 bool xmrig::Rx::isReady(const Job &job)
 {
     return d_ptr->queue.isReady(job);
@@ -105,6 +128,13 @@ xmrig::HugePagesInfo xmrig::Rx::hugePages()
 }
 
 
+xmrig::RxTimings xmrig::Rx::timings()
+{
+    return d_ptr->queue.timings();
+}
+
+
+// The dataset is held by the caller until Rx::release(), a held dataset is never reused for the next seed.
 xmrig::RxDataset *xmrig::Rx::dataset(const Job &job, uint32_t nodeId)
 {
     return d_ptr->queue.dataset(job, nodeId);
@@ -126,6 +156,16 @@ void xmrig::Rx::destroy()
 void xmrig::Rx::init(IRxListener *listener)
 {
     d_ptr = new RxPrivate(listener);
+
+    BbpBlake256::init();
+}
+
+
+void xmrig::Rx::release(RxDataset *dataset)
+{
+    if (dataset) {
+        dataset->release();
+    }
 }
 
 
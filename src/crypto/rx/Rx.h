@@ -33,6 +33,7 @@
 
 
 #include "crypto/common/HugePagesInfo.h"
+#include "crypto/rx/RxTimings.h"
 
 
 namespace xmrig
@@ -53,9 +54,11 @@ public:
     static bool init(const Job &job, const RxConfig &config, const CpuConfig &cpu);
     static bool isReady(const Job &job);
     static HugePagesInfo hugePages();
+    static RxTimings timings();
     static RxDataset *dataset(const Job &job, uint32_t nodeId);
     static void destroy();
     static void init(IRxListener *listener);
+    static void release(RxDataset *dataset);
 
 #   ifdef XMRIG_FIX_RYZEN
     static void setMainLoopBounds(const std::pair<const void*, const void*>& bounds);
@@ -64,6 +67,7 @@ public:
 private:
     static void msrInit(const RxConfig &config);
     static void msrDestroy();
+    static void prefetch(const Job &job, const RxConfig &config, const CpuConfig &cpu);
     static void setupMainLoopExceptionFrame();
 };
 
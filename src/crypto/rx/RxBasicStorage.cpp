@@ -33,9 +33,15 @@
 #include "crypto/rx/RxAlgo.h"
 #include "crypto/rx/RxCache.h"
 #include "crypto/rx/RxDataset.h"
+#include "crypto/rx/RxDatasetCache.h"
 #include "crypto/rx/RxSeed.h"
 
 
+#include <chrono>
+#include <thread>
+#include <uv.h>
+
+
 namespace xmrig {
 
 
@@ -48,10 +54,12 @@ public:
     XMRIG_DISABLE_COPY_MOVE(RxBasicStoragePrivate)
 
     inline RxBasicStoragePrivate() = default;
-    inline ~RxBasicStoragePrivate() { deleteDataset(); }
+    inline ~RxBasicStoragePrivate() { deleteDataset(); delete m_next; }
 
     inline bool isReady(const Job &job) const   { return m_ready && m_seed == job; }
     inline RxDataset *dataset() const           { return m_dataset; }
+    inline RxDataset *next() const              { return m_next; }
+    inline const RxTimings &timings() const     { return m_timings; }
     inline void deleteDataset()                 { delete m_dataset; m_dataset = nullptr; }
 
 
@@ -80,25 +88,152 @@ public:
             return false;
         }
 
+        m_timings.allocate = Chrono::steadyMSecs() - ts;
+
         printAllocStatus(ts);
 
         return true;
     }
 
 
-    inline void initDataset(uint32_t threads, int priority)
+    inline void initDataset(uint32_t threads, int priority, const String &cacheDir)
     {
+        m_timings.reset();
+        m_unsaved = nullptr;
+
         const uint64_t ts = Chrono::steadyMSecs();
 
-        m_ready = m_dataset->init(m_seed.data(), threads, priority);
+        if (RxDatasetCache::load(cacheDir, m_seed, m_dataset)) {
+            m_timings.load = Chrono::steadyMSecs() - ts;
+            m_ready        = true;
+
+            return;
+        }
+
+        m_dataset->cache()->init(m_seed.data());
+        m_timings.cache = Chrono::steadyMSecs() - ts;
+
+        const uint64_t computeTs = Chrono::steadyMSecs();
+        m_ready                  = m_dataset->init(m_seed.data(), threads, priority);
+        m_timings.compute        = Chrono::steadyMSecs() - computeTs;
 
         if (m_ready) {
             LOG_INFO("%s" GREEN_BOLD("dataset ready") BLACK_BOLD(" (%" PRIu64 " ms)"), rx_tag(), Chrono::steadyMSecs() - ts);
+
+            setUnsaved(m_dataset, m_seed, cacheDir);
+        }
+    }
+
+
+    inline bool prefetch(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority, const String &cacheDir, const std::atomic<bool> &abort)
+    {
+        if (!m_ready || !m_dataset->get() || m_seed.algorithm() != seed.algorithm()) {
+            return false;
+        }
+
+        if (m_nextReady && m_nextSeed == seed) {
+            return true;
+        }
+
+        if (!m_next && !createNext(hugePages, oneGbPages, mode)) {
+            return false;
+        }
+
+        // After a switch the spare slot holds the previous dataset, workers still on the old job keep hashing with it.
+        while (m_next->isUsed()) {
+            if (abort) {
+                return false;
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        m_nextReady = false;
+        m_nextSeed  = seed;
+        m_unsaved   = nullptr;
+
+        if (RxDatasetCache::load(cacheDir, m_nextSeed, m_next)) {
+            m_nextReady = true;
+
+            return true;
+        }
+
+        const uint64_t ts = Chrono::steadyMSecs();
+
+        m_nextReady = m_next->init(m_nextSeed.data(), threads, priority, &abort);
+
+        if (m_nextReady) {
+            LOG_INFO("%s" GREEN_BOLD("next dataset ready") BLACK_BOLD(" (%" PRIu64 " ms)"), rx_tag(), Chrono::steadyMSecs() - ts);
+
+            setUnsaved(m_next, m_nextSeed, cacheDir);
+        }
+
+        return m_nextReady;
+    }
+
+
+    // Called by the queue thread after the workers got the dataset, the pointer stays valid across swap().
+    inline bool save(const String &cacheDir, const std::atomic<bool> &abort)
+    {
+        const RxDataset *dataset = m_unsaved;
+        m_unsaved                = nullptr;
+
+        return dataset && !cacheDir.isEmpty() && RxDatasetCache::save(cacheDir, m_unsavedSeed, dataset, abort);
+    }
+
+
+    inline bool swap(const RxSeed &seed)
+    {
+        if (!m_nextReady || !(m_nextSeed == seed)) {
+            return false;
         }
+
+        std::swap(m_dataset, m_next);
+        std::swap(m_seed, m_nextSeed);
+        std::swap(m_ready, m_nextReady);
+
+        return true;
     }
 
 
 private:
+    inline void setUnsaved(const RxDataset *dataset, const RxSeed &seed, const String &cacheDir)
+    {
+        if (!cacheDir.isEmpty()) {
+            m_unsaved     = dataset;
+            m_unsavedSeed = seed;
+        }
+    }
+
+
+    bool createNext(bool hugePages, bool oneGbPages, RxConfig::Mode mode)
+    {
+        // Only use memory that is really spare, the second slot must never push the system into swap.
+        constexpr uint64_t margin = 256 * oneMiB;
+        const uint64_t required   = RxDataset::maxSize() + RxCache::maxSize() + margin;
+        const uint64_t free       = uv_get_free_memory();
+
+        if (free < required) {
+            LOG_WARN("%s" YELLOW_BOLD("not enough free memory to prepare the next dataset") BLACK_BOLD(" (%" PRIu64 "/%" PRIu64 " MB)"), rx_tag(), free / oneMiB, required / oneMiB);
+
+            return false;
+        }
+
+        auto dataset = new RxDataset(hugePages, oneGbPages, true, mode, 0);
+        if (!dataset->get() || !dataset->cache()->get()) {
+            delete dataset;
+
+            LOG_WARN("%s" YELLOW_BOLD("failed to allocate memory for the next dataset"), rx_tag());
+
+            return false;
+        }
+
+        m_next = dataset;
+
+        return true;
+    }
+
+
     void printAllocStatus(uint64_t ts)
     {
         if (m_dataset->get() != nullptr) {
@@ -123,9 +258,15 @@ private:
     }
 
 
-    bool m_ready         = false;
-    RxDataset *m_dataset = nullptr;
+    bool m_nextReady           = false;
+    bool m_ready               = false;
+    const RxDataset *m_unsaved = nullptr;
+    RxDataset *m_dataset       = nullptr;
+    RxDataset *m_next          = nullptr;
+    RxSeed m_nextSeed;
     RxSeed m_seed;
+    RxSeed m_unsavedSeed;
+    RxTimings m_timings;
 };
 
 
@@ -156,7 +297,13 @@ xmrig::HugePagesInfo xmrig::RxBasicStorage::hugePages() const
         return {};
     }
 
-    return d_ptr->dataset()->hugePages();
+    auto pages = d_ptr->dataset()->hugePages();
+
+    if (d_ptr->next()) {
+        pages += d_ptr->next()->hugePages();
+    }
+
+    return pages;
 }
 
 
@@ -170,7 +317,31 @@ xmrig::RxDataset *xmrig::RxBasicStorage::dataset(const Job &job, uint32_t) const
 }
 
 
-void xmrig::RxBasicStorage::init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority)
+bool xmrig::RxBasicStorage::prefetch(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority, const String &cacheDir, const std::atomic<bool> &abort)
+{
+    return d_ptr->prefetch(seed, threads, hugePages, oneGbPages, mode, priority, cacheDir, abort);
+}
+
+
+bool xmrig::RxBasicStorage::swap(const RxSeed &seed)
+{
+    return d_ptr->swap(seed);
+}
+
+
+bool xmrig::RxBasicStorage::save(const String &cacheDir, const std::atomic<bool> &abort)
+{
+    return d_ptr->save(cacheDir, abort);
+}
+
+
+xmrig::RxTimings xmrig::RxBasicStorage::timings() const
+{
+    return d_ptr->timings();
+}
+
+
+void xmrig::RxBasicStorage::init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority, const String &cacheDir)
 {
     d_ptr->setSeed(seed);
 
@@ -178,5 +349,5 @@ void xmrig::RxBasicStorage::init(const RxSeed &seed, uint32_t threads, bool huge
         return;
     }
 
-    d_ptr->initDataset(threads, priority);
+    d_ptr->initDataset(threads, priority, cacheDir);
 }
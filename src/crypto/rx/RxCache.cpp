@@ -30,6 +30,9 @@
 #include "crypto/randomx/randomx.h"
 
 
+#include <cstring>
+
+
 static_assert(RANDOMX_FLAG_JIT == 8, "RANDOMX_FLAG_JIT flag mismatch");
 
 
@@ -78,6 +81,25 @@ xmrig::HugePagesInfo xmrig::RxCache::hugePages() const
 }
 
 
+void *xmrig::RxCache::raw() const
+{
+    return m_cache ? randomx_get_cache_memory(m_cache) : nullptr;
+}
+
+
+void xmrig::RxCache::setRaw(const Buffer &seed, const void *raw)
+{
+    if (!m_cache) {
+        return;
+    }
+
+    memcpy(randomx_get_cache_memory(m_cache), raw, maxSize());
+    randomx_restore_cache(m_cache, seed.data(), seed.size());
+
+    m_seed = seed;
+}
+
+
 void xmrig::RxCache::create(uint8_t *memory)
 {
     if (!memory) {
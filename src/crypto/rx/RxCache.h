@@ -60,6 +60,8 @@ public:
 
     bool init(const Buffer &seed);
     HugePagesInfo hugePages() const;
+    void *raw() const;
+    void setRaw(const Buffer &seed, const void *raw);
 
     static inline constexpr size_t maxSize() { return RANDOMX_CACHE_MAX_SIZE; }
 
@@ -46,6 +46,7 @@
 
 namespace xmrig {
 
+static const char *kCacheDir    = "cache-dir";
 static const char *kInit        = "init";
 static const char *kMode        = "mode";
 static const char *kOneGbPages  = "1gb-pages";
@@ -84,6 +85,7 @@ bool xmrig::RxConfig::read(const rapidjson::Value &value)
         m_threads    = Json::getInt(value, kInit, m_threads);
         m_mode       = readMode(Json::getValue(value, kMode));
         m_rdmsr      = Json::getBool(value, kRdmsr, m_rdmsr);
+        m_cacheDir   = Json::getString(value, kCacheDir);
 
 #       ifdef XMRIG_FEATURE_MSR
         readMSR(Json::getValue(value, kWrmsr));
@@ -132,6 +134,7 @@ rapidjson::Value xmrig::RxConfig::toJSON(rapidjson::Document &doc) const
     obj.AddMember(StringRef(kMode),         StringRef(modeName()), allocator);
     obj.AddMember(StringRef(kOneGbPages),   m_oneGbPages, allocator);
     obj.AddMember(StringRef(kRdmsr),        m_rdmsr, allocator);
+    obj.AddMember(StringRef(kCacheDir),     m_cacheDir.toJSON(), allocator);
 
 #   ifdef XMRIG_FEATURE_MSR
     if (!m_msrPreset.empty()) {
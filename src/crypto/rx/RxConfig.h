@@ -26,6 +26,7 @@
 #define XMRIG_RXCONFIG_H
 
 
+#include "base/tools/String.h"
 #include "rapidjson/fwd.h"
 
 
@@ -63,6 +64,7 @@ public:
     uint32_t threads(uint32_t limit = 100) const;
 
     inline bool isOneGbPages() const    { return m_oneGbPages; }
+    inline const String &cacheDir() const { return m_cacheDir; }
     inline bool rdmsr() const           { return m_rdmsr; }
     inline bool wrmsr() const           { return m_wrmsr; }
     inline Mode mode() const            { return m_mode; }
@@ -90,6 +92,7 @@ private:
     bool m_rdmsr        = true;
     int m_threads       = -1;
     Mode m_mode         = AutoMode;
+    String m_cacheDir;
 
 #   ifdef XMRIG_FEATURE_HWLOC
     std::vector<uint32_t> m_nodeset;
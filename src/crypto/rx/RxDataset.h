@@ -36,6 +36,9 @@
 #include "crypto/rx/RxConfig.h"
 
 
+#include <atomic>
+
+
 struct randomx_dataset;
 
 
@@ -57,11 +60,14 @@ public:
     RxDataset(RxCache *cache);
     ~RxDataset();
 
+    inline bool isUsed() const              { return m_users.load() > 0; }
     inline randomx_dataset *get() const     { return m_dataset; }
     inline RxCache *cache() const           { return m_cache; }
+    inline void acquire()                   { m_users.fetch_add(1); }
+    inline void release()                   { m_users.fetch_sub(1); }
     inline void setCache(RxCache *cache)    { m_cache = cache; }
 
-    bool init(const Buffer &seed, uint32_t numThreads, int priority);
+    bool init(const Buffer &seed, uint32_t numThreads, int priority, const std::atomic<bool> *abort = nullptr);
     bool isHugePages() const;
     bool isOneGbPages() const;
     HugePagesInfo hugePages(bool cache = true) const;
@@ -78,6 +84,7 @@ private:
     const uint32_t m_node;
     randomx_dataset *m_dataset  = nullptr;
     RxCache *m_cache            = nullptr;
+    std::atomic<uint32_t> m_users{0};
     VirtualMemory *m_memory     = nullptr;
 };
 
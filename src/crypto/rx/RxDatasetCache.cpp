@@ -0,0 +1,477 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "crypto/rx/RxDatasetCache.h"
+#include "backend/common/Tags.h"
+#include "base/io/log/Log.h"
+#include "base/kernel/Env.h"
+#include "base/tools/Chrono.h"
+#include "base/tools/Object.h"
+#include "crypto/rx/RxCache.h"
+#include "crypto/rx/RxDataset.h"
+#include "crypto/rx/RxSeed.h"
+
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <uv.h>
+#include <vector>
+
+
+#ifdef _WIN32
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+
+namespace xmrig {
+
+
+static const char kMagic[8]     = { 'X', 'M', 'R', 'I', 'G', 'R', 'X', 'D' };
+constexpr uint32_t kVersion     = 1;
+constexpr size_t kHeaderSize    = 4096;
+constexpr size_t kMaxSeedSize   = 64;
+constexpr size_t kWriteChunk    = 64 * 1024 * 1024;
+constexpr uint64_t kPrime1      = 11400714785074694791ULL;
+constexpr uint64_t kPrime2      = 14029467366897019727ULL;
+constexpr uint64_t kPrime3      = 1609587929392839161ULL;
+
+
+struct RxDatasetCacheHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t algorithm;
+    uint64_t seedSize;
+    uint8_t seed[kMaxSeedSize];
+    uint64_t cacheSize;
+    uint64_t datasetSize;
+    uint64_t checksum;
+};
+
+
+static_assert(sizeof(RxDatasetCacheHeader) <= kHeaderSize, "RxDatasetCacheHeader must fit into the header page");
+
+
+// 4 lane multiply-rotate hash (xxHash64 rounds), fast enough to run at memory speed over the whole dataset.
+// Sizes passed to update() must be multiples of 32 bytes, which holds for both the cache and the dataset.
+class RxChecksum
+{
+public:
+    inline void update(const void *data, size_t size)
+    {
+        auto p = static_cast<const uint64_t *>(data);
+
+        for (size_t i = 0; i < size / 32; ++i, p += 4) {
+            m_lanes[0] = round(m_lanes[0], p[0]);
+            m_lanes[1] = round(m_lanes[1], p[1]);
+            m_lanes[2] = round(m_lanes[2], p[2]);
+            m_lanes[3] = round(m_lanes[3], p[3]);
+        }
+
+        m_size += size;
+    }
+
+
+    inline uint64_t digest() const
+    {
+        uint64_t h = rotl(m_lanes[0], 1) + rotl(m_lanes[1], 7) + rotl(m_lanes[2], 12) + rotl(m_lanes[3], 18);
+        h ^= m_size;
+        h ^= h >> 33;
+        h *= kPrime2;
+        h ^= h >> 29;
+        h *= kPrime3;
+        h ^= h >> 32;
+
+        return h;
+    }
+
+private:
+    static inline uint64_t rotl(uint64_t x, int r)                  { return (x << r) | (x >> (64 - r)); }
+    static inline uint64_t round(uint64_t acc, uint64_t input)      { return rotl(acc + input * kPrime2, 31) * kPrime1; }
+
+    uint64_t m_lanes[4] = { kPrime1 + kPrime2, kPrime2, 0, 0 - kPrime1 };
+    uint64_t m_size     = 0;
+};
+
+
+class RxMappedFile
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(RxMappedFile)
+
+#   ifdef _WIN32
+    inline RxMappedFile(const char *fileName)
+    {
+        HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return;
+        }
+
+        LARGE_INTEGER size;
+        HANDLE mapping = GetFileSizeEx(file, &size) ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+        if (mapping) {
+            m_data = static_cast<const uint8_t *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            m_size = m_data ? static_cast<size_t>(size.QuadPart) : 0;
+
+            CloseHandle(mapping);
+        }
+
+        CloseHandle(file);
+    }
+
+
+    inline ~RxMappedFile()
+    {
+        if (m_data) {
+            UnmapViewOfFile(m_data);
+        }
+    }
+#   else
+    inline RxMappedFile(const char *fileName)
+    {
+        m_fd = open(fileName, O_RDONLY);
+        if (m_fd < 0) {
+            return;
+        }
+
+        struct stat st{};
+        if (fstat(m_fd, &st) == 0 && st.st_size > 0) {
+            void *data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, m_fd, 0);
+            if (data != MAP_FAILED) {
+                madvise(data, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+
+                m_data = static_cast<const uint8_t *>(data);
+                m_size = static_cast<size_t>(st.st_size);
+            }
+        }
+    }
+
+
+    inline ~RxMappedFile()
+    {
+        if (m_data) {
+            munmap(const_cast<uint8_t *>(m_data), m_size);
+        }
+
+        if (m_fd >= 0) {
+#           ifdef POSIX_FADV_DONTNEED
+            // The content was copied into the dataset, keeping 2 GB of page cache around only hides how much memory is really free.
+            posix_fadvise(m_fd, 0, 0, POSIX_FADV_DONTNEED);
+#           endif
+
+            close(m_fd);
+        }
+    }
+#   endif
+
+    inline const uint8_t *data() const  { return m_data; }
+    inline size_t size() const          { return m_size; }
+
+private:
+    const uint8_t *m_data   = nullptr;
+    size_t m_size           = 0;
+
+#   ifndef _WIN32
+    int m_fd                = -1;
+#   endif
+};
+
+
+static inline bool isSupported(const String &path, const RxSeed &seed)
+{
+    return !path.isEmpty() && seed.data().size() > 0 && seed.data().size() <= kMaxSeedSize;
+}
+
+
+static String fileName(const String &path, const RxSeed &seed, const char *suffix = "")
+{
+    char algo[32]{};
+    strncpy(algo, seed.algorithm().shortName(), sizeof(algo) - 1);
+
+    for (char *p = algo; *p; ++p) {
+        if (*p == '/') {
+            *p = '-';
+        }
+    }
+
+    const String dir = Env::expand(path);
+    const String hex = Buffer::toHex(seed.data().data(), seed.data().size());
+
+    const size_t size = dir.size() + sizeof(algo) + hex.size() + 32;
+    char *buf         = new char[size];
+    snprintf(buf, size, "%s/%s-%s.rxd%s", dir.data(), algo, hex.data(), suffix);
+
+    return buf;
+}
+
+
+static bool isValid(const RxDatasetCacheHeader &header, const RxSeed &seed)
+{
+    return memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 &&
+           header.version == kVersion &&
+           header.algorithm == static_cast<uint32_t>(seed.algorithm().id()) &&
+           header.seedSize == seed.data().size() &&
+           memcmp(header.seed, seed.data().data(), seed.data().size()) == 0;
+}
+
+
+static void remove(const char *fileName)
+{
+    uv_fs_t req;
+    uv_fs_unlink(uv_default_loop(), &req, fileName, nullptr);
+    uv_fs_req_cleanup(&req);
+}
+
+
+static inline bool endsWith(const char *str, const char *suffix)
+{
+    const size_t size   = strlen(str);
+    const size_t length = strlen(suffix);
+
+    return size >= length && strcmp(str + size - length, suffix) == 0;
+}
+
+
+// Removes the cache files in the directory, except the listed ones. Temporary files are always removed.
+static void removeFiles(const String &path, const String &keep1, const String &keep2, bool all)
+{
+    const String dir = Env::expand(path);
+
+    uv_fs_t req;
+    if (uv_fs_scandir(uv_default_loop(), &req, dir, 0, nullptr) < 0) {
+        uv_fs_req_cleanup(&req);
+
+        return;
+    }
+
+    std::vector<String> files;
+    uv_dirent_t entry;
+
+    while (uv_fs_scandir_next(&req, &entry) != UV_EOF) {
+        if (entry.type != UV_DIRENT_FILE && entry.type != UV_DIRENT_UNKNOWN) {
+            continue;
+        }
+
+        if (endsWith(entry.name, ".rxd.tmp") || (all && endsWith(entry.name, ".rxd"))) {
+            const size_t size = dir.size() + strlen(entry.name) + 2;
+            char *buf         = new char[size];
+            snprintf(buf, size, "%s/%s", dir.data(), entry.name);
+
+            String name(buf);
+            if (name != keep1 && name != keep2) {
+                files.emplace_back(std::move(name));
+            }
+        }
+    }
+
+    uv_fs_req_cleanup(&req);
+
+    for (const auto &name : files) {
+        remove(name);
+
+        LOG_INFO("%s" YELLOW("removed dataset cache file ") WHITE_BOLD("%s"), rx_tag(), name.data());
+    }
+}
+
+
+// The dataset is written in chunks, a new seed must not wait until 2 GB are on disk.
+static bool write(FILE *fp, const void *data, size_t size, const std::atomic<bool> &abort)
+{
+    auto p = static_cast<const uint8_t *>(data);
+
+    while (size > 0) {
+        if (abort) {
+            return false;
+        }
+
+        const size_t chunk = std::min(size, kWriteChunk);
+        if (fwrite(p, 1, chunk, fp) != chunk) {
+            return false;
+        }
+
+        p    += chunk;
+        size -= chunk;
+    }
+
+    return true;
+}
+
+
+} // namespace xmrig
+
+
+bool xmrig::RxDatasetCache::load(const String &path, const RxSeed &seed, RxDataset *dataset)
+{
+    RxCache *cache = dataset->cache();
+    if (!isSupported(path, seed) || !cache || !cache->get()) {
+        return false;
+    }
+
+    const uint64_t ts  = Chrono::steadyMSecs();
+    const String name  = fileName(path, seed);
+    RxMappedFile file(name);
+
+    if (!file.data()) {
+        return false;
+    }
+
+    RxDatasetCacheHeader header{};
+    if (file.size() >= kHeaderSize) {
+        memcpy(&header, file.data(), sizeof(header));
+    }
+
+    const uint8_t *payload = file.data() + kHeaderSize;
+    const bool sizeOk      = file.size() >= kHeaderSize &&
+                             header.cacheSize == RxCache::maxSize() &&
+                             (header.datasetSize == RxDataset::maxSize() || (header.datasetSize == 0 && !dataset->get())) &&
+                             file.size() == kHeaderSize + header.cacheSize + header.datasetSize;
+
+    if (!sizeOk || !isValid(header, seed)) {
+        LOG_WARN("%s" YELLOW_BOLD("dataset cache mismatch, ignoring ") WHITE_BOLD("%s"), rx_tag(), name.data());
+
+        return false;
+    }
+
+    RxChecksum checksum;
+    checksum.update(payload, header.cacheSize + header.datasetSize);
+
+    if (checksum.digest() != header.checksum) {
+        LOG_WARN("%s" YELLOW_BOLD("dataset cache checksum mismatch, ignoring ") WHITE_BOLD("%s"), rx_tag(), name.data());
+
+        return false;
+    }
+
+    cache->setRaw(seed.data(), payload);
+
+    if (dataset->get()) {
+        dataset->setRaw(payload + header.cacheSize);
+    }
+
+    LOG_INFO("%s" GREEN_BOLD("dataset loaded") " from " WHITE_BOLD("%s") BLACK_BOLD(" (%" PRIu64 " ms)"), rx_tag(), name.data(), Chrono::steadyMSecs() - ts);
+
+    return true;
+}
+
+
+bool xmrig::RxDatasetCache::save(const String &path, const RxSeed &seed, const RxDataset *dataset, const std::atomic<bool> &abort)
+{
+    const RxCache *cache = dataset->cache();
+    if (!isSupported(path, seed) || !cache || !cache->raw()) {
+        return false;
+    }
+
+    const uint64_t ts = Chrono::steadyMSecs();
+
+    uv_fs_t req;
+    uv_fs_mkdir(uv_default_loop(), &req, Env::expand(path), 0755, nullptr);
+    uv_fs_req_cleanup(&req);
+
+    RxDatasetCacheHeader header{};
+    memcpy(header.magic, kMagic, sizeof(kMagic));
+    memcpy(header.seed, seed.data().data(), seed.data().size());
+
+    header.version     = kVersion;
+    header.algorithm   = static_cast<uint32_t>(seed.algorithm().id());
+    header.seedSize    = seed.data().size();
+    header.cacheSize   = RxCache::maxSize();
+    header.datasetSize = dataset->get() ? RxDataset::maxSize() : 0;
+
+    RxChecksum checksum;
+    checksum.update(cache->raw(), header.cacheSize);
+
+    for (size_t offset = 0; offset < header.datasetSize && !abort; offset += kWriteChunk) {
+        checksum.update(static_cast<const uint8_t *>(dataset->raw()) + offset, std::min<size_t>(header.datasetSize - offset, kWriteChunk));
+    }
+
+    if (abort) {
+        return false;
+    }
+
+    header.checksum = checksum.digest();
+
+    const String name = fileName(path, seed);
+    const String temp = fileName(path, seed, ".tmp");
+
+    std::vector<uint8_t> page(kHeaderSize, 0);
+    memcpy(page.data(), &header, sizeof(header));
+
+    FILE *fp = fopen(temp, "wb");
+    bool ok  = fp != nullptr &&
+               fwrite(page.data(), 1, page.size(), fp) == page.size() &&
+               write(fp, cache->raw(), header.cacheSize, abort) &&
+               write(fp, dataset->raw(), header.datasetSize, abort);
+
+    if (fp) {
+        ok = fclose(fp) == 0 && ok;
+    }
+
+    if (ok) {
+        ok = uv_fs_rename(uv_default_loop(), &req, temp, name, nullptr) == 0;
+        uv_fs_req_cleanup(&req);
+    }
+
+    if (!ok) {
+        remove(temp);
+
+        if (abort) {
+            LOG_INFO("%s" YELLOW("dataset save interrupted by a new seed"), rx_tag());
+
+            return false;
+        }
+
+        LOG_WARN("%s" YELLOW_BOLD("failed to save dataset to ") WHITE_BOLD("%s"), rx_tag(), name.data());
+
+        return false;
+    }
+
+    LOG_INFO("%s" GREEN_BOLD("dataset saved") " to " WHITE_BOLD("%s") BLACK_BOLD(" (%" PRIu64 " ms)"), rx_tag(), name.data(), Chrono::steadyMSecs() - ts);
+
+    return true;
+}
+
+
+void xmrig::RxDatasetCache::cleanup(const String &path)
+{
+    if (!path.isEmpty()) {
+        removeFiles(path, String(), String(), false);
+    }
+}
+
+
+void xmrig::RxDatasetCache::prune(const String &path, const RxSeed &seed, const RxSeed &next)
+{
+    if (path.isEmpty()) {
+        return;
+    }
+
+    removeFiles(path, isSupported(path, seed) ? fileName(path, seed) : String(), isSupported(path, next) ? fileName(path, next) : String(), true);
+}
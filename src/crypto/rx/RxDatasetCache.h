@@ -0,0 +1,60 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_RX_DATASETCACHE_H
+#define XMRIG_RX_DATASETCACHE_H
+
+
+#include "base/tools/String.h"
+
+
+#include <atomic>
+
+
+namespace xmrig
+{
+
+
+class RxDataset;
+class RxSeed;
+
+
+// Keeps initialized datasets on disk, one file per algorithm and seed, so restarts and returning seeds skip the
+// Argon2 and dataset init. Files carry a header with the seed, sizes and a checksum of the payload, anything
+// that does not match is ignored and the dataset is computed as usual. Only the files of the current and the
+// next seed are kept, every other seed would cost another 2 GB of disk.
+class RxDatasetCache
+{
+public:
+    static bool load(const String &path, const RxSeed &seed, RxDataset *dataset);
+    static bool save(const String &path, const RxSeed &seed, const RxDataset *dataset, const std::atomic<bool> &abort);
+    static void cleanup(const String &path);
+    static void prune(const String &path, const RxSeed &seed, const RxSeed &next);
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_RX_DATASETCACHE_H */
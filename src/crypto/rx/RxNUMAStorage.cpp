@@ -36,9 +36,12 @@
 #include "crypto/rx/RxAlgo.h"
 #include "crypto/rx/RxCache.h"
 #include "crypto/rx/RxDataset.h"
+#include "crypto/rx/RxDatasetCache.h"
 #include "crypto/rx/RxSeed.h"
 
 
+#include <algorithm>
+#include <cstring>
 #include <map>
 #include <mutex>
 #include <hwloc.h>
@@ -52,7 +55,7 @@ constexpr size_t oneMiB = 1024 * 1024;
 static std::mutex mutex;
 
 
-static bool bindToNUMANode(uint32_t nodeId)
+static bool bindToNUMANode(uint32_t nodeId, bool wholeNode = false)
 {
     auto cpu         = static_cast<HwlocCpuInfo *>(Cpu::info());
     hwloc_obj_t node = hwloc_get_numanode_obj_by_os_index(cpu->topology(), nodeId);
@@ -61,7 +64,12 @@ static bool bindToNUMANode(uint32_t nodeId)
     }
 
     if (cpu->membind(node->nodeset)) {
-        Platform::setThreadAffinity(static_cast<uint64_t>(hwloc_bitmap_first(node->cpuset)));
+        if (wholeNode) {
+            hwloc_set_cpubind(cpu->topology(), node->cpuset, HWLOC_CPUBIND_THREAD);
+        }
+        else {
+            Platform::setThreadAffinity(static_cast<uint64_t>(hwloc_bitmap_first(node->cpuset)));
+        }
 
         return true;
     }
@@ -82,6 +90,20 @@ static inline void printDatasetReady(uint32_t nodeId, uint64_t ts)
 }
 
 
+static inline void printDatasetReady(const RxTimings &timings)
+{
+    LOG_INFO("%s" CYAN_BOLD("-- ") GREEN_BOLD("dataset ready") BLACK_BOLD(" (%" PRIu64 " ms)") " allocate " WHITE_BOLD("%" PRIu64) " cache " WHITE_BOLD("%" PRIu64) " compute " WHITE_BOLD("%" PRIu64) " load " WHITE_BOLD("%" PRIu64) " replicate " WHITE_BOLD("%" PRIu64) " ms",
+             rx_tag(),
+             timings.total(),
+             timings.allocate,
+             timings.cache,
+             timings.compute,
+             timings.load,
+             timings.replicate
+             );
+}
+
+
 class RxNUMAStoragePrivate
 {
 public:
@@ -104,6 +126,9 @@ public:
     }
 
     inline bool isAllocated() const                     { return m_allocated; }
+    inline bool isPrefetchLogged() const                { return m_prefetchLogged; }
+    inline const RxTimings &timings() const             { return m_timings; }
+    inline void setPrefetchLogged()                     { m_prefetchLogged = true; }
     inline bool isReady(const Job &job) const           { return m_ready && m_seed == job; }
     inline RxDataset *dataset(uint32_t nodeId) const    { return m_datasets.count(nodeId) ? m_datasets.at(nodeId) : m_datasets.at(m_nodeset.front()); }
 
@@ -152,7 +177,8 @@ public:
             printAllocStatus(ts);
         }
 
-        m_allocated = true;
+        m_allocated        = true;
+        m_timings.allocate = Chrono::steadyMSecs() - ts;
 
         return true;
     }
@@ -174,32 +200,68 @@ public:
     }
 
 
-    inline void initDatasets(uint32_t threads, int priority)
+    inline void initDatasets(uint32_t threads, int priority, const String &cacheDir)
     {
+        m_timings.reset();
+        m_unsaved = nullptr;
+
         uint64_t ts  = Chrono::steadyMSecs();
         auto id      = m_nodeset.front();
         auto primary = dataset(id);
 
-        primary->init(m_seed.data(), threads, priority);
-
-        printDatasetReady(id, ts);
+        if (RxDatasetCache::load(cacheDir, m_seed, primary)) {
+            m_timings.load = Chrono::steadyMSecs() - ts;
+            ts             = Chrono::steadyMSecs();
 
-        if (m_datasets.size() > 1) {
             for (auto const &item : m_datasets) {
-                if (item.first == id) {
-                    continue;
+                if (item.first != id) {
+                    m_threads.emplace_back(copyDataset, item.second, item.first, primary->raw());
                 }
-
-                m_threads.emplace_back(copyDataset, item.second, item.first, primary->raw());
             }
 
             join();
+
+            m_timings.replicate = Chrono::steadyMSecs() - ts;
         }
+        else {
+            if (!primary->cache()) {
+                return;
+            }
+
+            primary->cache()->init(m_seed.data());
+            m_timings.cache = Chrono::steadyMSecs() - ts;
+
+            if (m_datasets.size() > 1) {
+                computeSlices(primary->cache(), threads, priority);
+                replicateSlices();
+            }
+            else {
+                ts = Chrono::steadyMSecs();
+                primary->init(m_seed.data(), threads, priority);
+                m_timings.compute = Chrono::steadyMSecs() - ts;
+            }
+
+            if (!cacheDir.isEmpty()) {
+                m_unsaved = primary;
+            }
+        }
+
+        printDatasetReady(m_timings);
 
         m_ready = true;
     }
 
 
+    // Called by the queue thread after the workers got the datasets, the primary copy is the one written to disk.
+    inline bool save(const String &cacheDir, const std::atomic<bool> &abort)
+    {
+        const RxDataset *dataset = m_unsaved;
+        m_unsaved                = nullptr;
+
+        return dataset && !cacheDir.isEmpty() && RxDatasetCache::save(cacheDir, m_seed, dataset, abort);
+    }
+
+
     inline HugePagesInfo hugePages() const
     {
         HugePagesInfo pages;
@@ -257,6 +319,80 @@ private:
     }
 
 
+    // Slice i of the dataset is computed on node i by that node's threads, into that node's copy.
+    void computeSlices(RxCache *cache, uint32_t threads, int priority)
+    {
+        const uint64_t ts        = Chrono::steadyMSecs();
+        const uint64_t itemCount = randomx_dataset_item_count();
+        const uint32_t slices    = static_cast<uint32_t>(m_datasets.size());
+        const uint32_t perNode   = std::max(threads / slices, 1U);
+
+        uint32_t i = 0;
+        for (auto const &item : m_datasets) {
+            const uint64_t a = itemCount * i / slices;
+            const uint64_t b = itemCount * (i + 1) / slices;
+
+            for (uint32_t j = 0; j < perNode; ++j) {
+                const uint64_t start = a + (b - a) * j / perNode;
+                const uint64_t end   = a + (b - a) * (j + 1) / perNode;
+
+                m_threads.emplace_back(computeSlice, item.second, cache, item.first, start, end - start, priority);
+            }
+
+            ++i;
+        }
+
+        join();
+
+        m_timings.compute = Chrono::steadyMSecs() - ts;
+    }
+
+
+    // Every node pulls the slices it did not compute, with one thread per slice bound to the destination node.
+    void replicateSlices()
+    {
+        const uint64_t ts        = Chrono::steadyMSecs();
+        const uint64_t itemCount = randomx_dataset_item_count();
+        const uint32_t slices    = static_cast<uint32_t>(m_datasets.size());
+
+        for (auto const &dst : m_datasets) {
+            uint32_t i = 0;
+
+            for (auto const &src : m_datasets) {
+                if (src.first != dst.first) {
+                    const uint64_t a = itemCount * i / slices * RANDOMX_DATASET_ITEM_SIZE;
+                    const uint64_t b = itemCount * (i + 1) / slices * RANDOMX_DATASET_ITEM_SIZE;
+
+                    m_threads.emplace_back(copySlice, dst.second, src.second, dst.first, a, b - a);
+                }
+
+                ++i;
+            }
+        }
+
+        join();
+
+        m_timings.replicate = Chrono::steadyMSecs() - ts;
+    }
+
+
+    static void computeSlice(RxDataset *dataset, RxCache *cache, uint32_t nodeId, uint64_t startItem, uint64_t itemCount, int priority)
+    {
+        bindToNUMANode(nodeId, true);
+        Platform::setThreadPriority(priority);
+
+        randomx_init_dataset(dataset->get(), cache->get(), startItem, itemCount);
+    }
+
+
+    static void copySlice(RxDataset *dst, const RxDataset *src, uint32_t nodeId, uint64_t offset, uint64_t size)
+    {
+        bindToNUMANode(nodeId, true);
+
+        memcpy(static_cast<uint8_t *>(dst->raw()) + offset, static_cast<const uint8_t *>(src->raw()) + offset, size);
+    }
+
+
     static void copyDataset(RxDataset *dst, uint32_t nodeId, const void *raw)
     {
         const uint64_t ts = Chrono::steadyMSecs();
@@ -324,10 +460,13 @@ private:
     }
 
 
-    bool m_allocated        = false;
-    bool m_ready            = false;
-    RxCache *m_cache        = nullptr;
+    bool m_allocated           = false;
+    bool m_prefetchLogged      = false;
+    bool m_ready               = false;
+    const RxDataset *m_unsaved = nullptr;
+    RxCache *m_cache           = nullptr;
     RxSeed m_seed;
+    RxTimings m_timings;
     std::map<uint32_t, RxDataset *> m_datasets;
     std::vector<std::thread> m_threads;
     std::vector<uint32_t> m_nodeset;
@@ -375,7 +514,37 @@ xmrig::RxDataset *xmrig::RxNUMAStorage::dataset(const Job &job, uint32_t nodeId)
 }
 
 
-void xmrig::RxNUMAStorage::init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode, int priority)
+xmrig::RxTimings xmrig::RxNUMAStorage::timings() const
+{
+    return d_ptr->timings();
+}
+
+
+bool xmrig::RxNUMAStorage::prefetch(const RxSeed &, uint32_t, bool, bool, RxConfig::Mode, int, const String &, const std::atomic<bool> &)
+{
+    // A second copy of the dataset on every node is too expensive, the next seed is initialized on the epoch change as before.
+    if (!d_ptr->isPrefetchLogged()) {
+        d_ptr->setPrefetchLogged();
+        LOG_WARN("%s" YELLOW("NUMA mode does not prepare the next dataset, mining pauses while it is initialized on the seed change"), rx_tag());
+    }
+
+    return false;
+}
+
+
+bool xmrig::RxNUMAStorage::swap(const RxSeed &)
+{
+    return false;
+}
+
+
+bool xmrig::RxNUMAStorage::save(const String &cacheDir, const std::atomic<bool> &abort)
+{
+    return d_ptr->save(cacheDir, abort);
+}
+
+
+void xmrig::RxNUMAStorage::init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode, int priority, const String &cacheDir)
 {
     d_ptr->setSeed(seed);
 
@@ -383,5 +552,5 @@ void xmrig::RxNUMAStorage::init(const RxSeed &seed, uint32_t threads, bool hugeP
         return;
     }
 
-    d_ptr->initDatasets(threads, priority);
+    d_ptr->initDatasets(threads, priority, cacheDir);
 }
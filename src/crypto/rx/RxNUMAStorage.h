@@ -54,7 +54,11 @@ protected:
     bool isAllocated() const override;
     HugePagesInfo hugePages() const override;
     RxDataset *dataset(const Job &job, uint32_t nodeId) const override;
-    void init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority) override;
+    RxTimings timings() const override;
+    bool prefetch(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority, const String &cacheDir, const std::atomic<bool> &abort) override;
+    bool swap(const RxSeed &seed) override;
+    bool save(const String &cacheDir, const std::atomic<bool> &abort) override;
+    void init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority, const String &cacheDir) override;
 
 private:
     RxNUMAStoragePrivate *d_ptr;
@@ -0,0 +1,224 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "crypto/rx/RxProfiler.h"
+#include "base/io/log/Log.h"
+#include "rapidjson/document.h"
+
+
+#include <cinttypes>
+#include <list>
+#include <mutex>
+
+
+namespace xmrig {
+
+
+static const char *tag = BLUE_BG(WHITE_BOLD_S " prof ") " ";
+static const char *names[RxProfiler::STAGE_MAX] = { "hash", "program", "jit", "execute", "register_hash", "hash_and_fill", "bbp_blake256" };
+static std::list<RxProfiler::Stats> stats;
+static std::mutex mutex;
+
+
+thread_local bool RxProfiler::m_sampling            = false;
+thread_local RxProfiler::Stats *RxProfiler::m_stats = nullptr;
+thread_local uint32_t RxProfiler::m_counter         = 0;
+
+
+static inline uint64_t load(const std::atomic<uint64_t> &value)
+{
+    return value.load(std::memory_order_relaxed);
+}
+
+
+static inline size_t bucket(uint64_t cycles)
+{
+    size_t index = 0;
+    while (cycles >>= 1) {
+        ++index;
+    }
+
+    return index < RxProfiler::kBuckets ? index : RxProfiler::kBuckets - 1;
+}
+
+
+} // namespace xmrig
+
+
+xmrig::RxProfiler::Stats::Stats()
+{
+    for (size_t i = 0; i < STAGE_MAX; ++i) {
+        samples[i] = 0;
+        cycles[i]  = 0;
+
+        for (size_t j = 0; j < kBuckets; ++j) {
+            histogram[i][j] = 0;
+        }
+    }
+}
+
+
+void xmrig::RxProfiler::Stats::add(Stage stage, uint64_t value)
+{
+    // Only the owning thread writes, so a plain load/store pair is enough and no locked instruction is emitted.
+    auto inc = [](std::atomic<uint64_t> &counter, uint64_t n) { counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed); };
+
+    inc(samples[stage], 1);
+    inc(cycles[stage], value);
+    inc(histogram[stage][bucket(value)], 1);
+}
+
+
+const char *xmrig::RxProfiler::stageName(Stage stage)
+{
+    return stage < STAGE_MAX ? names[stage] : "unknown";
+}
+
+
+const char *xmrig::RxProfiler::unit()
+{
+#   ifdef XMRIG_PROFILER_TSC
+    return "cycles";
+#   else
+    return "ns";
+#   endif
+}
+
+
+rapidjson::Value xmrig::RxProfiler::toJSON(rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    uint64_t samples[STAGE_MAX]             = {};
+    uint64_t cycles[STAGE_MAX]              = {};
+    uint64_t histogram[STAGE_MAX][kBuckets] = {};
+
+    Value threads(kArrayType);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        for (const Stats &thread : stats) {
+            Value avg(kArrayType);
+
+            for (size_t i = 0; i < STAGE_MAX; ++i) {
+                const uint64_t n = load(thread.samples[i]);
+                const uint64_t c = load(thread.cycles[i]);
+
+                samples[i] += n;
+                cycles[i]  += c;
+                avg.PushBack(n ? c / n : 0, allocator);
+
+                for (size_t j = 0; j < kBuckets; ++j) {
+                    histogram[i][j] += load(thread.histogram[i][j]);
+                }
+            }
+
+            threads.PushBack(avg, allocator);
+        }
+    }
+
+    Value out(kObjectType);
+    out.AddMember("unit",       StringRef(unit()), allocator);
+    out.AddMember("interval",   kInterval, allocator);
+
+    Value list(kArrayType);
+    for (size_t i = 0; i < STAGE_MAX; ++i) {
+        Value stage(kObjectType);
+        stage.AddMember("name",     StringRef(names[i]), allocator);
+        stage.AddMember("samples",  samples[i], allocator);
+        stage.AddMember("total",    cycles[i], allocator);
+        stage.AddMember("avg",      samples[i] ? cycles[i] / samples[i] : 0, allocator);
+
+        // Log2 buckets: [lower bound, count], empty buckets are omitted.
+        Value buckets(kArrayType);
+        for (size_t j = 0; j < kBuckets; ++j) {
+            if (histogram[i][j]) {
+                Value item(kArrayType);
+                item.PushBack(uint64_t(1) << j, allocator);
+                item.PushBack(histogram[i][j], allocator);
+
+                buckets.PushBack(item, allocator);
+            }
+        }
+
+        stage.AddMember("histogram", buckets, allocator);
+        list.PushBack(stage, allocator);
+    }
+
+    out.AddMember("stages",     list, allocator);
+    out.AddMember("threads",    threads, allocator);
+
+    return out;
+}
+
+
+void xmrig::RxProfiler::print()
+{
+    uint64_t samples[STAGE_MAX] = {};
+    uint64_t cycles[STAGE_MAX]  = {};
+    size_t count                = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        for (const Stats &thread : stats) {
+            for (size_t i = 0; i < STAGE_MAX; ++i) {
+                samples[i] += load(thread.samples[i]);
+                cycles[i]  += load(thread.cycles[i]);
+            }
+
+            ++count;
+        }
+    }
+
+    if (!samples[HASH]) {
+        LOG_INFO("%s" WHITE_BOLD("no samples yet"), tag);
+
+        return;
+    }
+
+    LOG_INFO("%s" WHITE_BOLD("sampling every %uth hash, threads ") CYAN_BOLD("%zu"), tag, kInterval, count);
+
+    for (size_t i = 0; i < STAGE_MAX; ++i) {
+        if (!samples[i]) {
+            continue;
+        }
+
+        LOG_INFO("%s" WHITE_BOLD("%-14s") " samples " CYAN("%-8" PRIu64) " avg " CYAN_BOLD("%12" PRIu64) " %s " BLACK_BOLD("(%.1f%%)"),
+                 tag, names[i], samples[i], cycles[i] / samples[i], unit(), static_cast<double>(cycles[i]) * 100.0 / cycles[HASH]);
+    }
+}
+
+
+xmrig::RxProfiler::Stats *xmrig::RxProfiler::create()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    stats.emplace_back();
+
+    return &stats.back();
+}
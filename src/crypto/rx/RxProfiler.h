@@ -0,0 +1,173 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_RX_PROFILER_H
+#define XMRIG_RX_PROFILER_H
+
+
+#ifdef XMRIG_FEATURE_PROFILING
+
+
+#include "rapidjson/fwd.h"
+
+
+#include <atomic>
+#include <cstdint>
+
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#   ifdef _MSC_VER
+#       include <intrin.h>
+#   else
+#       include <x86intrin.h>
+#   endif
+#   define XMRIG_PROFILER_TSC
+#else
+#   include <chrono>
+#endif
+
+
+namespace xmrig
+{
+
+
+class RxProfiler
+{
+public:
+    enum Stage : uint32_t {
+        HASH,
+        PROGRAM,
+        JIT,
+        EXECUTE,
+        REGISTER_HASH,
+        HASH_AND_FILL,
+        BBP_BLAKE256,
+        STAGE_MAX
+    };
+
+    // Every Nth hash of a thread is timed, all other hashes only pay for a thread local counter increment.
+    static constexpr uint32_t kInterval = 64;
+    static constexpr size_t kBuckets    = 48;
+
+    class Stats
+    {
+    public:
+        // Written only by the owning worker thread, read by the API/console with relaxed loads.
+        std::atomic<uint64_t> samples[STAGE_MAX];
+        std::atomic<uint64_t> cycles[STAGE_MAX];
+        std::atomic<uint64_t> histogram[STAGE_MAX][kBuckets];
+
+        Stats();
+
+        void add(Stage stage, uint64_t cycles);
+    };
+
+    static inline bool isSampling()         { return m_sampling; }
+    static inline uint64_t now()
+    {
+#       ifdef XMRIG_PROFILER_TSC
+        return __rdtsc();
+#       else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#       endif
+    }
+
+    static inline bool begin()
+    {
+        m_sampling = ++m_counter % kInterval == 0;
+
+        return m_sampling;
+    }
+
+    static inline void end()                { m_sampling = false; }
+
+    static inline void add(Stage stage, uint64_t cycles)
+    {
+        if (!m_stats) {
+            m_stats = create();
+        }
+
+        m_stats->add(stage, cycles);
+    }
+
+    static const char *unit();
+    static const char *stageName(Stage stage);
+    static rapidjson::Value toJSON(rapidjson::Document &doc);
+    static void print();
+
+private:
+    static Stats *create();
+
+    static thread_local bool m_sampling;
+    static thread_local Stats *m_stats;
+    static thread_local uint32_t m_counter;
+};
+
+
+class RxProfileScope
+{
+public:
+    inline RxProfileScope(RxProfiler::Stage stage) : m_stage(stage), m_start(RxProfiler::isSampling() ? RxProfiler::now() : 0) {}
+    inline ~RxProfileScope()
+    {
+        if (m_start) {
+            RxProfiler::add(m_stage, RxProfiler::now() - m_start);
+        }
+    }
+
+private:
+    const RxProfiler::Stage m_stage;
+    const uint64_t m_start;
+};
+
+
+class RxProfileHash
+{
+public:
+    inline RxProfileHash() : m_start(RxProfiler::begin() ? RxProfiler::now() : 0) {}
+    inline ~RxProfileHash()
+    {
+        if (m_start) {
+            RxProfiler::add(RxProfiler::HASH, RxProfiler::now() - m_start);
+            RxProfiler::end();
+        }
+    }
+
+private:
+    const uint64_t m_start;
+};
+
+
+} /* namespace xmrig */
+
+
+#   define RX_PROFILE_HASH()        xmrig::RxProfileHash _rx_profile_hash
+#   define RX_PROFILE_SCOPE(stage)  xmrig::RxProfileScope _rx_profile_##stage(xmrig::RxProfiler::stage)
+#else
+#   define RX_PROFILE_HASH()
+#   define RX_PROFILE_SCOPE(stage)
+#endif
+
+
+#endif /* XMRIG_RX_PROFILER_H */
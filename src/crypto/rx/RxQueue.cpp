@@ -29,8 +29,11 @@
 #include "backend/common/Tags.h"
 #include "base/io/log/Log.h"
 #include "crypto/rx/RxBasicStorage.h"
+#include "crypto/rx/RxDataset.h"
+#include "crypto/rx/RxDatasetCache.h"
 #include "base/tools/Handle.h"
 #include "backend/common/interfaces/IRxListener.h"
+#include "crypto/common/Nonce.h"
 
 
 #ifdef XMRIG_FEATURE_HWLOC
@@ -53,7 +56,9 @@ xmrig::RxQueue::RxQueue(IRxListener *listener) :
 xmrig::RxQueue::~RxQueue()
 {
     std::unique_lock<std::mutex> lock(m_mutex);
-    m_state = STATE_SHUTDOWN;
+    m_state      = STATE_SHUTDOWN;
+    m_abort      = true;
+    m_cancelSave = true;
     lock.unlock();
 
     m_cv.notify_one();
@@ -66,11 +71,12 @@ xmrig::RxQueue::~RxQueue()
 }
 
 
+// A job whose dataset is prepared counts as ready, Rx::init() switches to it without stopping the workers.
 bool xmrig::RxQueue::isReady(const Job &job)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
 
-    return isReadyUnsafe(job);
+    return isReadyUnsafe(job) || isPromotableUnsafe(job);
 }
 
 
@@ -78,11 +84,17 @@ xmrig::RxDataset *xmrig::RxQueue::dataset(const Job &job, uint32_t nodeId)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
 
-    if (isReadyUnsafe(job)) {
-        return m_storage->dataset(job, nodeId);
+    if (!isReadyUnsafe(job)) {
+        return nullptr;
     }
 
-    return nullptr;
+    // Taken under the lock, so a dataset handed out before a switch is always seen as used by the next prefetch.
+    RxDataset *dataset = m_storage->dataset(job, nodeId);
+    if (dataset) {
+        dataset->acquire();
+    }
+
+    return dataset;
 }
 
 
@@ -94,7 +106,15 @@ xmrig::HugePagesInfo xmrig::RxQueue::hugePages()
 }
 
 
-void xmrig::RxQueue::enqueue(const RxSeed &seed, const std::vector<uint32_t> &nodeset, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority)
+xmrig::RxTimings xmrig::RxQueue::timings()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_timings;
+}
+
+
+void xmrig::RxQueue::enqueue(const RxSeed &seed, const std::vector<uint32_t> &nodeset, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority, const String &cacheDir)
 {
     std::unique_lock<std::mutex> lock(m_mutex);
 
@@ -114,9 +134,11 @@ void xmrig::RxQueue::enqueue(const RxSeed &seed, const std::vector<uint32_t> &no
         return;
     }
 
-    m_queue.emplace_back(seed, nodeset, threads, hugePages, oneGbPages, mode, priority);
-    m_seed  = seed;
-    m_state = STATE_PENDING;
+    m_queue.emplace_back(seed, nodeset, threads, hugePages, oneGbPages, mode, priority, cacheDir);
+    m_seed       = seed;
+    m_state      = STATE_PENDING;
+    m_abort      = true;
+    m_cancelSave = true;
 
     lock.unlock();
 
@@ -124,6 +146,47 @@ void xmrig::RxQueue::enqueue(const RxSeed &seed, const std::vector<uint32_t> &no
 }
 
 
+void xmrig::RxQueue::promote(const Job &job)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!isPromotableUnsafe(job) || !m_storage->swap(m_next)) {
+        return;
+    }
+
+    // The previous dataset stays in the spare slot, switching back to it (pool change or reorg) is free as well.
+    std::swap(m_seed, m_next);
+
+    LOG_INFO("%s" GREEN_BOLD("switched to the prepared dataset") BLACK_BOLD(" seed %s..."), rx_tag(), Buffer::toHex(m_seed.data().data(), 8).data());
+}
+
+
+void xmrig::RxQueue::prefetch(const RxSeed &seed, const std::vector<uint32_t> &nodeset, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority, const String &cacheDir)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (!m_storage || m_next == seed || m_seed == seed) {
+        return;
+    }
+
+    m_prefetch.clear();
+    m_prefetch.emplace_back(seed, nodeset, threads, hugePages, oneGbPages, mode, priority, cacheDir);
+    m_next      = seed;
+    m_nextReady = false;
+    m_abort     = true;
+
+    lock.unlock();
+
+    m_cv.notify_one();
+}
+
+
+bool xmrig::RxQueue::isPromotableUnsafe(const Job &job) const
+{
+    return m_storage != nullptr && m_nextReady && m_state == STATE_IDLE && m_next == job && !(m_seed == job);
+}
+
+
 bool xmrig::RxQueue::isReadyUnsafe(const Job &job) const
 {
     return m_storage != nullptr && m_storage->isAllocated() && m_state == STATE_IDLE && m_seed == job;
@@ -135,8 +198,14 @@ void xmrig::RxQueue::backgroundInit()
     while (m_state != STATE_SHUTDOWN) {
         std::unique_lock<std::mutex> lock(m_mutex);
 
+        if (m_state == STATE_IDLE && m_prefetch.empty()) {
+            m_cv.wait(lock, [this]{ return m_state != STATE_IDLE || !m_prefetch.empty(); });
+        }
+
         if (m_state == STATE_IDLE) {
-            m_cv.wait(lock, [this]{ return m_state != STATE_IDLE; });
+            backgroundPrefetch(lock);
+
+            continue;
         }
 
         if (m_state != STATE_PENDING) {
@@ -156,7 +225,12 @@ void xmrig::RxQueue::backgroundInit()
                  Buffer::toHex(item.seed.data().data(), 8).data()
                  );
 
-        m_storage->init(item.seed, item.threads, item.hugePages, item.oneGbPages, item.mode, item.priority);
+        // Leftovers of a save that was killed, removed before the first dataset is written.
+        if (!m_storage->isAllocated()) {
+            RxDatasetCache::cleanup(item.cacheDir);
+        }
+
+        m_storage->init(item.seed, item.threads, item.hugePages, item.oneGbPages, item.mode, item.priority, item.cacheDir);
 
         lock = std::unique_lock<std::mutex>(m_mutex);
 
@@ -164,18 +238,87 @@ void xmrig::RxQueue::backgroundInit()
             continue;
         }
 
+        m_timings = m_storage->timings();
+
         m_state = STATE_IDLE;
         uv_async_send(m_async);
+
+        backgroundSave(lock, item.cacheDir);
     }
 }
 
 
+void xmrig::RxQueue::backgroundPrefetch(std::unique_lock<std::mutex> &lock)
+{
+    const auto item = m_prefetch.back();
+    m_prefetch.clear();
+
+    if (!(m_next == item.seed) || m_seed == item.seed) {
+        return;
+    }
+
+    m_abort = false;
+
+    lock.unlock();
+
+    LOG_INFO("%s" MAGENTA_BOLD("prepare next dataset") " algo " WHITE_BOLD("%s (") CYAN_BOLD("%u") WHITE_BOLD(" threads)") BLACK_BOLD(" seed %s..."),
+             rx_tag(),
+             item.seed.algorithm().shortName(),
+             item.threads,
+             Buffer::toHex(item.seed.data().data(), 8).data()
+             );
+
+    const bool ready = m_storage->prefetch(item.seed, item.threads, item.hugePages, item.oneGbPages, item.mode, item.priority, item.cacheDir, m_abort);
+
+    lock.lock();
+
+    if (!(m_next == item.seed)) {
+        return;
+    }
+
+    m_nextReady = ready;
+
+    // Interrupted by a dataset switch, forget the seed so the next job can request it again.
+    if (!ready && m_abort) {
+        m_next = RxSeed();
+    }
+
+    if (ready) {
+        backgroundSave(lock, item.cacheDir);
+    }
+}
+
+
+// Runs only after the workers have the dataset, hashing never waits for the disk. A new seed cancels the write.
+void xmrig::RxQueue::backgroundSave(std::unique_lock<std::mutex> &lock, const String &cacheDir)
+{
+    if (cacheDir.isEmpty()) {
+        return;
+    }
+
+    const RxSeed seed = m_seed;
+    const RxSeed next = m_next;
+    m_cancelSave      = false;
+
+    lock.unlock();
+
+    if (m_storage->save(cacheDir, m_cancelSave)) {
+        RxDatasetCache::prune(cacheDir, seed, next);
+    }
+
+    lock.lock();
+}
+
+
 void xmrig::RxQueue::onReady()
 {
     std::unique_lock<std::mutex> lock(m_mutex);
     const bool ready = m_listener && m_state == STATE_IDLE;
     lock.unlock();
 
+    // Workers blocked in allocateRandomX_VM() wait for this, not for the listener.
+    Nonce::notify();
+
     if (ready) {
         m_listener->onDatasetReady();
     }
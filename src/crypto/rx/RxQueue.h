@@ -32,8 +32,10 @@
 #include "crypto/common/HugePagesInfo.h"
 #include "crypto/rx/RxConfig.h"
 #include "crypto/rx/RxSeed.h"
+#include "crypto/rx/RxTimings.h"
 
 
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <thread>
@@ -54,12 +56,13 @@ class RxDataset;
 class RxQueueItem
 {
 public:
-    RxQueueItem(const RxSeed &seed, const std::vector<uint32_t> &nodeset, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority) :
+    RxQueueItem(const RxSeed &seed, const std::vector<uint32_t> &nodeset, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority, const String &cacheDir) :
         hugePages(hugePages),
         oneGbPages(oneGbPages),
         priority(priority),
         mode(mode),
         seed(seed),
+        cacheDir(cacheDir),
         nodeset(nodeset),
         threads(threads)
     {}
@@ -69,6 +72,7 @@ public:
     const int priority;
     const RxConfig::Mode mode;
     const RxSeed seed;
+    const String cacheDir;
     const std::vector<uint32_t> nodeset;
     const uint32_t threads;
 };
@@ -85,7 +89,10 @@ public:
     bool isReady(const Job &job);
     RxDataset *dataset(const Job &job, uint32_t nodeId);
     HugePagesInfo hugePages();
-    void enqueue(const RxSeed &seed, const std::vector<uint32_t> &nodeset, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority);
+    RxTimings timings();
+    void enqueue(const RxSeed &seed, const std::vector<uint32_t> &nodeset, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority, const String &cacheDir);
+    void promote(const Job &job);
+    void prefetch(const RxSeed &seed, const std::vector<uint32_t> &nodeset, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority, const String &cacheDir);
 
 private:
     enum State {
@@ -94,17 +101,26 @@ private:
         STATE_SHUTDOWN
     };
 
+    bool isPromotableUnsafe(const Job &job) const;
     bool isReadyUnsafe(const Job &job) const;
     void backgroundInit();
+    void backgroundPrefetch(std::unique_lock<std::mutex> &lock);
+    void backgroundSave(std::unique_lock<std::mutex> &lock, const String &cacheDir);
     void onReady();
 
     IRxListener *m_listener = nullptr;
     IRxStorage *m_storage   = nullptr;
+    RxSeed m_next;
     RxSeed m_seed;
+    RxTimings m_timings;
     State m_state = STATE_IDLE;
+    bool m_nextReady        = false;
+    std::atomic<bool> m_abort{false};
+    std::atomic<bool> m_cancelSave{false};
     std::condition_variable m_cv;
     std::mutex m_mutex;
     std::thread m_thread;
+    std::vector<RxQueueItem> m_prefetch;
     std::vector<RxQueueItem> m_queue;
     uv_async_t *m_async     = nullptr;
 };
@@ -29,9 +29,12 @@
 
 #include <memory.h>
 #include <cstdint>
+#include <memory>
 
 
+#include "base/tools/Chrono.h"
 #include "base/tools/String.h"
+#include "base/net/stratum/BbpExchange.h"
 #include "base/net/stratum/Job.h"
 
 
@@ -43,18 +46,47 @@ class JobResult
 public:
     JobResult() = delete;
 
-    inline JobResult(const Job &job, uint32_t nonce, const uint8_t *result) :
+    inline JobResult(const Job &job, uint32_t nonce, const uint8_t *result, int64_t reqId = 0) :
         algorithm(job.algorithm()),
         clientId(job.clientId()),
         jobId(job.id()),
         backend(job.backend()),
         nonce(nonce),
         diff(job.diff()),
-        index(job.index())
+        index(job.index()),
+        timestamp(Chrono::steadyNSecs()),
+        reqId(reqId)
     {
         memcpy(m_result, result, sizeof(m_result));
     }
 
+    inline JobResult(const Job &job, const BbpSolution &solution) :
+        algorithm(job.algorithm()),
+        clientId("BBP"),
+        jobId(job.id()),
+        backend(job.backend()),
+        nonce(0),
+        diff(0),
+        index(job.index()),
+        timestamp(Chrono::steadyNSecs()),
+        bbp(std::make_shared<BbpSolution>(solution))
+    {
+        memcpy(m_result, solution.rxHash, sizeof(m_result));
+    }
+
+    // A BBP share already formatted by a downstream miner of the stratum proxy, sent upstream as is.
+    inline JobResult(const char *relay, size_t size, int64_t reqId) :
+        clientId("BBP"),
+        backend(0),
+        nonce(0),
+        diff(0),
+        index(0),
+        timestamp(Chrono::steadyNSecs()),
+        reqId(reqId),
+        relay(relay, size)
+    {
+    }
+
     inline JobResult(const Job &job) :
         algorithm(job.algorithm()),
         clientId(job.clientId()),
@@ -62,7 +94,8 @@ public:
         backend(job.backend()),
         nonce(0),
         diff(0),
-        index(job.index())
+        index(job.index()),
+        timestamp(Chrono::steadyNSecs())
     {
     }
 
@@ -77,6 +110,10 @@ public:
     const uint32_t nonce;
     const uint64_t diff;
     const uint8_t index;
+    const uint64_t timestamp;                   // steady clock, nanoseconds, when the share was found
+    const int64_t reqId     = 0;                // non zero for shares relayed by the stratum proxy
+    const std::shared_ptr<const BbpSolution> bbp;
+    const String relay;
     double SolvedDiff = 0;
 
 private:
@@ -130,6 +130,7 @@ static void getResults(JobBundle &bundle, std::vector<JobResult> &results, uint3
         }
 
         delete vm;
+        Rx::release(dataset);
 #       endif
     }
     else if (algorithm.family() == Algorithm::ARGON2) {
@@ -307,18 +308,6 @@ void RevHex(char *data, int datasize, char *octet)
 }
 
 
-void xmrig::JobResults::submitBBP(std::string data, uint32_t nonce, std::string randomxhash, std::string bbp_hash, std::string Seed, double JobDifficulty, double SolvedDifficulty)
-{
-	gbbp::m_mapBBPJob["randomxheader"] = data;
-	gbbp::m_mapBBPJob["randomxkey"] = Seed;
-	gbbp::m_mapBBPJob["rxhash"] = randomxhash;
-	gbbp::m_mapBBPJob["bbp_hash"] = bbp_hash;
-	gbbp::m_bbpjob.JobDifficulty = JobDifficulty;
-	gbbp::m_bbpjob.SolvedDifficulty = SolvedDifficulty;
-	gbbp::m_bbpjob.fSolutionFound = true;
-}
-
-
 void xmrig::JobResults::submit(const Job &job, uint32_t nonce, const uint8_t *result, float SolvedDiff)
 {
 	JobResult r1(job, nonce, result);
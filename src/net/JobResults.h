@@ -45,8 +45,6 @@ public:
     static void stop();
 	static void submit(const Job &job, uint32_t nonce, const uint8_t *result, float SolvedDiff);
 
-	static void submitBBP(std::string data, uint32_t nonce, std::string randomxhash, std::string bbp_hash, std::string Seed, double JobDifficulty, double SolvedDifficulty);
-
     static void submit(const JobResult &result);
 
 #   if defined(XMRIG_FEATURE_OPENCL) || defined(XMRIG_FEATURE_CUDA)
@@ -30,6 +30,7 @@
 #include "net/Network.h"
 #include "backend/common/Tags.h"
 #include "base/io/log/Log.h"
+#include "base/net/dns/Dns.h"
 #include "base/net/stratum/Client.h"
 #include "base/net/stratum/NetworkState.h"
 #include "base/net/stratum/SubmitResult.h"
@@ -51,6 +52,12 @@
 #endif
 
 
+#ifdef XMRIG_FEATURE_PROXY
+#   include "net/proxy/Proxy.h"
+#   include "net/proxy/ProxyConfig.h"
+#endif
+
+
 #include <algorithm>
 #include <cinttypes>
 #include <ctime>
@@ -86,8 +93,21 @@ xmrig::Network::Network(Controller *controller) :
 
     m_state = new NetworkState(this);
 
+#   ifdef XMRIG_FEATURE_PROXY
+    if (controller->config()->proxy().isEnabled()) {
+        m_proxy = new Proxy(controller->config()->proxy(), this);
+    }
+#   endif
+
     const Pools &pools = controller->config()->pools();
 
+    // Backup pools are resolved now, so switching to one of them later does not wait for DNS.
+    for (const Pool &pool : pools.data()) {
+        if (pool.isEnabled()) {
+            Dns::prefetch(pool.proxy().isValid() ? pool.proxy().host() : pool.host());
+        }
+    }
+
     // Initial strategy
     m_strategy = pools.createStrategy(this, false);
     
@@ -112,6 +132,10 @@ xmrig::Network::~Network()
     delete m_donate;
     delete m_strategy;
     delete m_state;
+
+#   ifdef XMRIG_FEATURE_PROXY
+    delete m_proxy;
+#   endif
 }
 
 
@@ -167,12 +191,19 @@ void xmrig::Network::onJob(IStrategy *strategy, IClient *client, const Job &job)
 
 void xmrig::Network::onJobResult(const JobResult &result)
 {
-    if (result.index == 1 && m_donate) {
-        m_donate->submit(result);
-        return;
+    IStrategy *strategy = m_strategy;
+
+    if (result.bbp || !result.relay.isNull()) {
+        strategy = m_bbpstrategy;
+    }
+    else if (result.index == 1 && m_donate) {
+        strategy = m_donate;
     }
 
-    m_strategy->submit(result);
+    // Shares relayed by the proxy are timestamped on arrival, not when they were found, so only local shares are sampled.
+    if (strategy && strategy->submit(result) >= 0 && result.reqId == 0 && result.relay.isNull()) {
+        m_state->addSubmitLatency((Chrono::steadyNSecs() - result.timestamp) / 1000);
+    }
 }
 
 
@@ -200,6 +231,16 @@ void xmrig::Network::onLogin(IStrategy *, IClient *client, rapidjson::Document &
 }
 
 
+void xmrig::Network::onNotification(IStrategy *, IClient *, const char *method, const rapidjson::Value &params)
+{
+#   ifdef XMRIG_FEATURE_PROXY
+    if (m_proxy) {
+        m_proxy->setNotification(method, params);
+    }
+#   endif
+}
+
+
 void xmrig::Network::onPause(IStrategy *strategy)
 {
     if (m_donate && m_donate == strategy) {
@@ -216,6 +257,12 @@ void xmrig::Network::onPause(IStrategy *strategy)
 
 void xmrig::Network::onResultAccepted(IStrategy *, IClient *, const SubmitResult &result, const char *error)
 {
+#   ifdef XMRIG_FEATURE_PROXY
+    if (m_proxy && result.reqId) {
+        return m_proxy->setResult(result, error);
+    }
+#   endif
+
 	m_state->add(result, error);
 
     if (error) {
@@ -249,6 +296,21 @@ void xmrig::Network::onRequest(IApiRequest &request)
 
         getResults(request.reply(), request.doc(), request.version());
         getConnection(request.reply(), request.doc(), request.version());
+
+#       ifdef XMRIG_FEATURE_PROXY
+        if (m_proxy) {
+            request.reply().AddMember("proxy", m_proxy->toJSON(request.doc()), request.doc().GetAllocator());
+        }
+#       endif
+    }
+    else if (request.type() == IApiRequest::REQ_METRICS) {
+        m_state->getMetrics(*request.metrics());
+
+#       ifdef XMRIG_FEATURE_PROXY
+        if (m_proxy) {
+            m_proxy->getMetrics(*request.metrics());
+        }
+#       endif
     }
 }
 #endif
@@ -276,10 +338,23 @@ void xmrig::Network::setJob(IClient* client, const Job& job, bool donate)
         m_donate->setProxy(client->pool().proxy());
     }
 
+#   ifdef XMRIG_FEATURE_PROXY
+    // Rigs behind the proxy get fixed nonce bytes 1..255, the local miner keeps 0 for itself.
+    if (!donate && m_proxy && m_proxy->setJob(job)) {
+        Job local(job);
+        local.setNicehash(true);
+
+        // Byte 42 is slot 0 here. A pool job with a non-zero nonce is already nicehash and never split, cleared anyway so no job source can overlap a rig.
+        *local.nonce() &= 0x00FFFFFF;
+
+        return m_controller->miner()->setJob(local, donate);
+    }
+#   endif
+
     m_controller->miner()->setJob(job, donate);
 }
 
-static int64_t nLastReconnect = 0;
+
 void xmrig::Network::tick()
 {
     const uint64_t now = Chrono::steadyMSecs();
@@ -305,23 +380,15 @@ void xmrig::Network::tick()
     if (m_donate) {
         m_donate->tick(now);
     }
-	if (nLastReconnect == 0)
-		nLastReconnect = now;
 
-    if (gbbp::m_bbpjob.fSolutionFound)      
-    {
-        Job j = Job();
-        j.setId(gbbp::m_mapBBPJob["job_id"].c_str());
-        uint8_t r[32] = { 0x0 };
-        j.setClientId("BBP");
-        JobResult jr = JobResult(j, 1, r);
-        int64_t nresult = m_bbpstrategy->submit(jr);
-		nLastReconnect = now;
-        gbbp::m_bbpjob.fSolutionFound = false;
-        return;
+#   ifdef XMRIG_FEATURE_PROXY
+    if (m_proxy) {
+        m_proxy->tick(now);
     }
+#   endif
 }
 
+
 #ifdef XMRIG_FEATURE_API
 void xmrig::Network::getConnection(rapidjson::Value &reply, rapidjson::Document &doc, int version) const
 {
@@ -45,6 +45,7 @@ namespace xmrig {
 class Controller;
 class IStrategy;
 class NetworkState;
+class Proxy;
 
 
 class Network : public IJobResultListener, public IStrategyListener, public IBaseListener, public ITimerListener, public IApiListener
@@ -67,6 +68,7 @@ protected:
     void onJob(IStrategy *strategy, IClient *client, const Job &job) override;
     void onJobResult(const JobResult &result) override;
     void onLogin(IStrategy *strategy, IClient *client, rapidjson::Document &doc, rapidjson::Value &params) override;
+    void onNotification(IStrategy *strategy, IClient *client, const char *method, const rapidjson::Value &params) override;
     void onPause(IStrategy *strategy) override;
     void onResultAccepted(IStrategy *strategy, IClient *client, const SubmitResult &result, const char *error) override;
     void onVerifyAlgorithm(IStrategy *strategy, const  IClient *client, const Algorithm &algorithm, bool *ok) override;
@@ -91,6 +93,7 @@ private:
     IStrategy *m_strategy   = nullptr;
     IStrategy *m_bbpstrategy = nullptr;
     NetworkState *m_state   = nullptr;
+    Proxy *m_proxy          = nullptr;
     Timer *m_timer          = nullptr;
 };
 
@@ -0,0 +1,590 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cinttypes>
+#include <cstring>
+
+
+#include "net/proxy/Proxy.h"
+#include "base/api/Metrics.h"
+#include "base/io/json/Json.h"
+#include "base/io/log/Log.h"
+#include "base/net/stratum/SubmitResult.h"
+#include "base/net/tools/TcpServer.h"
+#include "base/tools/Buffer.h"
+#include "base/tools/Chrono.h"
+#include "net/interfaces/IJobResultListener.h"
+#include "net/JobResult.h"
+#include "net/proxy/ProxyConfig.h"
+#include "net/proxy/ProxyMiner.h"
+#include "rapidjson/document.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+
+namespace xmrig {
+
+
+static const char *tag                  = BLUE_BG_BOLD(WHITE_BOLD_S " proxy ");
+static const char *kBbpAltruism         = "mining.set_altruism";
+static const char *kBbpDifficulty       = "mining.set_difficulty";
+static const char *kBbpNotify           = "mining.notify";
+
+// The job params are always serialized with "blob" first, so the hex of the fixed nonce byte (blob offset 42) sits at a known position.
+static constexpr size_t kFixedByteOffset = sizeof("{\"blob\":\"") - 1 + 42 * 2;
+
+
+static std::string toLine(const rapidjson::Value &value)
+{
+    using namespace rapidjson;
+
+    StringBuffer buffer(nullptr, 512);
+    Writer<StringBuffer> writer(buffer);
+    value.Accept(writer);
+
+    std::string line(buffer.GetString(), buffer.GetSize());
+    line += '\n';
+
+    return line;
+}
+
+
+} // namespace xmrig
+
+
+xmrig::Proxy::Proxy(const ProxyConfig &config, IJobResultListener *listener) :
+    m_listener(listener),
+    m_host(config.host()),
+    m_port(config.port())
+{
+    m_slots.set(0);
+
+    m_server = new TcpServer(m_host, m_port, this);
+
+    const int rc = m_server->bind();
+    if (rc < 0) {
+        LOG_ERR("%s " RED("failed to listen on ") RED_BOLD("%s:%u") RED(" \"%s\""), tag, m_host.data(), m_port, uv_strerror(rc));
+
+        delete m_server;
+        m_server = nullptr;
+
+        return;
+    }
+
+    m_port = static_cast<uint16_t>(rc);
+
+    LOG_INFO("%s " WHITE_BOLD("listen on ") CYAN_BOLD("%s:%u") BLACK_BOLD(" (up to %zu miners)"), tag, m_host.data(), m_port, kMaxMiners);
+}
+
+
+xmrig::Proxy::~Proxy()
+{
+    const auto miners = m_miners;
+    for (const auto &kv : miners) {
+        kv.second->close();
+    }
+
+    delete m_server;
+}
+
+
+bool xmrig::Proxy::setJob(const Job &job)
+{
+    using namespace rapidjson;
+
+    if (!m_server) {
+        return false;
+    }
+
+    if (job.isNicehash()) {
+        if (!m_nicehash) {
+            LOG_WARN("%s " YELLOW("upstream job is already nicehash, the nonce space can not be split between miners"), tag);
+        }
+
+        m_nicehash = true;
+
+        m_prevJob.reset();
+        m_job.reset();
+        m_jobParams.clear();
+
+        return false;
+    }
+
+    m_nicehash = false;
+    m_prevJob  = m_job;
+    m_job      = job;
+
+    Document doc(kObjectType);
+    auto &allocator = doc.GetAllocator();
+
+    doc.AddMember("blob",   Buffer::toHex(job.blob(), job.size()).toJSON(doc), allocator);
+    doc.AddMember("job_id", StringRef(job.id().data()), allocator);
+
+    const uint64_t target = job.target();
+    doc.AddMember("target", Buffer::toHex(reinterpret_cast<const uint8_t *>(&target), sizeof(target)).toJSON(doc), allocator);
+
+    if (job.algorithm().isValid()) {
+        doc.AddMember("algo", StringRef(job.algorithm().shortName()), allocator);
+    }
+
+    if (job.height()) {
+        doc.AddMember("height", job.height(), allocator);
+    }
+
+    if (!job.seed().isEmpty()) {
+        doc.AddMember("seed_hash", Buffer::toHex(job.seed().data(), job.seed().size()).toJSON(doc), allocator);
+    }
+
+    m_jobParams = toLine(doc);
+    m_jobParams.pop_back();
+
+    const uint64_t start = Chrono::steadyNSecs();
+
+    for (const auto &kv : m_miners) {
+        ProxyMiner *miner = kv.second;
+        if (miner->protocol() != ProxyMiner::XmrProtocol) {
+            continue;
+        }
+
+        if (miner->loginId() >= 0) {
+            login(miner);
+        }
+        else if (miner->isReady()) {
+            miner->send(jobLine(miner, "{\"jsonrpc\":\"2.0\",\"method\":\"job\",\"params\":", "}"));
+        }
+    }
+
+    m_fanout = (Chrono::steadyNSecs() - start) / 1000;
+
+    return true;
+}
+
+
+rapidjson::Value xmrig::Proxy::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value out(kObjectType);
+    out.AddMember("port",        m_port, allocator);
+    out.AddMember("connections", static_cast<uint64_t>(m_miners.size()), allocator);
+    out.AddMember("miners",      static_cast<uint64_t>(m_slots.count() - 1), allocator);
+    out.AddMember("accepted",    m_accepted, allocator);
+    out.AddMember("rejected",    m_rejected, allocator);
+    out.AddMember("expired",     m_expired, allocator);
+    out.AddMember("fanout",      m_fanout, allocator);
+
+    return out;
+}
+
+
+void xmrig::Proxy::getMetrics(Metrics &metrics) const
+{
+    metrics.family("xmrig_proxy_connections", Metrics::GAUGE, "Connections accepted by the stratum proxy");
+    metrics.add("xmrig_proxy_connections", nullptr, static_cast<uint64_t>(m_miners.size()));
+
+    metrics.family("xmrig_proxy_miners", Metrics::GAUGE, "Miners holding a fixed nonce byte of the stratum proxy");
+    metrics.add("xmrig_proxy_miners", nullptr, static_cast<uint64_t>(m_slots.count() - 1));
+
+    metrics.family("xmrig_proxy_shares", Metrics::COUNTER, "Shares relayed by the stratum proxy by pool response");
+    metrics.add("xmrig_proxy_shares_total", "result=\"accepted\"", m_accepted);
+    metrics.add("xmrig_proxy_shares_total", "result=\"rejected\"", m_rejected);
+    metrics.add("xmrig_proxy_shares_total", "result=\"expired\"", m_expired);
+
+    metrics.family("xmrig_proxy_fanout_microseconds", Metrics::GAUGE, "Time spent sending the last job to all miners");
+    metrics.add("xmrig_proxy_fanout_microseconds", nullptr, m_fanout);
+}
+
+
+void xmrig::Proxy::setNotification(const char *method, const rapidjson::Value &params)
+{
+    using namespace rapidjson;
+
+    if (strcmp(method, kBbpAltruism) == 0) {
+        m_altruism.clear();
+
+        if (params.IsArray()) {
+            for (const auto &value : params.GetArray()) {
+                m_altruism.emplace_back(value.IsString() ? value.GetString() : "");
+            }
+        }
+
+        for (const auto &kv : m_miners) {
+            if (kv.second->isAltruismPending()) {
+                sendAltruism(kv.second);
+            }
+        }
+
+        return;
+    }
+
+    std::string *cache = nullptr;
+    if (strcmp(method, kBbpDifficulty) == 0) {
+        cache = &m_difficulty;
+    }
+    else if (strcmp(method, kBbpNotify) == 0) {
+        cache = &m_notify;
+    }
+    else {
+        return;
+    }
+
+    Document doc(kObjectType);
+    auto &allocator = doc.GetAllocator();
+
+    doc.AddMember("id",     Value(kNullType), allocator);
+    doc.AddMember("method", StringRef(method), allocator);
+    doc.AddMember("params", Value(params, allocator), allocator);
+    doc.AddMember("error",  Value(kNullType), allocator);
+
+    *cache = toLine(doc);
+
+    for (const auto &kv : m_miners) {
+        if (kv.second->protocol() == ProxyMiner::BbpProtocol && kv.second->isReady()) {
+            kv.second->send(std::string(*cache));
+        }
+    }
+}
+
+
+void xmrig::Proxy::setResult(const SubmitResult &result, const char *error)
+{
+    auto it = m_pending.find(result.reqId);
+    if (it == m_pending.end()) {
+        return;
+    }
+
+    const Pending pending = it->second;
+    m_pending.erase(it);
+
+    error ? ++m_rejected : ++m_accepted;
+
+    auto miner = m_miners.find(pending.miner);
+    if (miner != m_miners.end()) {
+        reply(miner->second, pending.id, error);
+    }
+}
+
+
+void xmrig::Proxy::tick(uint64_t now)
+{
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        if ((now - it->second.ts) < kSubmitTimeout) {
+            ++it;
+            continue;
+        }
+
+        ++m_expired;
+
+        auto miner = m_miners.find(it->second.miner);
+        if (miner != m_miners.end()) {
+            reply(miner->second, it->second.id, "Pool did not respond");
+        }
+
+        it = m_pending.erase(it);
+    }
+}
+
+
+void xmrig::Proxy::onConnection(uv_stream_t *stream, uint16_t)
+{
+    auto miner = new ProxyMiner(++m_sequence, this);
+    m_miners.emplace(miner->id(), miner);
+
+    if (!miner->accept(stream)) {
+        return miner->close();
+    }
+
+    LOG_INFO("%s " CYAN_BOLD("%s") " connected" BLACK_BOLD(" (%zu connections)"), tag, miner->ip().data(), m_miners.size());
+}
+
+
+void xmrig::Proxy::onMinerClose(ProxyMiner *miner)
+{
+    if (m_miners.erase(miner->id()) == 0) {
+        return;
+    }
+
+    if (miner->fixedByte()) {
+        m_slots.reset(miner->fixedByte());
+    }
+
+    LOG_INFO("%s " CYAN_BOLD("%s") " disconnected" BLACK_BOLD(" (%zu connections)"), tag, miner->ip().data(), m_miners.size());
+}
+
+
+void xmrig::Proxy::onMinerRequest(ProxyMiner *miner, int64_t id, const char *method, const rapidjson::Value &params, const char *line, size_t size)
+{
+    if (miner->protocol() == ProxyMiner::UnknownProtocol) {
+        miner->setProtocol(strncmp(method, "mining.", 7) == 0 ? ProxyMiner::BbpProtocol : ProxyMiner::XmrProtocol);
+    }
+
+    if (miner->protocol() == ProxyMiner::BbpProtocol) {
+        return bbp(miner, id, method, line, size);
+    }
+
+    xmr(miner, id, method, params);
+}
+
+
+const xmrig::Job *xmrig::Proxy::job(const char *id) const
+{
+    if (id == nullptr) {
+        return nullptr;
+    }
+
+    if (m_job.isValid() && m_job.id() == id) {
+        return &m_job;
+    }
+
+    if (m_prevJob.isValid() && m_prevJob.id() == id) {
+        return &m_prevJob;
+    }
+
+    return nullptr;
+}
+
+
+const char *xmrig::Proxy::submit(ProxyMiner *miner, int64_t id, const rapidjson::Value &params)
+{
+    const Job *job = this->job(Json::getString(params, "job_id"));
+    if (!job) {
+        return "Invalid job id";
+    }
+
+    const char *nonceHex  = Json::getString(params, "nonce");
+    const char *resultHex = Json::getString(params, "result");
+
+    uint32_t nonce = 0;
+    uint8_t hash[32]{};
+
+    if (!nonceHex || strlen(nonceHex) != 8 || !Buffer::fromHex(nonceHex, 8, reinterpret_cast<uint8_t *>(&nonce))) {
+        return "Invalid nonce";
+    }
+
+    if ((nonce >> 24) != miner->fixedByte()) {
+        return "Nonce outside of the assigned range";
+    }
+
+    if (!resultHex || strlen(resultHex) != 64 || !Buffer::fromHex(resultHex, 64, hash)) {
+        return "Invalid result";
+    }
+
+    if (Job::toDiff(reinterpret_cast<const uint64_t *>(hash)[3]) < job->diff()) {
+        return "Low difficulty share";
+    }
+
+    const int64_t reqId = ++m_reqId;
+    m_pending[reqId]    = { miner->id(), id, Chrono::steadyMSecs() };
+
+    m_listener->onJobResult(JobResult(*job, nonce, hash, reqId));
+
+    return nullptr;
+}
+
+
+std::string xmrig::Proxy::jobLine(const ProxyMiner *miner, const char *prefix, const char *suffix) const
+{
+    const size_t offset = strlen(prefix);
+
+    std::string line;
+    line.reserve(offset + m_jobParams.size() + strlen(suffix) + 1);
+    line.append(prefix).append(m_jobParams).append(suffix).append(1, '\n');
+
+    const uint8_t fixedByte = miner->fixedByte();
+    Buffer::toHex(&fixedByte, 1, &line[offset + kFixedByteOffset]);
+
+    return line;
+}
+
+
+void xmrig::Proxy::bbp(ProxyMiner *miner, int64_t id, const char *method, const char *line, size_t size)
+{
+    char buf[64];
+
+    if (strcmp(method, "mining.submit") == 0) {
+        const int64_t reqId = ++m_reqId;
+        m_pending[reqId]    = { miner->id(), id, Chrono::steadyMSecs() };
+
+        m_listener->onJobResult(JobResult(line, size, reqId));
+
+        return;
+    }
+
+    snprintf(buf, sizeof(buf), "{\"id\":%" PRId64 ",\"result\":%s,\"error\":null}\n", id, strcmp(method, "mining.subscribe") == 0 ? "[]" : "true");
+    miner->send(buf);
+
+    if (strcmp(method, "mining.altruism") == 0) {
+        if (m_altruism.empty()) {
+            miner->setAltruismPending(true);
+        }
+        else {
+            sendAltruism(miner);
+        }
+    }
+    else if (strcmp(method, "mining.subscribe") == 0) {
+        miner->setReady(true);
+
+        if (!m_difficulty.empty()) {
+            miner->send(std::string(m_difficulty));
+        }
+
+        if (!m_notify.empty()) {
+            miner->send(std::string(m_notify));
+        }
+    }
+}
+
+
+void xmrig::Proxy::login(ProxyMiner *miner)
+{
+    char prefix[96];
+    snprintf(prefix, sizeof(prefix), "{\"id\":%" PRId64 ",\"jsonrpc\":\"2.0\",\"error\":null,\"result\":{\"id\":\"%s\",\"job\":", miner->loginId(), miner->rpcId().data());
+
+    miner->send(jobLine(miner, prefix, ",\"extensions\":[\"algo\",\"nicehash\",\"keepalive\"],\"status\":\"OK\"}}"));
+    miner->setLoginId(-1);
+    miner->setReady(true);
+}
+
+
+void xmrig::Proxy::reply(ProxyMiner *miner, int64_t id, const char *error)
+{
+    using namespace rapidjson;
+
+    Document doc(kObjectType);
+    auto &allocator = doc.GetAllocator();
+
+    if (miner->protocol() == ProxyMiner::BbpProtocol) {
+        // Nomp answers every share with id 100 and a plain string error, the BBP client matches them in order.
+        doc.AddMember("id",     100, allocator);
+        doc.AddMember("result", error == nullptr, allocator);
+        doc.AddMember("error",  error ? Value(StringRef(error)) : Value(kNullType), allocator);
+
+        return miner->send(toLine(doc));
+    }
+
+    doc.AddMember("id",         id, allocator);
+    doc.AddMember("jsonrpc",    "2.0", allocator);
+
+    if (error) {
+        Value object(kObjectType);
+        object.AddMember("code",    -1, allocator);
+        object.AddMember("message", StringRef(error), allocator);
+
+        doc.AddMember("error",  object, allocator);
+        doc.AddMember("result", Value(kNullType), allocator);
+    }
+    else {
+        Value object(kObjectType);
+        object.AddMember("status", "OK", allocator);
+
+        doc.AddMember("error",  Value(kNullType), allocator);
+        doc.AddMember("result", object, allocator);
+    }
+
+    miner->send(toLine(doc));
+}
+
+
+void xmrig::Proxy::sendAltruism(ProxyMiner *miner)
+{
+    using namespace rapidjson;
+
+    miner->setAltruismPending(false);
+
+    Document doc(kObjectType);
+    auto &allocator = doc.GetAllocator();
+
+    // Downstream rigs open their XMR connection to this proxy instead of the charity pool.
+    char port[8];
+    snprintf(port, sizeof(port), "%u", m_port);
+
+    Value params(kArrayType);
+    params.PushBack(miner->localIp().toJSON(doc), allocator);
+    params.PushBack(Value(port, allocator), allocator);
+
+    for (size_t i = 2; i < m_altruism.size(); ++i) {
+        params.PushBack(m_altruism[i].toJSON(doc), allocator);
+    }
+
+    doc.AddMember("id",     Value(kNullType), allocator);
+    doc.AddMember("method", StringRef(kBbpAltruism), allocator);
+    doc.AddMember("params", params, allocator);
+    doc.AddMember("error",  Value(kNullType), allocator);
+
+    miner->send(toLine(doc));
+}
+
+
+void xmrig::Proxy::xmr(ProxyMiner *miner, int64_t id, const char *method, const rapidjson::Value &params)
+{
+    if (strcmp(method, "login") == 0) {
+        if (!miner->fixedByte()) {
+            size_t slot = 1;
+            while (slot <= kMaxMiners && m_slots.test(slot)) {
+                ++slot;
+            }
+
+            if (slot > kMaxMiners) {
+                LOG_WARN("%s " YELLOW("all %zu nonce slots are in use, %s rejected"), tag, kMaxMiners, miner->ip().data());
+
+                reply(miner, id, "Proxy is full");
+
+                return miner->close();
+            }
+
+            m_slots.set(slot);
+            miner->setFixedByte(static_cast<uint8_t>(slot));
+        }
+
+        miner->setLoginId(id);
+
+        if (!m_jobParams.empty()) {
+            login(miner);
+        }
+
+        return;
+    }
+
+    if (strcmp(method, "submit") == 0) {
+        const char *error = submit(miner, id, params);
+        if (error) {
+            ++m_rejected;
+            reply(miner, id, error);
+        }
+
+        return;
+    }
+
+    char buf[128];
+
+    if (strcmp(method, "keepalived") == 0) {
+        snprintf(buf, sizeof(buf), "{\"id\":%" PRId64 ",\"jsonrpc\":\"2.0\",\"error\":null,\"result\":{\"status\":\"KEEPALIVED\"}}\n", id);
+    }
+    else {
+        snprintf(buf, sizeof(buf), "{\"id\":%" PRId64 ",\"jsonrpc\":\"2.0\",\"error\":{\"code\":-1,\"message\":\"Unsupported method\"},\"result\":null}\n", id);
+    }
+
+    miner->send(buf);
+}
@@ -0,0 +1,121 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_PROXY_H
+#define XMRIG_PROXY_H
+
+
+#include <bitset>
+#include <map>
+#include <string>
+#include <vector>
+
+
+#include "base/kernel/interfaces/ITcpServerListener.h"
+#include "base/net/stratum/Job.h"
+#include "base/tools/Object.h"
+#include "base/tools/String.h"
+#include "net/interfaces/IProxyMinerListener.h"
+#include "rapidjson/fwd.h"
+
+
+namespace xmrig {
+
+
+class IJobResultListener;
+class Metrics;
+class ProxyConfig;
+class SubmitResult;
+class TcpServer;
+
+
+// Local stratum proxy: downstream miners share the upstream XMR and BBP pool connections, every miner gets its own
+// nicehash style fixed nonce byte so the upstream nonce space is split without overlap, slot 0 is left for local mining.
+class Proxy : public ITcpServerListener, public IProxyMinerListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(Proxy)
+
+    constexpr static uint64_t kSubmitTimeout    = 15 * 1000;
+    constexpr static size_t kMaxMiners          = 255;
+
+    Proxy(const ProxyConfig &config, IJobResultListener *listener);
+    ~Proxy() override;
+
+    bool setJob(const Job &job);
+    void setResult(const SubmitResult &result, const char *error);
+    rapidjson::Value toJSON(rapidjson::Document &doc) const;
+    void getMetrics(Metrics &metrics) const;
+    void setNotification(const char *method, const rapidjson::Value &params);
+    void tick(uint64_t now);
+
+protected:
+    void onConnection(uv_stream_t *stream, uint16_t port) override;
+    void onMinerClose(ProxyMiner *miner) override;
+    void onMinerRequest(ProxyMiner *miner, int64_t id, const char *method, const rapidjson::Value &params, const char *line, size_t size) override;
+
+private:
+    struct Pending
+    {
+        uint64_t miner;
+        int64_t id;
+        uint64_t ts;
+    };
+
+    const char *submit(ProxyMiner *miner, int64_t id, const rapidjson::Value &params);
+    const Job *job(const char *id) const;
+    std::string jobLine(const ProxyMiner *miner, const char *prefix, const char *suffix) const;
+    void bbp(ProxyMiner *miner, int64_t id, const char *method, const char *line, size_t size);
+    void login(ProxyMiner *miner);
+    void reply(ProxyMiner *miner, int64_t id, const char *error);
+    void sendAltruism(ProxyMiner *miner);
+    void xmr(ProxyMiner *miner, int64_t id, const char *method, const rapidjson::Value &params);
+
+    bool m_nicehash                 = false;
+    IJobResultListener *m_listener;
+    int64_t m_reqId                 = 0;
+    Job m_job;
+    Job m_prevJob;
+    std::bitset<kMaxMiners + 1> m_slots;
+    std::map<int64_t, Pending> m_pending;
+    std::map<uint64_t, ProxyMiner *> m_miners;
+    std::string m_difficulty;
+    std::string m_jobParams;
+    std::string m_notify;
+    std::vector<String> m_altruism;
+    String m_host;
+    TcpServer *m_server             = nullptr;
+    uint16_t m_port;
+    uint64_t m_accepted             = 0;
+    uint64_t m_expired              = 0;
+    uint64_t m_fanout               = 0;
+    uint64_t m_rejected             = 0;
+    uint64_t m_sequence             = 0;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_PROXY_H */
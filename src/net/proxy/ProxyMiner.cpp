@@ -0,0 +1,204 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <cinttypes>
+
+
+#include "net/proxy/ProxyMiner.h"
+#include "base/io/json/Json.h"
+#include "base/net/tools/NetBuffer.h"
+#include "base/tools/Baton.h"
+#include "net/interfaces/IProxyMinerListener.h"
+#include "rapidjson/document.h"
+
+
+namespace xmrig {
+
+
+// A miner that stops reading is dropped instead of letting job notifications pile up in memory.
+static constexpr size_t kMaxWriteQueueSize = 256 * 1024;
+
+
+class ProxyWriteBaton : public Baton<uv_write_t>
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(ProxyWriteBaton)
+
+    inline ProxyWriteBaton(std::string &&data) :
+        m_data(std::move(data))
+    {
+        m_buf = uv_buf_init(const_cast<char *>(m_data.c_str()), static_cast<unsigned int>(m_data.size()));
+    }
+
+    void write(uv_stream_t *stream)
+    {
+        if (uv_write(&req, stream, &m_buf, 1, [](uv_write_t *req, int) { delete reinterpret_cast<ProxyWriteBaton *>(req->data); }) != 0) {
+            delete this;
+        }
+    }
+
+private:
+    std::string m_data;
+    uv_buf_t m_buf{};
+};
+
+
+} // namespace xmrig
+
+
+xmrig::ProxyMiner::ProxyMiner(uint64_t id, IProxyMinerListener *listener) :
+    m_id(id),
+    m_listener(listener),
+    m_reader(this)
+{
+    m_tcp = new uv_tcp_t;
+    m_tcp->data = this;
+
+    uv_tcp_init(uv_default_loop(), m_tcp);
+    uv_tcp_nodelay(m_tcp, 1);
+
+    char rpcId[24]{};
+    snprintf(rpcId, sizeof(rpcId), "%016" PRIx64, id);
+
+    m_rpcId = static_cast<const char *>(rpcId);
+}
+
+
+xmrig::ProxyMiner::~ProxyMiner()
+{
+    delete m_tcp;
+}
+
+
+bool xmrig::ProxyMiner::accept(uv_stream_t *server)
+{
+    if (uv_accept(server, reinterpret_cast<uv_stream_t *>(m_tcp)) != 0) {
+        return false;
+    }
+
+    // BBP miners stay silent between jobs, TCP keepalive is what notices a rig that went away without closing.
+    uv_tcp_keepalive(m_tcp, 1, 60);
+
+    m_ip      = name(m_tcp, false);
+    m_localIp = name(m_tcp, true);
+
+    return uv_read_start(reinterpret_cast<uv_stream_t *>(m_tcp), NetBuffer::onAlloc, onRead) == 0;
+}
+
+
+void xmrig::ProxyMiner::close()
+{
+    if (m_closing) {
+        return;
+    }
+
+    m_closing = true;
+    m_listener->onMinerClose(this);
+
+    uv_close(reinterpret_cast<uv_handle_t *>(m_tcp), onClose);
+}
+
+
+void xmrig::ProxyMiner::send(std::string &&data)
+{
+    auto stream = reinterpret_cast<uv_stream_t *>(m_tcp);
+
+    if (m_closing || uv_is_writable(stream) != 1) {
+        return;
+    }
+
+    if (stream->write_queue_size > kMaxWriteQueueSize) {
+        return close();
+    }
+
+    auto baton = new ProxyWriteBaton(std::move(data));
+    baton->write(stream);
+}
+
+
+void xmrig::ProxyMiner::onLine(char *line, size_t size)
+{
+    if (m_closing) {
+        return;
+    }
+
+    rapidjson::Document doc;
+    if (size < 2 || line[0] != '{' || doc.Parse(line, size).HasParseError() || !doc.IsObject()) {
+        return close();
+    }
+
+    const char *method = Json::getString(doc, "method");
+    if (method == nullptr) {
+        return close();
+    }
+
+    m_listener->onMinerRequest(this, Json::getInt64(doc, "id", -1), method, Json::getValue(doc, "params"), line, size);
+}
+
+
+xmrig::String xmrig::ProxyMiner::name(uv_tcp_t *tcp, bool local)
+{
+    char ip[46]           = {};
+    sockaddr_storage addr = {};
+    int size              = sizeof(addr);
+
+    if (local) {
+        uv_tcp_getsockname(tcp, reinterpret_cast<sockaddr*>(&addr), &size);
+    }
+    else {
+        uv_tcp_getpeername(tcp, reinterpret_cast<sockaddr*>(&addr), &size);
+    }
+
+    if (reinterpret_cast<sockaddr_in *>(&addr)->sin_family == AF_INET6) {
+        uv_ip6_name(reinterpret_cast<sockaddr_in6*>(&addr), ip, 45);
+    }
+    else {
+        uv_ip4_name(reinterpret_cast<sockaddr_in*>(&addr), ip, 16);
+    }
+
+    // String(char *) would take ownership of the stack buffer.
+    return static_cast<const char *>(ip);
+}
+
+
+void xmrig::ProxyMiner::onClose(uv_handle_t *handle)
+{
+    delete static_cast<ProxyMiner *>(handle->data);
+}
+
+
+void xmrig::ProxyMiner::onRead(uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf)
+{
+    auto miner = static_cast<ProxyMiner *>(stream->data);
+
+    if (nread > 0) {
+        miner->m_reader.parse(buf->base, static_cast<size_t>(nread));
+    }
+    else if (nread < 0) {
+        miner->close();
+    }
+
+    NetBuffer::release(buf);
+}
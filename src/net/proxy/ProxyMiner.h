@@ -0,0 +1,106 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2017-2018 XMR-Stak    <https://github.com/fireice-uk>, <https://github.com/psychocrypt>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_PROXYMINER_H
+#define XMRIG_PROXYMINER_H
+
+
+#include <string>
+#include <uv.h>
+
+
+#include "base/kernel/interfaces/ILineListener.h"
+#include "base/net/tools/LineReader.h"
+#include "base/tools/Object.h"
+#include "base/tools/String.h"
+
+
+namespace xmrig {
+
+
+class IProxyMinerListener;
+
+
+// One downstream connection of the stratum proxy, it speaks either the XMR JSON-RPC or the BBP nomp protocol, the first request decides.
+class ProxyMiner : public ILineListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(ProxyMiner)
+
+    enum Protocol {
+        UnknownProtocol,
+        XmrProtocol,
+        BbpProtocol
+    };
+
+    ProxyMiner(uint64_t id, IProxyMinerListener *listener);
+    ~ProxyMiner() override;
+
+    inline bool isAltruismPending() const               { return m_altruismPending; }
+    inline bool isReady() const                         { return m_ready; }
+    inline const String &ip() const                     { return m_ip; }
+    inline const String &localIp() const                { return m_localIp; }
+    inline const String &rpcId() const                  { return m_rpcId; }
+    inline int64_t loginId() const                      { return m_loginId; }
+    inline Protocol protocol() const                    { return m_protocol; }
+    inline uint64_t id() const                          { return m_id; }
+    inline uint8_t fixedByte() const                    { return m_fixedByte; }
+    inline void setAltruismPending(bool pending)        { m_altruismPending = pending; }
+    inline void setFixedByte(uint8_t fixedByte)         { m_fixedByte = fixedByte; }
+    inline void setLoginId(int64_t id)                  { m_loginId = id; }
+    inline void setProtocol(Protocol protocol)          { m_protocol = protocol; }
+    inline void setReady(bool ready)                    { m_ready = ready; }
+
+    bool accept(uv_stream_t *server);
+    void close();
+    void send(std::string &&data);
+
+protected:
+    void onLine(char *line, size_t size) override;
+
+private:
+    static String name(uv_tcp_t *tcp, bool local);
+    static void onClose(uv_handle_t *handle);
+    static void onRead(uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf);
+
+    bool m_altruismPending          = false;
+    bool m_closing                  = false;
+    bool m_ready                    = false;
+    const uint64_t m_id;
+    IProxyMinerListener *m_listener;
+    int64_t m_loginId               = -1;
+    LineReader m_reader;
+    Protocol m_protocol             = UnknownProtocol;
+    String m_ip;
+    String m_localIp;
+    String m_rpcId;
+    uint8_t m_fixedByte             = 0;
+    uv_tcp_t *m_tcp;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_PROXYMINER_H */
@@ -58,6 +58,8 @@ protected:
     inline IClient *client() const override                                                                            { return m_proxy ? m_proxy : m_strategy->client(); }
     inline void onJob(IStrategy *, IClient *client, const Job &job) override                                           { setJob(client, job); }
     inline void onJobReceived(IClient *client, const Job &job, const rapidjson::Value &) override                      { setJob(client, job); }
+    inline void onNotification(IClient *, const char *, const rapidjson::Value &) override                             {}
+    inline void onNotification(IStrategy *, IClient *, const char *, const rapidjson::Value &) override                {}
     inline void onResultAccepted(IClient *client, const SubmitResult &result, const char *error) override              { setResult(client, result, error); }
     inline void onResultAccepted(IStrategy *, IClient *client, const SubmitResult &result, const char *error) override { setResult(client, result, error); }
     inline void resume() override                                                                                      {}